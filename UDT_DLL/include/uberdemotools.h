@@ -113,6 +113,7 @@ typedef double f64;
 typedef struct udtParserContext_s udtParserContext;
 typedef struct udtParserContextGroup_s udtParserContextGroup;
 typedef struct udtPatternSearchContext_s udtPatternSearchContext;
+typedef struct udtThreadPool_s udtThreadPool;
 
 #if defined(__cplusplus)
 
@@ -122,7 +123,8 @@ typedef struct udtPatternSearchContext_s udtPatternSearchContext;
 	N(OperationFailed, "operation failed") \
 	N(OperationCanceled, "operation canceled") \
 	N(Unprocessed, "unprocessed job") \
-	N(InsufficientBufferSize, "insufficient buffer size")
+	N(InsufficientBufferSize, "insufficient buffer size") \
+	N(UnsupportedProtocol, "operation not supported for this protocol")
 
 #define UDT_ERROR_ITEM(Enum, Desc) Enum,
 struct udtErrorCode
@@ -1081,7 +1083,9 @@ struct udtPerfStatsDataType
 	N(MemoryCommitted, "memory committed", Bytes) \
 	N(MemoryUsed, "memory used", Bytes) \
 	N(MemoryEfficiency, "memory usage efficiency", Percentage) \
-	N(ResizeCount, "buffer relocation count", Generic)
+	N(ResizeCount, "buffer relocation count", Generic) \
+	N(ThreadUtilization, "average thread utilization", Percentage) \
+	N(MinThreadUtilization, "lowest thread utilization", Percentage)
 
 #define UDT_PERF_STATS_ITEM(Enum, Desc, Type) Enum,
 struct udtPerfStatsField
@@ -1097,9 +1101,10 @@ struct udtPerfStatsField
 #endif
 
 
-#define    UDT_MAX_MERGE_DEMO_COUNT             8
-#define    UDT_TEAM_STATS_MASK_BYTE_COUNT       8
-#define    UDT_PLAYER_STATS_MASK_BYTE_COUNT    40
+#define    UDT_MAX_MERGE_DEMO_COUNT                    8
+#define    UDT_TEAM_STATS_MASK_BYTE_COUNT              8
+#define    UDT_PLAYER_STATS_MASK_BYTE_COUNT           40
+#define    UDT_DEFAULT_MIN_BYTE_COUNT_PER_THREAD      (6 * (1 << 20))
 
 
 #if defined(__cplusplus)
@@ -1132,6 +1137,24 @@ extern "C"
 	{
 		enum Id
 		{
+			/* Demos parsed from the start get a seek index file written next to them ("<demo>.udtidx"). */
+			/* udtCutDemoFileByTime uses it, when valid, to start decoding close to the first cut. */
+			/* Ignored for read-only protocols. */
+			WriteSeekIndex = UDT_BIT(0),
+			/* Parsing stops right after the first gamestate message: no snapshot gets decoded. */
+			/* Only the demo's header data is read (map, mod, game type, protocol, players, server info...). */
+			/* Meant for the GameState plug-in when indexing large demo libraries. */
+			/* Also disables WriteSeekIndex. */
+			FirstGameStateOnly = UDT_BIT(1),
+			/* The GameState and Stats plug-ins stop analyzing a demo after its first match. */
+			/* Parsing stops early once all plug-ins are done with the demo. */
+			/* Plug-ins that don't track matches are never done and require the whole demo to be read. */
+			FirstMatchOnly = UDT_BIT(2),
+			/* Only the game state at index udtParseArg::GameStateIndex is analyzed, including in batch operations. */
+			/* The plug-ins get no snapshot and command callbacks outside of [StartTimeMs;EndTimeMs] */
+			/* and parsing stops when the server time goes past EndTimeMs. */
+			/* Disables WriteSeekIndex. */
+			TimeWindow = UDT_BIT(3)
 		};
 	};
 #endif
@@ -1177,11 +1200,12 @@ extern "C"
 		u32 PlugInCount;
 
 		/* The index of the game state that will be read when starting at offset FileOffset. */
-		/* Unused in batch operations. */
+		/* Unused in batch operations, unless the udtParseArgFlag::TimeWindow flag is set. */
 		s32 GameStateIndex;
 
 		/* The offset, in bytes, at which to start reading from the file. */
 		/* Unused in batch operations. */
+		/* udtCutDemoFileByTime finds it with a quick scan of the file when it's 0 and GameStateIndex is greater than 0. */
 		u32 FileOffset;
 
 		/* See udtParseArgFlag::Id. */
@@ -1190,12 +1214,33 @@ extern "C"
 		/* Minimum duration, in milli-seconds, between 2 consecutive calls to ProgressCb. */
 		u32 MinProgressTimeMs;
 
+		/* Server time, in milli-seconds, at which plug-in analysis starts. */
+		/* Unused unless the udtParseArgFlag::TimeWindow flag is set. */
+		s32 StartTimeMs;
+
+		/* Server time, in milli-seconds, at which plug-in analysis and parsing stop. */
+		/* Unused unless the udtParseArgFlag::TimeWindow flag is set. */
+		s32 EndTimeMs;
+
 		/* Ignore this. */
 		s32 Reserved2;
 	}
 	udtParseArg;
 	UDT_ENFORCE_API_STRUCT_SIZE(udtParseArg)
 
+#if defined(__cplusplus)
+	struct udtMultiParseArgFlag
+	{
+		enum Id
+		{
+			/* Demos with multiple game states get their game states processed by different threads. */
+			/* Only allowed when finding patterns and cutting by patterns. */
+			/* The other batch processing functions return udtErrorCode::InvalidArgument when it's set. */
+			SplitAtGameStates = UDT_BIT(0)
+		};
+	};
+#endif
+
 	typedef struct udtMultiParseArg_s
 	{
 		/* Pointer to an array of file paths. */
@@ -1204,11 +1249,27 @@ extern "C"
 		/* Pointer to an array of returned error codes. */
 		s32* OutputErrorCodes;
 
+		/* The worker threads to process the demos with. */
+		/* May be NULL, in which case threads are created and destroyed by the call itself. */
+		/* A thread pool can only run one batch job at a time. */
+		udtThreadPool* ThreadPool;
+
+		/* Ignore this. */
+		const void* Reserved1;
+
 		/* Number of elements in the arrays pointed by FilePaths and OutputErrorCodes. */
 		u32 FileCount;
 
 		/* The maximum amount of threads that should be used to process the demos. */
+		/* The thread count is also limited by the number of physical processor cores the process can run on. */
 		u32 MaxThreadCount;
+
+		/* The minimum total demo file size each thread should get, in bytes. */
+		/* Use 0 for the default value: UDT_DEFAULT_MIN_BYTE_COUNT_PER_THREAD. */
+		u32 MinByteCountPerThread;
+
+		/* See udtMultiParseArgFlag::Id. */
+		u32 Flags;
 	}
 	udtMultiParseArg;
 	UDT_ENFORCE_API_STRUCT_SIZE(udtMultiParseArg)
@@ -1270,7 +1331,8 @@ extern "C"
 	{
 		enum Id
 		{
-			MergeCutSections = UDT_BIT(0) /* Enable/disable merging cut sections from different patterns. */
+			MergeCutSections = UDT_BIT(0), /* Enable/disable merging cut sections from different patterns. */
+			SinglePass = UDT_BIT(1) /* Write the cuts while searching for patterns when possible instead of reading the demo files twice. */
 		};
 	};
 
@@ -1805,6 +1867,24 @@ extern "C"
 
 		/* Time of the last snapshot, in milli-seconds. */
 		s32 LastSnapshotTimeMs;
+
+		/* String offset. Name of the map without the path and extension. */
+		u32 MapName;
+
+		/* String length. */
+		u32 MapNameLength;
+
+		/* Of type udtMod::Id. */
+		u32 Mod;
+
+		/* Of type udtGameType::Id. */
+		u32 GameType;
+
+		/* Of type udtProtocol::Id. */
+		u32 Protocol;
+
+		/* Ignore this. */
+		u32 Reserved1;
 	}
 	udtParseDataGameState;
 	UDT_ENFORCE_API_STRUCT_SIZE(udtParseDataGameState)
@@ -2625,6 +2705,14 @@ extern "C"
 	/* Releases all the resources associated to the context group. */
 	UDT_API(s32) udtDestroyContextGroup(udtParserContextGroup* contextGroup);
 
+	/* Creates worker threads that stay alive, along with their parser contexts, until the pool is destroyed. */
+	/* Pass the pool to batch processing functions with udtMultiParseArg::ThreadPool. */
+	UDT_API(udtThreadPool*) udtCreateThreadPool(u32 threadCount);
+
+	/* Stops the worker threads and releases all the resources associated to the thread pool. */
+	/* The pool must not be running a job. */
+	UDT_API(s32) udtDestroyThreadPool(udtThreadPool* threadPool);
+
 	/* Creates, for each demo, sub-demos around every occurrence of a matching pattern. */
 	UDT_API(s32) udtCutDemoFilesByPattern(const udtParseArg* info, const udtMultiParseArg* extraInfo, const udtPatternSearchArg* patternInfo);
 
@@ -3118,6 +3206,7 @@ extern "C"
 		s32 MessageSequence;
 
 		/* The byte size of the buffer pointed to by Buffer. */
+		/* Can't be larger than 16 KB, the maximum message size. */
 		u32 BufferByteCount;
 	}
 	udtCuMessageInput;
@@ -3513,6 +3602,20 @@ extern "C"
 	/* The return value is of type udtErrorCode::Id. */
 	UDT_API(s32) udtCuGetEntityState(udtCuContext* context, idEntityStateBase** entityState, u32 entityIndex);
 
+	/* Serializes the decoding state reached after the last message parsed. */
+	/* The data pointed to by checkpointData stays valid until the next call with the same context. */
+	/* Not available for read-only protocols (see udtIsProtocolWriteSupported): returns udtErrorCode::UnsupportedProtocol. */
+	/* The return value is of type udtErrorCode::Id. */
+	UDT_API(s32) udtCuSaveCheckpoint(udtCuContext* context, const void** checkpointData, u32* checkpointByteCount);
+
+	/* Replaces udtCuStartParsing to resume parsing from the state serialized by udtCuSaveCheckpoint. */
+	/* The next message to parse is the one that followed the checkpoint's last message. */
+	/* No game state message is output for the restored state. */
+	/* The protocol argument is of type udtProtocol::Id and must be the one the checkpoint was saved with. */
+	/* Not available for read-only protocols (see udtIsProtocolWriteSupported): returns udtErrorCode::UnsupportedProtocol. */
+	/* The return value is of type udtErrorCode::Id. */
+	UDT_API(s32) udtCuStartParsingFromCheckpoint(udtCuContext* context, u32 protocol, const void* checkpointData, u32 checkpointByteCount);
+
 	/* Frees all the resources allocated by the custom parsing context. */
 	/* The return value is of type udtErrorCode::Id. */
 	UDT_API(s32) udtCuDestroyContext(udtCuContext* context);
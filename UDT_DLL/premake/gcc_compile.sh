@@ -46,4 +46,5 @@ make UDT_viewer config=$UDT_CONFIG
 make viewer_data_gen config=$UDT_CONFIG
 make tut_players config=$UDT_CONFIG
 make tut_multi_rail config=$UDT_CONFIG
+make UDT_tests config=$UDT_CONFIG
 
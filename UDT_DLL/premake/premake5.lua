@@ -276,6 +276,14 @@ solution "UDT"
 		filter "action:gmake"
 			buildoptions { "-std=c89 -pedantic" } -- -ansi is used to force ISO C90 mode in GCC
 			
+	-- This project exists only to run regression tests on internal code the API doesn't expose.
+	project "UDT_tests"
+	
+		kind "ConsoleApp"
+		defines { "UDT_CREATE_DLL" }
+		files { path_src_apps.."/app_tests.cpp" }
+		ApplyProjectSettings()
+		
 	project "tut_multi_rail"
 	
 		filter { }
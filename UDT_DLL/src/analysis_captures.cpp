@@ -103,7 +103,7 @@ void udtCapturesAnalyzer::FinishDemoAnalysis()
 
 void udtCapturesAnalyzer::ProcessGamestateMessage(const udtGamestateCallbackArg& arg, udtBaseParser& parser)
 {
-	++_gameStateIndex;
+	_gameStateIndex = arg.GameStateIndex;
 	_firstSnapshot = true;
 	_demoTakerIndex = arg.ClientNum;
 
@@ -121,7 +121,7 @@ void udtCapturesAnalyzer::ProcessGamestateMessage(const udtGamestateCallbackArg&
 			protocol != udtProtocol::Dm3)
 	{
 		udtString gameName;
-		if(ParseConfigStringValueString(gameName, *_tempAllocator, "gamename", parser.GetConfigString(CS_SERVERINFO).GetPtr()))
+		if(parser.GetConfigStringValueString(gameName, CS_SERVERINFO, "gamename"))
 		{
 			if(udtString::Equals(gameName, "cpma"))
 			{
@@ -145,7 +145,7 @@ void udtCapturesAnalyzer::ProcessGamestateMessage(const udtGamestateCallbackArg&
 	}
 
 	udtString mapName;
-	if(ParseConfigStringValueString(mapName, *_tempAllocator, "mapname", parser.GetConfigString(CS_SERVERINFO).GetPtr()))
+	if(parser.GetConfigStringValueString(mapName, CS_SERVERINFO, "mapname"))
 	{
 		_mapName = udtString::NewCloneFromRef(StringAllocator, mapName);
 	}
@@ -175,13 +175,11 @@ void udtCapturesAnalyzer::ProcessGamestateMessageQLorOSP(const udtGamestateCallb
 	_lastCaptureQL.Clear();
 	_playerStateQL.Clear();
 
-	const s32 firstPlayerCsIdx = GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::FirstPlayer, parser._inProtocol);
 	for(s32 i = 0; i < 64; ++i)
 	{
-		const udtString cs = parser.GetConfigString(firstPlayerCsIdx + i);
-		if(!udtString::IsNullOrEmpty(cs))
+		if(parser.GetPlayer(i).Present)
 		{
-			ProcessPlayerConfigStringQLorOSP(cs.GetPtr(), parser, i);
+			ProcessPlayerConfigStringQLorOSP(parser, i);
 		}
 	}
 }
@@ -201,16 +199,14 @@ void udtCapturesAnalyzer::ProcessCommandMessageQLorOSP(const udtCommandCallbackA
 		   arg.ConfigStringIndex < firstPlayerCsIdx + 64)
 		{
 			const s32 playerIndex = arg.ConfigStringIndex - firstPlayerCsIdx;
-			ProcessPlayerConfigStringQLorOSP(parser.GetTokenizer().GetArgString(2), parser, playerIndex);
+			ProcessPlayerConfigStringQLorOSP(parser, playerIndex);
 			return;
 		}
 	}
 	else
 	{
-		idTokenizer& tokenizer = parser._context->Tokenizer;
-		tokenizer.Tokenize(arg.String);
-		if(tokenizer.GetArgCount() == 2 &&
-		   udtString::EqualsNoCase(tokenizer.GetArg(0), "print"))
+		if(arg.CommandIdNoCase == udtServerCommand::Print &&
+		   parser.GetTokenizer().GetArgCount() == 2)
 		{
 			ProcessPrintCommandQLorOSP(arg, parser);
 			return;
@@ -631,22 +627,13 @@ void udtCapturesAnalyzer::ProcessGamestateMessageClearStates(const udtGamestateC
 
 udtString udtCapturesAnalyzer::GetPlayerName(s32 playerIndex, udtBaseParser& parser)
 {
-	if(playerIndex < 0 || playerIndex >= 64)
+	const udtPlayerRosterEntry& player = parser.GetPlayer(playerIndex);
+	if(!player.HasName)
 	{
 		return udtString::NewNull();
 	}
 
-	udtVMScopedStackAllocator allocScope(*_tempAllocator);
-
-	const s32 csIndex = GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::FirstPlayer, parser._inProtocol) + playerIndex;
-
-	udtString playerName;
-	if(!ParseConfigStringValueString(playerName, *_tempAllocator, "n", parser.GetConfigString(csIndex).GetPtr()))
-	{
-		return udtString::NewNull();
-	}
-
-	return udtString::NewCleanCloneFromRef(StringAllocator, parser._inProtocol, playerName);
+	return udtString::NewCloneFromRef(StringAllocator, player.CleanNameAndClan);
 }
 
 bool udtCapturesAnalyzer::WasFlagPickedUpInBase(u32 teamIndex)
@@ -665,14 +652,12 @@ bool udtCapturesAnalyzer::WasFlagPickedUpInBase(u32 teamIndex)
 	return inBase;
 }
 
-void udtCapturesAnalyzer::ProcessPlayerConfigStringQLorOSP(const char* configString, udtBaseParser& parser, s32 playerIndex)
+void udtCapturesAnalyzer::ProcessPlayerConfigStringQLorOSP(udtBaseParser& parser, s32 playerIndex)
 {
-	udtVMScopedStackAllocator tempAllocScope(*_tempAllocator);
-
-	udtString name;
-	if(ParseConfigStringValueString(name, *_tempAllocator, "n", configString))
+	const udtPlayerRosterEntry& player = parser.GetPlayer(playerIndex);
+	if(player.HasName)
 	{
-		_playerNames[playerIndex] = udtString::NewCloneFromRef(_playerNameAllocator, name);
+		_playerNames[playerIndex] = udtString::NewCloneFromRef(_playerNameAllocator, player.NameAndClan);
 	}
 	else
 	{
@@ -681,10 +666,9 @@ void udtCapturesAnalyzer::ProcessPlayerConfigStringQLorOSP(const char* configStr
 
 	if(AreAllProtocolFlagsSet(parser._inProtocol, udtProtocolFlagsEx::QL_ClanName))
 	{
-		udtString clan;
-		if(ParseConfigStringValueString(clan, *_tempAllocator, "cn", configString))
+		if(player.HasClan)
 		{
-			_playerClanNames[playerIndex] = udtString::NewCloneFromRef(_playerNameAllocator, clan);
+			_playerClanNames[playerIndex] = udtString::NewCloneFromRef(_playerNameAllocator, player.Clan);
 		}
 		else
 		{
@@ -711,7 +695,7 @@ void udtCapturesAnalyzer::ProcessPrintCommandQLorOSP(const udtCommandCallbackArg
 	// QL : "^4BLUE TEAM^3 CAPTURED the flag!^7 (^4BREAK ^7whaz captured in 0:12.490)\n"
 	// OSP: "^xFF00FF^6Raistlin^2 captured the BLUE flag! (held for 0:42.70)\n"
 
-	idTokenizer& tokenizer = parser._context->Tokenizer;
+	const idTokenizer& tokenizer = parser.GetTokenizer();
 	const udtString message = tokenizer.GetArg(1);
 	const bool qlMode = udtString::ContainsNoCase(message, "CAPTURED the flag!");
 	if(!qlMode &&
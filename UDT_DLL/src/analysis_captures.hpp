@@ -5,6 +5,10 @@
 #include "array.hpp"
 
 
+// The server commands udtCapturesAnalyzer::ProcessCommandMessage handles.
+#define UDT_CAPTURES_ANALYZER_COMMANDS (UDT_SERVER_COMMAND_BIT(ConfigString) | UDT_SERVER_COMMAND_BIT(Print))
+
+
 struct udtCapturesAnalyzer
 {
 public:
@@ -42,7 +46,7 @@ private:
 
 	bool ExtractPlayerIndexFromCaptureMessageQLorOSP(s32& playerIndex, const udtString& playerName, udtProtocol::Id protocol);
 
-	void ProcessPlayerConfigStringQLorOSP(const char* configString, udtBaseParser& parser, s32 playerIndex);
+	void ProcessPlayerConfigStringQLorOSP(udtBaseParser& parser, s32 playerIndex);
 	void ProcessFlagStatusCommandQLorOSP(const udtCommandCallbackArg& arg, udtBaseParser& parser);
 	void ProcessPrintCommandQLorOSP(const udtCommandCallbackArg& arg, udtBaseParser& parser);
 
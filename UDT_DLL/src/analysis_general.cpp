@@ -123,9 +123,9 @@ void udtGeneralAnalyzer::ProcessSnapshotMessage(const udtSnapshotCallbackArg& /*
 	}
 }
 
-void udtGeneralAnalyzer::ProcessGamestateMessage(const udtGamestateCallbackArg& /*arg*/, udtBaseParser& parser)
+void udtGeneralAnalyzer::ProcessGamestateMessage(const udtGamestateCallbackArg& arg, udtBaseParser& parser)
 {
-	++_gameStateIndex;
+	_gameStateIndex = arg.GameStateIndex;
 	_parser = &parser;
 	_protocol = parser._inProtocol;
 	_gamePlay = _protocol <= udtProtocol::Dm68 ? udtGamePlay::VQ3 : udtGamePlay::CQL;
@@ -150,17 +150,17 @@ void udtGeneralAnalyzer::ProcessGamestateMessage(const udtGamestateCallbackArg&
 	}
 	else
 	{
-		ProcessQ3ServerInfoConfigString(parser._inConfigStrings[CS_SERVERINFO].GetPtr());
+		ProcessQ3ServerInfoConfigString(CS_SERVERINFO);
 		ProcessModNameAndVersion();
 	}
 
 	ProcessMapName();
-	ProcessGameTypeFromServerInfo(parser._inConfigStrings[CS_SERVERINFO].GetPtr());
+	ProcessGameTypeFromServerInfo(CS_SERVERINFO);
 
 	if(_game == udtGame::RTCW)
 	{
-		ProcessWolfInfoConfigString(parser._inConfigStrings[CS_WOLF_INFO].GetPtr());
-		ProcessWolfServerInfoConfigString(parser._inConfigStrings[CS_SERVERINFO].GetPtr());
+		ProcessWolfInfoConfigString(CS_WOLF_INFO);
+		ProcessWolfServerInfoConfigString(CS_SERVERINFO);
 		ProcessWolfPausedConfigString(parser._inConfigStrings[CS_WOLF_PAUSED].GetPtr());
 
 		_rtcwWinningTeam = ParseWolfTeamFromConfigString(CS_WOLF_MULTI_MAPWINNER, "winner");
@@ -168,12 +168,12 @@ void udtGeneralAnalyzer::ProcessGamestateMessage(const udtGamestateCallbackArg&
 	}
 	else if(_game == udtGame::CPMA)
 	{
-		ProcessCPMAGameInfoConfigString(parser._inConfigStrings[CS_CPMA_GAME_INFO].GetPtr());
+		ProcessCPMAGameInfoConfigString(CS_CPMA_GAME_INFO);
 	}
 	else if(_game == udtGame::QL)
 	{
-		ProcessQ3AndQLServerInfoConfigString(parser._inConfigStrings[CS_SERVERINFO].GetPtr());
-		ProcessQLServerInfoConfigString(parser._inConfigStrings[CS_SERVERINFO].GetPtr());
+		ProcessQ3AndQLServerInfoConfigString(CS_SERVERINFO);
+		ProcessQLServerInfoConfigString(CS_SERVERINFO);
 		const s32 startIdx = GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::PauseStart, _protocol);
 		const s32 endIdx = GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::PauseEnd, _protocol);
 		if(startIdx != -1 && endIdx != -1)
@@ -184,7 +184,7 @@ void udtGeneralAnalyzer::ProcessGamestateMessage(const udtGamestateCallbackArg&
 	}
 	else if(_game == udtGame::Q3 || _game == udtGame::OSP)
 	{
-		ProcessQ3AndQLServerInfoConfigString(parser._inConfigStrings[CS_SERVERINFO].GetPtr());
+		ProcessQ3AndQLServerInfoConfigString(CS_SERVERINFO);
 		UpdateMatchStartTime();
 		const s32 warmUpEndTime = GetWarmUpEndTime();
 		const bool noIntermission = !IsIntermission();
@@ -208,19 +208,23 @@ void udtGeneralAnalyzer::ProcessGamestateMessage(const udtGamestateCallbackArg&
 	_processingGameState = false;
 }
 
-void udtGeneralAnalyzer::ProcessCommandMessage(const udtCommandCallbackArg& /*arg*/, udtBaseParser& parser)
+void udtGeneralAnalyzer::ProcessCommandMessage(const udtCommandCallbackArg& arg, udtBaseParser& parser)
 {
-	const idTokenizer& tokenizer = parser.GetTokenizer();
-	if(tokenizer.GetArgCount() == 0)
+	const udtServerCommand::Id command = arg.CommandId;
+	if(command != udtServerCommand::Print &&
+	   command != udtServerCommand::CenterPrint &&
+	   command != udtServerCommand::PlayerCenterPrint &&
+	   command != udtServerCommand::MapRestart &&
+	   command != udtServerCommand::ConfigString)
 	{
 		return;
 	}
 
-	const udtString command = tokenizer.GetArg(0);
+	const idTokenizer& tokenizer = parser.GetTokenizer();
 
 	if(_game == udtGame::CPMA && 
-	   tokenizer.GetArgCount() >= 2 && 
-	   udtString::Equals(command, "print"))
+	   command == udtServerCommand::Print &&
+	   tokenizer.GetArgCount() >= 2)
 	{
 		u32 index = 0;
 		const udtString printMessage = tokenizer.GetArg(1);
@@ -237,10 +241,10 @@ void udtGeneralAnalyzer::ProcessCommandMessage(const udtCommandCallbackArg& /*ar
 		}
 	}
 
-	if(tokenizer.GetArgCount() >= 2 &&
-	   (udtString::Equals(command, "print") || 
-	   udtString::Equals(command, "cp") ||
-	   udtString::Equals(command, "pcp")))
+	if((command == udtServerCommand::Print || 
+	    command == udtServerCommand::CenterPrint ||
+	    command == udtServerCommand::PlayerCenterPrint) &&
+	   tokenizer.GetArgCount() >= 2)
 	{
 		u32 index = 0;
 		const udtString printMessage = tokenizer.GetArg(1);
@@ -286,8 +290,8 @@ void udtGeneralAnalyzer::ProcessCommandMessage(const udtCommandCallbackArg& /*ar
 	
 	if(_game != udtGame::CPMA &&
 	   _game != udtGame::RTCW &&
-	   tokenizer.GetArgCount() == 1 &&
-	   udtString::Equals(command, "map_restart"))
+	   command == udtServerCommand::MapRestart &&
+	   tokenizer.GetArgCount() == 1)
 	{
 		UpdateGameState(udtGameState::InProgress);
 		if(HasMatchJustStarted())
@@ -297,8 +301,8 @@ void udtGeneralAnalyzer::ProcessCommandMessage(const udtCommandCallbackArg& /*ar
 	}
 	
 	s32 csIndex = 0;
-	if(tokenizer.GetArgCount() != 3 || 
-	   !udtString::Equals(command, "cs") || 
+	if(command != udtServerCommand::ConfigString ||
+	   tokenizer.GetArgCount() != 3 || 
 	   !StringParseInt(csIndex, tokenizer.GetArgString(1)))
 	{
 		return;
@@ -308,26 +312,26 @@ void udtGeneralAnalyzer::ProcessCommandMessage(const udtCommandCallbackArg& /*ar
 
 	if(csIndex == CS_SERVERINFO)
 	{
-		ProcessGameTypeFromServerInfo(configString);
+		ProcessGameTypeFromServerInfo(csIndex);
 	}
 
 	if(csIndex == CS_SERVERINFO && _game != udtGame::CPMA)
 	{
-		ProcessQ3AndQLServerInfoConfigString(configString);
+		ProcessQ3AndQLServerInfoConfigString(csIndex);
 	}
 
 	if(_game == udtGame::QL && csIndex == CS_SERVERINFO)
 	{
-		ProcessQLServerInfoConfigString(configString);
+		ProcessQLServerInfoConfigString(csIndex);
 	}
 
 	if(_game == udtGame::RTCW && csIndex == CS_WOLF_INFO)
 	{
-		ProcessWolfInfoConfigString(configString);
+		ProcessWolfInfoConfigString(csIndex);
 	}
 	else if(_game == udtGame::RTCW && csIndex == CS_SERVERINFO)
 	{
-		ProcessWolfServerInfoConfigString(configString);
+		ProcessWolfServerInfoConfigString(csIndex);
 	}
 	else if(_game == udtGame::RTCW && csIndex == CS_WOLF_PAUSED)
 	{
@@ -350,11 +354,11 @@ void udtGeneralAnalyzer::ProcessCommandMessage(const udtCommandCallbackArg& /*ar
 	}
 	else if(_game == udtGame::CPMA && csIndex == CS_CPMA_GAME_INFO)
 	{
-		ProcessCPMAGameInfoConfigString(configString);
+		ProcessCPMAGameInfoConfigString(csIndex);
 	}
 	else if(_game == udtGame::CPMA && csIndex == CS_CPMA_ROUND_INFO)
 	{
-		ProcessCPMARoundInfoConfigString(configString);
+		ProcessCPMARoundInfoConfigString(csIndex);
 	}
 	else if((_game == udtGame::Q3 || _game == udtGame::OSP) && 
 			csIndex == GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::LevelStartTime, _protocol))
@@ -586,45 +590,36 @@ void udtGeneralAnalyzer::UpdateGameState(udtGameState::Id gameState)
 	}
 }
 
-void udtGeneralAnalyzer::ProcessQ3ServerInfoConfigString(const char* configString)
+void udtGeneralAnalyzer::ProcessQ3ServerInfoConfigString(s32 csIndex)
 {
-	if(configString == NULL)
-	{
-		return;
-	}
-
-	udtVMScopedStackAllocator scopedTempAllocator(*_tempAllocator);
-
 	u32 charIndex = 0;
 	udtString varValue;
-	if(ParseConfigStringValueString(varValue, *_tempAllocator, "gamename", configString) &&
+	if(_parser->GetConfigStringValueString(varValue, csIndex, "gamename") &&
 	   udtString::Equals(varValue, "cpma"))
 	{
 		_game = udtGame::CPMA;
 	}
-	else if(ParseConfigStringValueString(varValue, *_tempAllocator, "gamename", configString) &&
+	else if(_parser->GetConfigStringValueString(varValue, csIndex, "gamename") &&
 			udtString::ContainsNoCase(charIndex, varValue, "osp"))
 	{
 		_game = udtGame::OSP;
 	}
-	else if(ParseConfigStringValueString(varValue, *_tempAllocator, "gameversion", configString) &&
+	else if(_parser->GetConfigStringValueString(varValue, csIndex, "gameversion") &&
 			udtString::ContainsNoCase(charIndex, varValue, "osp"))
 	{
 		_game = udtGame::OSP;
 	}
 }
 
-void udtGeneralAnalyzer::ProcessCPMAGameInfoConfigString(const char* configString)
+void udtGeneralAnalyzer::ProcessCPMAGameInfoConfigString(s32 csIndex)
 {
-	if(configString == NULL)
+	if(udtString::IsNull(_parser->GetConfigString(csIndex)))
 	{
 		return;
 	}
 
-	udtVMScopedStackAllocator tempAllocScope(*_tempAllocator);
-
 	s32 gamePlay = 0;
-	if(ParseConfigStringValueInt(gamePlay, *_tempAllocator, "pm", configString))
+	if(_parser->GetConfigStringValueInt(gamePlay, csIndex, "pm"))
 	{
 		switch(gamePlay)
 		{
@@ -638,13 +633,13 @@ void udtGeneralAnalyzer::ProcessCPMAGameInfoConfigString(const char* configStrin
 	}
 
 	s32 tl = 0;
-	if(ParseConfigStringValueInt(tl, *_tempAllocator, "tl", configString))
+	if(_parser->GetConfigStringValueInt(tl, csIndex, "tl"))
 	{
 		_timeLimit = tl;
 	}
 
 	s32 sl = 0;
-	if(ParseConfigStringValueInt(sl, *_tempAllocator, "sl", configString))
+	if(_parser->GetConfigStringValueInt(sl, csIndex, "sl"))
 	{
 		const u8* gameTypeFlags = NULL;
 		u32 gameTypeCount = 0;
@@ -676,7 +671,7 @@ void udtGeneralAnalyzer::ProcessCPMAGameInfoConfigString(const char* configStrin
 	}
 
 	s32 te = -1;
-	if(ParseConfigStringValueInt(te, *_tempAllocator, "te", configString))
+	if(_parser->GetConfigStringValueInt(te, csIndex, "te"))
 	{
 		const bool timeOutStarted = te != 0 && _te == 0;
 		const bool timeOutEnded = te == 0 && _te != 0;
@@ -699,8 +694,8 @@ void udtGeneralAnalyzer::ProcessCPMAGameInfoConfigString(const char* configStrin
 
 	s32 tw = -1;
 	s32 ts = -1;
-	if(ParseConfigStringValueInt(tw, *_tempAllocator, "tw", configString) &&
-	   ParseConfigStringValueInt(ts, *_tempAllocator, "ts", configString))
+	if(_parser->GetConfigStringValueInt(tw, csIndex, "tw") &&
+	   _parser->GetConfigStringValueInt(ts, csIndex, "ts"))
 	{
 		// CPMA problem:
 		// Can go from InProgress to WarmUp for CTFS/CA rounds.
@@ -740,8 +735,8 @@ void udtGeneralAnalyzer::ProcessCPMAGameInfoConfigString(const char* configStrin
 	s32 cb = -1;
 	if(_gameType >= udtGameType::FirstTeamMode &&
 	   _gameState == udtGameState::InProgress &&
-	   ParseConfigStringValueInt(cr, *_tempAllocator, "cr", configString) &&
-	   ParseConfigStringValueInt(cb, *_tempAllocator, "cb", configString) &&
+	   _parser->GetConfigStringValueInt(cr, csIndex, "cr") &&
+	   _parser->GetConfigStringValueInt(cb, csIndex, "cb") &&
 	   (cr == 0 || cb == 0))
 	{
 		// If all the players of a team leave during a match, the team forfeits.
@@ -749,40 +744,26 @@ void udtGeneralAnalyzer::ProcessCPMAGameInfoConfigString(const char* configStrin
 	}
 }
 
-void udtGeneralAnalyzer::ProcessCPMARoundInfoConfigString(const char* configString)
+void udtGeneralAnalyzer::ProcessCPMARoundInfoConfigString(s32 csIndex)
 {
-	if(configString == NULL)
-	{
-		return;
-	}
-
-	udtVMScopedStackAllocator scopedTempAllocator(*_tempAllocator);
-
 	s32 score = 0;
-	if((ParseConfigStringValueInt(score, *_tempAllocator, "sr", configString) && score == -9999) ||
-	   (ParseConfigStringValueInt(score, *_tempAllocator, "sb", configString) && score == -9999))
+	if((_parser->GetConfigStringValueInt(score, csIndex, "sr") && score == -9999) ||
+	   (_parser->GetConfigStringValueInt(score, csIndex, "sb") && score == -9999))
 	{
 		_forfeited = true;
 	}
 }
 
-void udtGeneralAnalyzer::ProcessQLServerInfoConfigString(const char* configString)
+void udtGeneralAnalyzer::ProcessQLServerInfoConfigString(s32 csIndex)
 {
-	if(configString == NULL)
-	{
-		return;
-	}
-
-	udtVMScopedStackAllocator scopedTempAllocator(*_tempAllocator);
-
 	s32 matchStartDate;
-	if(ParseConfigStringValueInt(matchStartDate, *_tempAllocator, "g_levelStartTime", configString))
+	if(_parser->GetConfigStringValueInt(matchStartDate, csIndex, "g_levelStartTime"))
 	{
 		_matchStartDateEpoch = (u32)matchStartDate;
 	}
 
 	s32 gamePlay = 0;
-	if(ParseConfigStringValueInt(gamePlay, *_tempAllocator, "ruleset", configString))
+	if(_parser->GetConfigStringValueInt(gamePlay, csIndex, "ruleset"))
 	{
 		switch(gamePlay)
 		{
@@ -794,7 +775,7 @@ void udtGeneralAnalyzer::ProcessQLServerInfoConfigString(const char* configStrin
 	}
 
 	udtString gameStateString;
-	if(!ParseConfigStringValueString(gameStateString, *_tempAllocator, "g_gameState", configString))
+	if(!_parser->GetConfigStringValueString(gameStateString, csIndex, "g_gameState"))
 	{
 		return;
 	}
@@ -843,17 +824,10 @@ void udtGeneralAnalyzer::ProcessIntermissionConfigString(const udtString& config
 	}
 }
 
-void udtGeneralAnalyzer::ProcessGameTypeFromServerInfo(const char* configString)
+void udtGeneralAnalyzer::ProcessGameTypeFromServerInfo(s32 csIndex)
 {
-	if(configString == NULL)
-	{
-		return;
-	}
-
-	udtVMScopedStackAllocator scopedTempAllocator(*_tempAllocator);
-
 	s32 gameType = 0;
-	if(!ParseConfigStringValueInt(gameType, *_tempAllocator, "g_gametype", configString))
+	if(!_parser->GetConfigStringValueInt(gameType, csIndex, "g_gametype"))
 	{
 		return;
 	}
@@ -897,41 +871,34 @@ void udtGeneralAnalyzer::ProcessOSPGamePlayConfigString(const char* configString
 	}
 }
 
-void udtGeneralAnalyzer::ProcessQ3AndQLServerInfoConfigString(const char* configString)
+void udtGeneralAnalyzer::ProcessQ3AndQLServerInfoConfigString(s32 csIndex)
 {
-	if(configString == NULL)
-	{
-		return;
-	}
-
-	udtVMScopedStackAllocator scopedTempAllocator(*_tempAllocator);
-
 	s32 timeLimit;
-	if(ParseConfigStringValueInt(timeLimit, *_tempAllocator, "timelimit", configString))
+	if(_parser->GetConfigStringValueInt(timeLimit, csIndex, "timelimit"))
 	{
 		_timeLimit = timeLimit;
 	}
 
 	s32 scoreLimit;
-	if(ParseConfigStringValueInt(scoreLimit, *_tempAllocator, "scorelimit", configString))
+	if(_parser->GetConfigStringValueInt(scoreLimit, csIndex, "scorelimit"))
 	{
 		_scoreLimit = scoreLimit;
 	}
 
 	s32 fragLimit;
-	if(ParseConfigStringValueInt(fragLimit, *_tempAllocator, "fraglimit", configString))
+	if(_parser->GetConfigStringValueInt(fragLimit, csIndex, "fraglimit"))
 	{
 		_fragLimit = fragLimit;
 	}
 
 	s32 captureLimit;
-	if(ParseConfigStringValueInt(captureLimit, *_tempAllocator, "capturelimit", configString))
+	if(_parser->GetConfigStringValueInt(captureLimit, csIndex, "capturelimit"))
 	{
 		_captureLimit = captureLimit;
 	}
 
 	s32 roundLimit;
-	if(ParseConfigStringValueInt(roundLimit, *_tempAllocator, "roundlimit", configString))
+	if(_parser->GetConfigStringValueInt(roundLimit, csIndex, "roundlimit"))
 	{
 		_roundLimit = roundLimit;
 	}
@@ -1025,17 +992,15 @@ void udtGeneralAnalyzer::ProcessQLPauseEndConfigString(const char* configString)
 	}
 }
 
-void udtGeneralAnalyzer::ProcessWolfInfoConfigString(const char* configString)
+void udtGeneralAnalyzer::ProcessWolfInfoConfigString(s32 csIndex)
 {
-	if(configString == NULL)
+	if(udtString::IsNull(_parser->GetConfigString(csIndex)))
 	{
 		return;
 	}
 
-	udtVMScopedStackAllocator tempAllocScope(*_tempAllocator);
-
 	s32 roundIndex;
-	if(ParseConfigStringValueInt(roundIndex, *_tempAllocator, "g_currentRound", configString))
+	if(_parser->GetConfigStringValueInt(roundIndex, csIndex, "g_currentRound"))
 	{
 		_roundIndex = (u32)roundIndex;
 	}
@@ -1056,7 +1021,7 @@ void udtGeneralAnalyzer::ProcessWolfInfoConfigString(const char* configString)
 
 	udtGameState::Id newGameState = udtGameState::WarmUp;
 	s32 wolfGS = -1;
-	if(ParseConfigStringValueInt(wolfGS, *_tempAllocator, "gamestate", configString))
+	if(_parser->GetConfigStringValueInt(wolfGS, csIndex, "gamestate"))
 	{
 		switch((WolfGS::Id)wolfGS)
 		{
@@ -1078,24 +1043,17 @@ void udtGeneralAnalyzer::ProcessWolfInfoConfigString(const char* configString)
 	}
 }
 
-void udtGeneralAnalyzer::ProcessWolfServerInfoConfigString(const char* configString)
+void udtGeneralAnalyzer::ProcessWolfServerInfoConfigString(s32 csIndex)
 {
-	if(configString == NULL)
-	{
-		return;
-	}
-
-	udtVMScopedStackAllocator tempAllocScope(*_tempAllocator);
-
 	s32 timeLimit;
-	if(ParseConfigStringValueInt(timeLimit, *_tempAllocator, "timelimit", configString))
+	if(_parser->GetConfigStringValueInt(timeLimit, csIndex, "timelimit"))
 	{
 		_timeLimit = timeLimit;
 	}
 
 	_gamePlay = udtGamePlay::VRTCW;
 	udtString gameName;
-	if(ParseConfigStringValueString(gameName, *_tempAllocator, "gamename", configString))
+	if(_parser->GetConfigStringValueString(gameName, csIndex, "gamename"))
 	{
 		if(udtString::StartsWithNoCase(gameName, "RtcwPro "))
 		{
@@ -1105,7 +1063,7 @@ void udtGeneralAnalyzer::ProcessWolfServerInfoConfigString(const char* configStr
 		}
 	}
 	udtString gameVersion;
-	if(ParseConfigStringValueString(gameVersion, *_tempAllocator, "gameversion", configString))
+	if(_parser->GetConfigStringValueString(gameVersion, csIndex, "gameversion"))
 	{
 		if(udtString::StartsWithNoCase(gameVersion, "OSP v"))
 		{
@@ -1152,10 +1110,8 @@ void udtGeneralAnalyzer::ProcessWolfPausedConfigString(const char* configString)
 
 udtTeam::Id udtGeneralAnalyzer::ParseWolfTeamFromConfigString(u32 csIndex, const char* keyName)
 {
-	udtVMScopedStackAllocator scopedTempAllocator(*_tempAllocator);
-	const char* const cs = _parser->_inConfigStrings[csIndex].GetPtr();
 	s32 team;
-	if(ParseConfigStringValueInt(team, *_tempAllocator, keyName, cs) && team == 1)
+	if(_parser->GetConfigStringValueInt(team, (s32)csIndex, keyName) && team == 1)
 	{
 		return udtTeam::Allies;
 	}
@@ -1164,9 +1120,6 @@ udtTeam::Id udtGeneralAnalyzer::ParseWolfTeamFromConfigString(u32 csIndex, const
 
 void udtGeneralAnalyzer::ProcessModNameAndVersion()
 {
-	udtVMScopedStackAllocator scopedTempAllocator(*_tempAllocator);
-	const char* const serverInfo = _parser->_inConfigStrings[CS_SERVERINFO].GetPtr();
-
 	u32 charIndex = 0;
 	udtString varValue;
 
@@ -1174,8 +1127,7 @@ void udtGeneralAnalyzer::ProcessModNameAndVersion()
 	{
 		_mod = udtMod::CPMA;
 
-		if(serverInfo != NULL &&
-		   ParseConfigStringValueString(varValue, *_tempAllocator, "gameversion", serverInfo))
+		if(_parser->GetConfigStringValueString(varValue, CS_SERVERINFO, "gameversion"))
 		{
 			_modVersion = udtString::NewCloneFromRef(_stringAllocator, varValue);
 		}
@@ -1184,8 +1136,7 @@ void udtGeneralAnalyzer::ProcessModNameAndVersion()
 	{
 		_mod = udtMod::OSP;
 
-		if(serverInfo != NULL &&
-		   ParseConfigStringValueString(varValue, *_tempAllocator, "gameversion", serverInfo))
+		if(_parser->GetConfigStringValueString(varValue, CS_SERVERINFO, "gameversion"))
 		{
 			u32 openParen = 0;
 			u32 closeParen = 0;
@@ -1211,13 +1162,12 @@ void udtGeneralAnalyzer::ProcessModNameAndVersion()
 	}
 	else if(_mod == udtMod::None)
 	{
-		if(serverInfo != NULL &&
-		   ParseConfigStringValueString(varValue, *_tempAllocator, "gamename", serverInfo) &&
+		if(_parser->GetConfigStringValueString(varValue, CS_SERVERINFO, "gamename") &&
 		   udtString::ContainsNoCase(charIndex, varValue, "defrag"))
 		{
 			_mod = udtMod::Defrag;
 
-			if(ParseConfigStringValueString(varValue, *_tempAllocator, "defrag_vers", serverInfo))
+			if(_parser->GetConfigStringValueString(varValue, CS_SERVERINFO, "defrag_vers"))
 			{
 				s32 version = 0;
 				if(varValue.GetLength() == 5 && 
@@ -1243,12 +1193,8 @@ void udtGeneralAnalyzer::ProcessModNameAndVersion()
 
 void udtGeneralAnalyzer::ProcessMapName()
 {
-	udtVMScopedStackAllocator scopedTempAllocator(*_tempAllocator);
-
-	const udtString& cs = _parser->GetConfigString(CS_SERVERINFO);
 	udtString mapName;
-	if(!udtString::IsNullOrEmpty(cs) &&
-	   ParseConfigStringValueString(mapName, *_tempAllocator, "mapname", cs.GetPtr()))
+	if(_parser->GetConfigStringValueString(mapName, CS_SERVERINFO, "mapname"))
 	{
 		_mapName = udtString::NewCloneFromRef(_stringAllocator, mapName);
 	}
@@ -1293,8 +1239,7 @@ s32 udtGeneralAnalyzer::GetWarmUpEndTime()
 		return warmUpEndTimeMs;
 	}
 
-	udtVMScopedStackAllocator scopedTempAllocator(*_tempAllocator);
-	if(ParseConfigStringValueInt(warmUpEndTimeMs, *_tempAllocator, "time", cs.GetPtr()))
+	if(_parser->GetConfigStringValueInt(warmUpEndTimeMs, csIndex, "time"))
 	{
 		return warmUpEndTimeMs;
 	}
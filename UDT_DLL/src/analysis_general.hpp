@@ -4,6 +4,15 @@
 #include "parser.hpp"
 
 
+// The server commands udtGeneralAnalyzer::ProcessCommandMessage handles.
+#define UDT_GENERAL_ANALYZER_COMMANDS \
+	(UDT_SERVER_COMMAND_BIT(ConfigString) | \
+	 UDT_SERVER_COMMAND_BIT(Print) | \
+	 UDT_SERVER_COMMAND_BIT(CenterPrint) | \
+	 UDT_SERVER_COMMAND_BIT(PlayerCenterPrint) | \
+	 UDT_SERVER_COMMAND_BIT(MapRestart))
+
+
 struct udtGeneralAnalyzer
 {
 public:
@@ -86,20 +95,20 @@ private:
 	void UpdateGameState(udtGameState::Id gameState);
 	void ProcessModNameAndVersion();
 	void ProcessMapName();
-	void ProcessQ3ServerInfoConfigString(const char* configString);
-	void ProcessCPMAGameInfoConfigString(const char* configString);
-	void ProcessCPMARoundInfoConfigString(const char* configString);
-	void ProcessQLServerInfoConfigString(const char* configString);
+	void ProcessQ3ServerInfoConfigString(s32 csIndex);
+	void ProcessCPMAGameInfoConfigString(s32 csIndex);
+	void ProcessCPMARoundInfoConfigString(s32 csIndex);
+	void ProcessQLServerInfoConfigString(s32 csIndex);
 	void ProcessIntermissionConfigString(const udtString& configString);
-	void ProcessGameTypeFromServerInfo(const char* configString);
+	void ProcessGameTypeFromServerInfo(s32 csIndex);
 	void ProcessOSPGamePlayConfigString(const char* configString);
-	void ProcessQ3AndQLServerInfoConfigString(const char* configString);
+	void ProcessQ3AndQLServerInfoConfigString(s32 csIndex);
 	void ProcessScores2(const char* configString);
 	void ProcessScores2Player(const char* configString);
 	void ProcessQLPauseStartConfigString(const char* configString);
 	void ProcessQLPauseEndConfigString(const char* configString);
-	void ProcessWolfInfoConfigString(const char* configString);
-	void ProcessWolfServerInfoConfigString(const char* configString);
+	void ProcessWolfInfoConfigString(s32 csIndex);
+	void ProcessWolfServerInfoConfigString(s32 csIndex);
 	void ProcessWolfPausedConfigString(const char* configString);
 	udtTeam::Id ParseWolfTeamFromConfigString(u32 csIndex, const char* keyName);
 	s32  GetLevelStartTime();
@@ -73,39 +73,27 @@ udtString udtObituariesAnalyzer::AllocatePlayerName(udtBaseParser& parser, s32 p
 		return udtString::NewClone(_stringAllocator, "world");
 	}
 
-	const s32 firstPlayerCsIdx = GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::FirstPlayer, parser._inProtocol);
-	const char* const cs = parser._inConfigStrings[firstPlayerCsIdx + playerIdx].GetPtr();
-
-	udtVMScopedStackAllocator scopedTempAllocator(*_tempAllocator);
-
-	udtString clan, player;
-	bool hasClan;
-	if(!GetClanAndPlayerName(clan, player, hasClan, *_tempAllocator, parser._inProtocol, cs))
+	const udtPlayerRosterEntry& player = parser.GetPlayer(playerIdx);
+	if(!player.HasName)
 	{
 		return udtString::NewNull();
 	}
 
-	return udtString::NewCleanCloneFromRef(_stringAllocator, parser._inProtocol, player);
+	return udtString::NewCloneFromRef(_stringAllocator, player.CleanName);
 }
 
 void udtObituariesAnalyzer::ProcessGamestateMessage(const udtGamestateCallbackArg& /*arg*/, udtBaseParser& parser)
 {
-	const s32 csFirstPlayerIdx = GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::FirstPlayer, parser._inProtocol);
 	for(s32 i = 0; i < 64; ++i)
 	{
-		const udtString& cs = parser.GetConfigString(csFirstPlayerIdx + i);
-		if(!udtString::IsNullOrEmpty(cs))
-		{
-			udtVMScopedStackAllocator tempAllocScope(*_tempAllocator);
-			ParseConfigStringValueInt(_playerTeams[i], *_tempAllocator, "t", cs.GetPtr());
-		}
+		UpdatePlayerTeam(parser, i);
 	}
 }
 
-void udtObituariesAnalyzer::ProcessCommandMessage(const udtCommandCallbackArg& /*arg*/, udtBaseParser& parser)
+void udtObituariesAnalyzer::ProcessCommandMessage(const udtCommandCallbackArg& arg, udtBaseParser& parser)
 {
 	const idTokenizer& tokenizer = parser.GetTokenizer();
-	if(strcmp(tokenizer.GetArgString(0), "cs") != 0 || 
+	if(arg.CommandId != udtServerCommand::ConfigString || 
 	   tokenizer.GetArgCount() != 3)
 	{
 		return;
@@ -124,12 +112,14 @@ void udtObituariesAnalyzer::ProcessCommandMessage(const udtCommandCallbackArg& /
 		return;
 	}
 
-	const udtString& cs = parser.GetConfigString(csIndex);
-	if(udtString::IsNullOrEmpty(cs))
+	UpdatePlayerTeam(parser, playerIdx);
+}
+
+void udtObituariesAnalyzer::UpdatePlayerTeam(udtBaseParser& parser, s32 playerIdx)
+{
+	const udtPlayerRosterEntry& player = parser.GetPlayer(playerIdx);
+	if(player.HasTeam)
 	{
-		return;
+		_playerTeams[playerIdx] = player.IdTeam;
 	}
-
-	udtVMScopedStackAllocator tempAllocScope(*_tempAllocator);
-	ParseConfigStringValueInt(_playerTeams[playerIdx], *_tempAllocator, "t", cs.GetPtr());
 }
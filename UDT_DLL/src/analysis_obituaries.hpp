@@ -36,6 +36,7 @@ private:
 	UDT_NO_COPY_SEMANTICS(udtObituariesAnalyzer);
 
 	udtString AllocatePlayerName(udtBaseParser& parser, s32 playerIdx);
+	void      UpdatePlayerTeam(udtBaseParser& parser, s32 playerIdx);
 
 	udtVMLinearAllocator _stringAllocator { "ObituariesAnalyzer::Strings" };
 	udtVMLinearAllocator* _tempAllocator;
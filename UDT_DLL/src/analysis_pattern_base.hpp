@@ -12,7 +12,7 @@ struct udtPatternSearchAnalyzerBase
 public:
 	friend udtPatternSearchPlugIn;
 
-	udtPatternSearchAnalyzerBase() {}
+	udtPatternSearchAnalyzerBase() : SubscribedCommands(0) {}
 	virtual ~udtPatternSearchAnalyzerBase() {}
 
 	virtual void InitAllocators(u32 /*demoCount*/) {}
@@ -22,7 +22,20 @@ public:
 	virtual void ProcessSnapshotMessage(const udtSnapshotCallbackArg& /*arg*/, udtBaseParser& /*parser*/) {}
 	virtual void ProcessCommandMessage(const udtCommandCallbackArg& /*arg*/, udtBaseParser& /*parser*/) {}
 
+	// The sections found so far, before FinishAnalysis is called.
+	// Analyzers that keep their sections elsewhere until the end of the demo must override both.
+	virtual u32  GetCurrentCutSectionCount() const { return CutSections.GetSize(); }
+	virtual void GetCurrentCutSections(udtVMArray<udtCutSection>& cutSections) const
+	{
+		cutSections.Clear();
+		for(u32 i = 0, count = CutSections.GetSize(); i < count; ++i)
+		{
+			cutSections.Add(CutSections[i]);
+		}
+	}
+
 	udtVMArray<udtCutSection> CutSections { "PatternSearchAnalyzerBase::CutSectionsArray" };
+	u64 SubscribedCommands; // See UDT_SERVER_COMMAND_BIT. The plug-in only forwards these commands.
 
 protected:
 	udtPatternSearchPlugIn* PlugIn;
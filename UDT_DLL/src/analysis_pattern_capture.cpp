@@ -4,6 +4,7 @@
 
 udtFlagCapturePatternAnalyzer::udtFlagCapturePatternAnalyzer()
 {
+	SubscribedCommands = UDT_CAPTURES_ANALYZER_COMMANDS;
 }
 
 udtFlagCapturePatternAnalyzer::~udtFlagCapturePatternAnalyzer()
@@ -6,26 +6,25 @@
 #include "cut_section.hpp"
 
 
-static bool GetMessageAndType(udtString& message, bool& isTeamMessage, const idTokenizer& tokenizer, udtBaseParser& parser)
+static bool GetMessageAndType(udtString& message, bool& isTeamMessage, udtServerCommand::Id command, const idTokenizer& tokenizer, udtBaseParser& parser)
 {
 	bool hasCPMASyntax = false;
 
-	const udtString command = tokenizer.GetArg(0);
-	if(udtString::Equals(command, "chat"))
+	if(command == udtServerCommand::Chat)
 	{
 		isTeamMessage = false;
 	}
-	else if(udtString::Equals(command, "tchat"))
+	else if(command == udtServerCommand::TeamChat)
 	{
 		isTeamMessage = true;
 	}
-	else if(udtString::Equals(command, "lchat"))
+	else if(command == udtServerCommand::LocalChat)
 	{
 		// @TODO: confirm that this is correct
 		// it probably is since it displays with the same color as "chat"
 		isTeamMessage = false;
 	}
-	else if(udtString::Equals(command, "mm2"))
+	else if(command == udtServerCommand::CPMATeamChat)
 	{
 		isTeamMessage = true;
 		hasCPMASyntax = true;
@@ -76,13 +75,18 @@ static bool GetMessageAndType(udtString& message, bool& isTeamMessage, const idT
 
 udtChatPatternAnalyzer::udtChatPatternAnalyzer()
 {
+	SubscribedCommands = 
+		UDT_SERVER_COMMAND_BIT(Chat) | 
+		UDT_SERVER_COMMAND_BIT(TeamChat) | 
+		UDT_SERVER_COMMAND_BIT(LocalChat) | 
+		UDT_SERVER_COMMAND_BIT(CPMATeamChat);
 }
 
 udtChatPatternAnalyzer::~udtChatPatternAnalyzer()
 {
 }
 
-void udtChatPatternAnalyzer::ProcessCommandMessage(const udtCommandCallbackArg& /*commandInfo*/, udtBaseParser& parser)
+void udtChatPatternAnalyzer::ProcessCommandMessage(const udtCommandCallbackArg& commandInfo, udtBaseParser& parser)
 {
 	const idTokenizer& tokenizer = parser.GetTokenizer();
 	if(tokenizer.GetArgCount() < 2)
@@ -93,7 +97,7 @@ void udtChatPatternAnalyzer::ProcessCommandMessage(const udtCommandCallbackArg&
 	udtString message;
 	bool isTeamMessage;
 	udtVMScopedStackAllocator allocatorScopeGuard(parser._tempAllocator);
-	if(!GetMessageAndType(message, isTeamMessage, tokenizer, parser))
+	if(!GetMessageAndType(message, isTeamMessage, commandInfo.CommandId, tokenizer, parser))
 	{
 		return;
 	}
@@ -142,3 +146,9 @@ void udtChatPatternAnalyzer::FinishAnalysis()
 {
 	MergeRanges(CutSections, _cutSections);
 }
+
+void udtChatPatternAnalyzer::GetCurrentCutSections(udtVMArray<udtCutSection>& cutSections) const
+{
+	cutSections.Clear();
+	MergeRanges(cutSections, _cutSections);
+}
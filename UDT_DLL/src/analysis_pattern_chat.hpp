@@ -17,6 +17,8 @@ public:
 	void StartAnalysis() override;
 	void FinishAnalysis() override;
 	void ProcessCommandMessage(const udtCommandCallbackArg& info, udtBaseParser& parser) override;
+	u32  GetCurrentCutSectionCount() const override { return _cutSections.GetSize(); }
+	void GetCurrentCutSections(udtVMArray<udtCutSection>& cutSections) const override;
 
 private:
 	UDT_NO_COPY_SEMANTICS(udtChatPatternAnalyzer);
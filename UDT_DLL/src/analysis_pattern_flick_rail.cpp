@@ -20,9 +20,9 @@ void udtFlickRailPatternAnalyzer::StartAnalysis()
 	_gameStateIndex = -1;
 }
 
-void udtFlickRailPatternAnalyzer::ProcessGamestateMessage(const udtGamestateCallbackArg& /*arg*/, udtBaseParser& /*parser*/)
+void udtFlickRailPatternAnalyzer::ProcessGamestateMessage(const udtGamestateCallbackArg& arg, udtBaseParser& /*parser*/)
 {
-	++_gameStateIndex;
+	_gameStateIndex = arg.GameStateIndex;
 	memset(_players, 0, sizeof(_players));
 }
 
@@ -60,6 +60,7 @@ static bool IsAllowedUDTMeanOfDeath(s32 udtMod, u32 udtPlayerMODFlags)
 udtFragRunPatternAnalyzer::udtFragRunPatternAnalyzer()
 {
 	_analyzer.SetNameAllocationEnabled(false);
+	SubscribedCommands = UDT_SERVER_COMMAND_BIT(ConfigString); // For the obituaries analyzer.
 }
 
 udtFragRunPatternAnalyzer::~udtFragRunPatternAnalyzer()
@@ -25,6 +25,7 @@ static const char* ShortDescriptions[16] =
 
 udtMatchPatternAnalyzer::udtMatchPatternAnalyzer()
 {
+	SubscribedCommands = _statsAnalyzer.SubscribedCommands;
 }
 
 udtMatchPatternAnalyzer::~udtMatchPatternAnalyzer()
@@ -195,11 +195,11 @@ void udtMidAirPatternAnalyzer::StartAnalysis()
 	memset(_players, 0, sizeof(_players));
 }
 
-void udtMidAirPatternAnalyzer::ProcessGamestateMessage(const udtGamestateCallbackArg& /*arg*/, udtBaseParser& parser)
+void udtMidAirPatternAnalyzer::ProcessGamestateMessage(const udtGamestateCallbackArg& arg, udtBaseParser& parser)
 {
 	_protocol = parser._inProtocol;
 
-	++_gameStateIndex;
+	_gameStateIndex = arg.GameStateIndex;
 
 	for(u32 i = 0; i < (u32)UDT_COUNT_OF(_players); ++i)
 	{
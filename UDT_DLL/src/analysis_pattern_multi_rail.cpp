@@ -17,9 +17,9 @@ void udtMultiRailPatternAnalyzer::StartAnalysis()
 	_gameStateIndex = -1;
 }
 
-void udtMultiRailPatternAnalyzer::ProcessGamestateMessage(const udtGamestateCallbackArg& /*arg*/, udtBaseParser& /*parser*/)
+void udtMultiRailPatternAnalyzer::ProcessGamestateMessage(const udtGamestateCallbackArg& arg, udtBaseParser& /*parser*/)
 {
-	++_gameStateIndex;
+	_gameStateIndex = arg.GameStateIndex;
 }
 
 void udtMultiRailPatternAnalyzer::ProcessSnapshotMessage(const udtSnapshotCallbackArg& arg, udtBaseParser& parser)
@@ -9,12 +9,12 @@
 #include "crash.hpp"
 #include "scoped_stack_allocator.hpp"
 #include "multi_threaded_processing.hpp"
-#include "analysis_splitter.hpp"
 #include "path.hpp"
 #include "thread_local_allocators.hpp"
 #include "system.hpp"
 #include "custom_context.hpp"
 #include "pattern_search_context.hpp"
+#include "server_commands.hpp"
 
 // For malloc and free.
 #include <stdlib.h>
@@ -628,6 +628,20 @@ UDT_API(s32) udtMergeBatchPerfStats(u64* destPerfStats, const u64* sourcePerfSta
 
 	destPerfStats[udtPerfStatsField::ResizeCount] += sourcePerfStats[udtPerfStatsField::ResizeCount];
 
+	// Utilization is weighted by batch duration.
+	const u64 sourceDuration = sourcePerfStats[udtPerfStatsField::Duration];
+	const u64 destDuration = destPerfStats[udtPerfStatsField::Duration];
+	const u64 oldDestDuration = destDuration - sourceDuration;
+	if(destDuration > 0)
+	{
+		destPerfStats[udtPerfStatsField::ThreadUtilization] = 
+			(destPerfStats[udtPerfStatsField::ThreadUtilization] * oldDestDuration + 
+			 sourcePerfStats[udtPerfStatsField::ThreadUtilization] * sourceDuration) / destDuration;
+	}
+	destPerfStats[udtPerfStatsField::MinThreadUtilization] = (oldDestDuration > 0) ?
+		udt_min(destPerfStats[udtPerfStatsField::MinThreadUtilization], sourcePerfStats[udtPerfStatsField::MinThreadUtilization]) :
+		sourcePerfStats[udtPerfStatsField::MinThreadUtilization];
+
 	return (s32)udtErrorCode::None;
 }
 
@@ -638,6 +652,19 @@ UDT_API(s32) udtAddThreadPerfStats(u64* destPerfStats, const u64* sourcePerfStat
 		return (s32)udtErrorCode::InvalidArgument;
 	}
 
+	// Utilization is relative to the longest thread's duration, so we work with busy times.
+	const u64 destThreadCount = destPerfStats[udtPerfStatsField::ThreadCount];
+	const u64 sourceThreadCount = sourcePerfStats[udtPerfStatsField::ThreadCount];
+	const u64 destDuration = destPerfStats[udtPerfStatsField::Duration];
+	const u64 sourceDuration = sourcePerfStats[udtPerfStatsField::Duration];
+	const u64 totalBusyTime = 
+		(destPerfStats[udtPerfStatsField::ThreadUtilization] * destThreadCount * destDuration + 
+		 sourcePerfStats[udtPerfStatsField::ThreadUtilization] * sourceThreadCount * sourceDuration) / 1000;
+	const u64 sourceMinBusyTime = (sourcePerfStats[udtPerfStatsField::MinThreadUtilization] * sourceDuration) / 1000;
+	const u64 minBusyTime = (destThreadCount > 0) ?
+		udt_min((destPerfStats[udtPerfStatsField::MinThreadUtilization] * destDuration) / 1000, sourceMinBusyTime) :
+		sourceMinBusyTime;
+
 	destPerfStats[udtPerfStatsField::ThreadCount] += sourcePerfStats[udtPerfStatsField::ThreadCount];
 	destPerfStats[udtPerfStatsField::AllocatorCount] += sourcePerfStats[udtPerfStatsField::AllocatorCount];
 	destPerfStats[udtPerfStatsField::DataProcessed] += sourcePerfStats[udtPerfStatsField::DataProcessed];
@@ -651,6 +678,13 @@ UDT_API(s32) udtAddThreadPerfStats(u64* destPerfStats, const u64* sourcePerfStat
 	destPerfStats[udtPerfStatsField::MemoryEfficiency] = (destPerfStats[udtPerfStatsField::MemoryCommitted] > 0) ?
 		((1000 * destPerfStats[udtPerfStatsField::MemoryUsed]) / destPerfStats[udtPerfStatsField::MemoryCommitted]) : 0;
 
+	const u64 threadCount = destPerfStats[udtPerfStatsField::ThreadCount];
+	const u64 duration = destPerfStats[udtPerfStatsField::Duration];
+	destPerfStats[udtPerfStatsField::ThreadUtilization] = (threadCount > 0 && duration > 0) ?
+		((1000 * totalBusyTime) / (threadCount * duration)) : 0;
+	destPerfStats[udtPerfStatsField::MinThreadUtilization] = (duration > 0) ?
+		((1000 * minBusyTime) / duration) : 0;
+
 	return (s32)udtErrorCode::None;
 }
 
@@ -676,6 +710,8 @@ UDT_API(s32) udtInitLibrary()
 {
 	udtThreadLocalAllocators::Init();
 	BuildLookUpTables();
+	BuildHuffmanLookUpTables();
+	BuildServerCommandLookUpTable();
 
 	return (s32)udtErrorCode::None;
 }
@@ -823,30 +859,21 @@ UDT_API(s32) udtSplitDemoFile(udtParserContext* context, const udtParseArg* info
 		return (s32)udtErrorCode::OperationFailed;
 	}
 
-	if(!context->Parser.Init(&context->Context, protocol, protocol))
+	// We only need the game state offsets, so there's no need for a full parse.
+	udtGameStateScanner& scanner = context->GameStateScanner;
+	if(!scanner.Scan(file, protocol, info->CancelOperation))
 	{
 		return (s32)udtErrorCode::OperationFailed;
 	}
 
-	context->Parser.SetFilePath(demoFilePath);
-
-	// TODO: Move this to api_helpers.cpp and implement it the same way Cut by Pattern is?
-	udtParserPlugInSplitter plugIn;
-	plugIn.Init(1, context->PlugInTempAllocator);
-	context->Parser.AddPlugIn(&plugIn);
-	if(!RunParser(context->Parser, file, info->CancelOperation))
-	{
-		return (s32)udtErrorCode::OperationFailed;
-	}
-
-	if(plugIn.GamestateFileOffsets.GetSize() <= 1)
+	if(scanner.GameStateFileOffsets.GetSize() <= 1)
 	{
 		return (s32)udtErrorCode::None;
 	}
 
 	udtVMLinearAllocator& tempAllocator = context->Parser._tempAllocator;
 	tempAllocator.Clear();
-	if(!CreateDemoFileSplit(tempAllocator, context->Context, file, demoFilePath, info->OutputFolderPath, &plugIn.GamestateFileOffsets[0], plugIn.GamestateFileOffsets.GetSize()))
+	if(!CreateDemoFileSplit(tempAllocator, context->Context, file, demoFilePath, info->OutputFolderPath, &scanner.GameStateFileOffsets[0], scanner.GameStateFileOffsets.GetSize()))
 	{
 		return (s32)udtErrorCode::OperationFailed;
 	}
@@ -854,6 +881,45 @@ UDT_API(s32) udtSplitDemoFile(udtParserContext* context, const udtParseArg* info
 	return (s32)udtErrorCode::None;
 }
 
+static bool InitParserFromSeekIndex(udtParserContext* context, udtFileStream& file, const char* demoFilePath, udtProtocol::Id protocol, s32 gameStateIndex, s32 startTimeMs)
+{
+	udtSeekIndex& index = context->SeekIndex;
+	if(!index.Load(demoFilePath, (u32)file.Length(), protocol))
+	{
+		return false;
+	}
+
+	const s32 checkpointIndex = index.FindCheckpoint(gameStateIndex, startTimeMs);
+	if(checkpointIndex < 0)
+	{
+		return false;
+	}
+
+	// Make sure the demo wasn't modified since the index was written.
+	const udtSeekIndexCheckpoint& checkpoint = index.Checkpoints[checkpointIndex];
+	s32 messageSequence = 0;
+	if(file.Seek((s32)checkpoint.FileOffset, udtSeekOrigin::Start) != 0 ||
+	   file.Read(&messageSequence, 4, 1) != 1 ||
+	   messageSequence != checkpoint.MessageSequence ||
+	   file.Seek((s32)checkpoint.FileOffset, udtSeekOrigin::Start) != 0)
+	{
+		return false;
+	}
+
+	if(!context->Parser.Init(&context->Context, protocol, protocol, gameStateIndex))
+	{
+		return false;
+	}
+
+	udtMessage message;
+	message.InitContext(&context->Context);
+	message.InitProtocol(protocol);
+	message.Init(index.StateData.GetStartAddress() + checkpoint.DataOffset, (s32)checkpoint.DataByteCount);
+	message.Buffer.cursize = (s32)checkpoint.DataByteCount;
+
+	return context->Parser.RestoreCheckpoint(message);
+}
+
 UDT_API(s32) udtCutDemoFileByTime(udtParserContext* context, const udtParseArg* info, const udtCutByTimeArg* cutInfo, const char* demoFilePath)
 {
 	if(context == NULL || info == NULL || demoFilePath == NULL || cutInfo == NULL || 
@@ -892,14 +958,47 @@ UDT_API(s32) udtCutDemoFileByTime(udtParserContext* context, const udtParseArg*
 		return (s32)udtErrorCode::OperationFailed;
 	}
 
-	if(info->FileOffset > 0 && file.Seek((s32)info->FileOffset, udtSeekOrigin::Start) != 0)
+	s32 startTimeMs = UDT_S32_MAX;
+	for(u32 i = 0; i < cutInfo->CutCount; ++i)
 	{
-		return (s32)udtErrorCode::OperationFailed;
+		const udtCut& cut = cutInfo->Cuts[i];
+		if(cut.StartTimeMs < cut.EndTimeMs)
+		{
+			startTimeMs = udt_min(startTimeMs, cut.StartTimeMs);
+		}
 	}
 
-	if(!context->Parser.Init(&context->Context, protocol, protocol, info->GameStateIndex))
+	// Resume decoding from the last checkpoint before the first cut when there is a valid seek index.
+	if(!InitParserFromSeekIndex(context, file, demoFilePath, protocol, info->GameStateIndex, startTimeMs))
 	{
-		return (s32)udtErrorCode::OperationFailed;
+		u32 fileOffset = info->FileOffset;
+		if(fileOffset == 0 && info->GameStateIndex > 0)
+		{
+			if(file.Seek(0, udtSeekOrigin::Start) != 0)
+			{
+				return (s32)udtErrorCode::OperationFailed;
+			}
+
+			// Find where the game state starts without parsing the ones before it.
+			udtGameStateScanner& scanner = context->GameStateScanner;
+			if(!scanner.Scan(file, protocol, info->CancelOperation) ||
+			   (u32)info->GameStateIndex >= scanner.GameStateFileOffsets.GetSize())
+			{
+				return (s32)udtErrorCode::OperationFailed;
+			}
+
+			fileOffset = scanner.GameStateFileOffsets[info->GameStateIndex];
+		}
+
+		if(file.Seek((s32)fileOffset, udtSeekOrigin::Start) != 0)
+		{
+			return (s32)udtErrorCode::OperationFailed;
+		}
+
+		if(!context->Parser.Init(&context->Context, protocol, protocol, info->GameStateIndex))
+		{
+			return (s32)udtErrorCode::OperationFailed;
+		}
 	}
 
 	CallbackCutDemoFileStreamCreationInfo streamInfo;
@@ -1071,13 +1170,56 @@ static void DestroyContextGroup(udtParserContextGroup* contextGroup)
 	free(contextGroup);
 }
 
+// Splitting demos at game states is only supported by the jobs whose results can be merged back.
+static bool HasValidFlags(const udtMultiParseArg& arg, udtParsingJobType::Id jobType)
+{
+	return (arg.Flags & (u32)udtMultiParseArgFlag::SplitAtGameStates) == 0 || CanProcessDemoSegments(jobType);
+}
+
+static s32 RunJobWithThreadPool(udtParsingJobType::Id jobType, const udtParseArg* info, const udtMultiParseArg* extraInfo, const void* jobSpecificArg)
+{
+	udtThreadPool* const threadPool = extraInfo->ThreadPool;
+	if(!threadPool->BeginJob())
+	{
+		return (s32)udtErrorCode::OperationFailed;
+	}
+
+	udtTimer jobTimer;
+	jobTimer.Start();
+
+	s32 result;
+	udtDemoThreadAllocator threadAllocator;
+	if(threadAllocator.Process(*extraInfo, jobType))
+	{
+		udtMultiThreadedParsing parser;
+		const bool success = parser.Process(jobTimer, threadPool->Contexts, threadAllocator, info, extraInfo, jobType, jobSpecificArg);
+		result = GetErrorCode(success, info->CancelOperation);
+	}
+	else
+	{
+		// Not worth waking up the workers, but we can still reuse a context.
+		udtParserContext* const context = threadPool->Contexts;
+		context->ResetForNextDemo(false);
+		result = udtParseMultipleDemosSingleThread(jobType, context, info, extraInfo, jobSpecificArg);
+	}
+
+	threadPool->EndJob();
+
+	return result;
+}
+
 static s32 RunJobWithLocalContextGroup(udtParsingJobType::Id jobType, const udtParseArg* info, const udtMultiParseArg* extraInfo, const void* jobSpecificArg)
 {
+	if(extraInfo->ThreadPool != NULL)
+	{
+		return RunJobWithThreadPool(jobType, info, extraInfo, jobSpecificArg);
+	}
+
 	udtTimer jobTimer;
 	jobTimer.Start();
 
 	udtDemoThreadAllocator threadAllocator;
-	const bool threadJob = threadAllocator.Process(extraInfo->FilePaths, extraInfo->FileCount, extraInfo->MaxThreadCount);
+	const bool threadJob = threadAllocator.Process(*extraInfo, jobType);
 	if(!threadJob)
 	{
 		return udtParseMultipleDemosSingleThread(jobType, NULL, info, extraInfo, jobSpecificArg);
@@ -1109,10 +1251,49 @@ UDT_API(s32) udtDestroyContextGroup(udtParserContextGroup* contextGroup)
 	return (s32)udtErrorCode::None;
 }
 
+UDT_API(udtThreadPool*) udtCreateThreadPool(u32 threadCount)
+{
+	if(threadCount == 0)
+	{
+		return NULL;
+	}
+
+	// @NOTE: We don't use the standard operator new approach to avoid C++ exceptions.
+	udtThreadPool* const threadPool = (udtThreadPool*)malloc(sizeof(udtThreadPool));
+	if(threadPool == NULL)
+	{
+		return NULL;
+	}
+
+	new (threadPool) udtThreadPool;
+	if(!threadPool->Init(threadCount))
+	{
+		threadPool->~udtThreadPool();
+		free(threadPool);
+		return NULL;
+	}
+
+	return threadPool;
+}
+
+UDT_API(s32) udtDestroyThreadPool(udtThreadPool* threadPool)
+{
+	if(threadPool == NULL)
+	{
+		return (s32)udtErrorCode::InvalidArgument;
+	}
+
+	// @NOTE: We don't use the standard operator new approach to avoid C++ exceptions.
+	threadPool->~udtThreadPool();
+	free(threadPool);
+
+	return (s32)udtErrorCode::None;
+}
+
 UDT_API(s32) udtParseDemoFiles(udtParserContextGroup** contextGroup, const udtParseArg* info, const udtMultiParseArg* extraInfo)
 {
 	if(contextGroup == NULL || info == NULL || extraInfo == NULL ||
-	   !IsValid(*extraInfo) || !HasValidPlugInOptions(*info))
+	   !IsValid(*extraInfo) || !HasValidFlags(*extraInfo, udtParsingJobType::General) || !HasValidPlugInOptions(*info))
 	{
 		return (s32)udtErrorCode::InvalidArgument;
 	}
@@ -1121,7 +1302,7 @@ UDT_API(s32) udtParseDemoFiles(udtParserContextGroup** contextGroup, const udtPa
 	jobTimer.Start();
 
 	udtDemoThreadAllocator threadAllocator;
-	const bool threadJob = threadAllocator.Process(extraInfo->FilePaths, extraInfo->FileCount, extraInfo->MaxThreadCount);
+	const bool threadJob = threadAllocator.Process(*extraInfo, udtParsingJobType::General);
 	const u32 threadCount = threadJob ? threadAllocator.Threads.GetSize() : 1;
 	if(!CreateContextGroup(contextGroup, threadCount))
 	{
@@ -1133,10 +1314,22 @@ UDT_API(s32) udtParseDemoFiles(udtParserContextGroup** contextGroup, const udtPa
 	{
 		return udtParseMultipleDemosSingleThread(udtParsingJobType::General, (*contextGroup)->Contexts, info, extraInfo, NULL);
 	}
+
+	// The context group is handed over to the user, so only the pool's threads get used.
+	udtThreadPool* const threadPool = extraInfo->ThreadPool;
+	if(threadPool != NULL && !threadPool->BeginJob())
+	{
+		return (s32)udtErrorCode::OperationFailed;
+	}
 	
 	udtMultiThreadedParsing parser;
 	const bool success = parser.Process(jobTimer, (*contextGroup)->Contexts, threadAllocator, info, extraInfo, udtParsingJobType::General, NULL);
 
+	if(threadPool != NULL)
+	{
+		threadPool->EndJob();
+	}
+
 	return GetErrorCode(success, info->CancelOperation);
 }
 
@@ -1205,7 +1398,7 @@ UDT_API(s32) udtDestroySearchContext(udtPatternSearchContext* context)
 UDT_API(s32) udtConvertDemoFiles(const udtParseArg* info, const udtMultiParseArg* extraInfo, const udtProtocolConversionArg* conversionArg)
 {
 	if(info == NULL || extraInfo == NULL || conversionArg == NULL ||
-	   !IsValid(*extraInfo) || !HasValidOutputOption(*info) || !IsValid(*conversionArg))
+	   !IsValid(*extraInfo) || !HasValidFlags(*extraInfo, udtParsingJobType::Conversion) || !HasValidOutputOption(*info) || !IsValid(*conversionArg))
 	{
 		return (s32)udtErrorCode::InvalidArgument;
 	}
@@ -1216,7 +1409,7 @@ UDT_API(s32) udtConvertDemoFiles(const udtParseArg* info, const udtMultiParseArg
 UDT_API(s32) udtTimeShiftDemoFiles(const udtParseArg* info, const udtMultiParseArg* extraInfo, const udtTimeShiftArg* timeShiftArg)
 {
 	if(info == NULL || extraInfo == NULL || timeShiftArg == NULL ||
-	   !IsValid(*extraInfo) || !HasValidOutputOption(*info))
+	   !IsValid(*extraInfo) || !HasValidFlags(*extraInfo, udtParsingJobType::TimeShift) || !HasValidOutputOption(*info))
 	{
 		return (s32)udtErrorCode::InvalidArgument;
 	}
@@ -1227,7 +1420,7 @@ UDT_API(s32) udtTimeShiftDemoFiles(const udtParseArg* info, const udtMultiParseA
 UDT_API(s32) udtSaveDemoFilesAnalysisDataToJSON(const udtParseArg* info, const udtMultiParseArg* extraInfo, const udtJSONArg* jsonInfo)
 {
 	if(info == NULL || extraInfo == NULL || jsonInfo == NULL ||
-	   !IsValid(*extraInfo) || !HasValidOutputOption(*info) || !HasValidPlugInOptions(*info))
+	   !IsValid(*extraInfo) || !HasValidFlags(*extraInfo, udtParsingJobType::ExportToJSON) || !HasValidOutputOption(*info) || !HasValidPlugInOptions(*info))
 	{
 		return (s32)udtErrorCode::InvalidArgument;
 	}
@@ -1364,13 +1557,16 @@ UDT_API(s32) udtCuStartParsing(udtCuContext* context, u32 protocol)
 UDT_API(s32) udtCuParseMessage(udtCuContext* context, udtCuMessageOutput* messageOutput, u32* continueParsing, const udtCuMessageInput* messageInput)
 {
 	if(context == NULL || messageOutput == NULL || continueParsing == NULL || messageInput == NULL ||
-	   messageInput->Buffer == NULL || messageInput->BufferByteCount == 0)
+	   messageInput->Buffer == NULL || messageInput->BufferByteCount == 0 ||
+	   messageInput->BufferByteCount > (u32)ID_MAX_MSG_LENGTH)
 	{
 		return (s32)udtErrorCode::InvalidArgument;
 	}
 
+	memcpy(context->InMessageData, messageInput->Buffer, (size_t)messageInput->BufferByteCount);
+	memset(context->InMessageData + messageInput->BufferByteCount, 0, UDT_MESSAGE_READ_PADDING);
 	udtMessage& message = context->InMessage;
-	message.Init((u8*)messageInput->Buffer, ID_MAX_MSG_LENGTH);
+	message.Init(context->InMessageData, ID_MAX_MSG_LENGTH);
 	message.Buffer.cursize = (s32)messageInput->BufferByteCount;
 	context->Context.Parser.PlugIns.Clear();
 	context->Context.Parser.PlugIns.Add(&context->PlugIn);
@@ -1424,6 +1620,77 @@ UDT_API(s32) udtCuGetEntityState(udtCuContext* context, idEntityStateBase** enti
 	return GetEntity(context, entityState, entityIndex, false);
 }
 
+UDT_API(s32) udtCuSaveCheckpoint(udtCuContext* context, const void** checkpointData, u32* checkpointByteCount)
+{
+	if(context == NULL || checkpointData == NULL || checkpointByteCount == NULL)
+	{
+		return (s32)udtErrorCode::InvalidArgument;
+	}
+
+	// Entity and player states are delta-encoded, which isn't supported by read-only protocols.
+	udtBaseParser& parser = context->Context.Parser;
+	if(udtIsProtocolWriteSupported((u32)parser._inProtocol) == 0)
+	{
+		return (s32)udtErrorCode::UnsupportedProtocol;
+	}
+
+	udtVMArray<u8>& data = context->CheckpointData;
+	data.Resize(UDT_PARSER_MAX_CHECKPOINT_BYTE_COUNT);
+
+	udtMessage message;
+	message.InitContext(&context->Context.Context);
+	message.InitProtocol(parser._inProtocol);
+	message.Init(data.GetStartAddress(), (s32)data.GetSize());
+	if(!parser.SaveCheckpoint(message))
+	{
+		return (s32)udtErrorCode::OperationFailed;
+	}
+
+	*checkpointData = data.GetStartAddress();
+	*checkpointByteCount = (u32)((message.Buffer.bit + 7) >> 3);
+
+	return (s32)udtErrorCode::None;
+}
+
+UDT_API(s32) udtCuStartParsingFromCheckpoint(udtCuContext* context, u32 protocol, const void* checkpointData, u32 checkpointByteCount)
+{
+	if(context == NULL || checkpointData == NULL || checkpointByteCount == 0 || 
+	   checkpointByteCount > (u32)UDT_PARSER_MAX_CHECKPOINT_BYTE_COUNT || udtIsValidProtocol(protocol) == 0)
+	{
+		return (s32)udtErrorCode::InvalidArgument;
+	}
+
+	if(udtIsProtocolWriteSupported(protocol) == 0)
+	{
+		return (s32)udtErrorCode::UnsupportedProtocol;
+	}
+
+	const s32 result = udtCuStartParsing(context, protocol);
+	if(result != (s32)udtErrorCode::None)
+	{
+		return result;
+	}
+
+	// The copy adds the padding needed for reading.
+	// checkpointData can point to our own buffer if it came from udtCuSaveCheckpoint.
+	udtVMArray<u8>& data = context->CheckpointData;
+	data.Resize(checkpointByteCount + UDT_MESSAGE_READ_PADDING);
+	memmove(data.GetStartAddress(), checkpointData, (size_t)checkpointByteCount);
+	memset(data.GetStartAddress() + checkpointByteCount, 0, (size_t)UDT_MESSAGE_READ_PADDING);
+
+	udtMessage message;
+	message.InitContext(&context->Context.Context);
+	message.InitProtocol((udtProtocol::Id)protocol);
+	message.Init(data.GetStartAddress(), (s32)checkpointByteCount);
+	message.Buffer.cursize = (s32)checkpointByteCount;
+	if(!context->Context.Parser.RestoreCheckpoint(message))
+	{
+		return (s32)udtErrorCode::OperationFailed;
+	}
+
+	return (s32)udtErrorCode::None;
+}
+
 UDT_API(s32) udtCuDestroyContext(udtCuContext* context)
 {
 	if(context == NULL)
@@ -114,7 +114,8 @@ bool InitContextWithPlugIns(udtParserContext& context, const udtParseArg& info,
 	return false;
 }
 
-static bool ParseDemoFile(udtProtocol::Id protocol, udtParserContext* context, const udtParseArg* info, const char* demoFilePath, bool clearPlugInData)
+// The flags are of type udtParseArgFlag::Id.
+static bool ParseDemoFile(udtProtocol::Id protocol, udtParserContext* context, const udtParseArg* info, const char* demoFilePath, bool clearPlugInData, u32 parseFlags)
 {
 	context->ResetForNextDemo(!clearPlugInData);
 	if(!context->Context.SetCallbacks(info->MessageCb, info->ProgressCb, info->ProgressContext))
@@ -122,15 +123,99 @@ static bool ParseDemoFile(udtProtocol::Id protocol, udtParserContext* context, c
 		return false;
 	}
 
-	UDT_INIT_DEMO_FILE_READER(file, demoFilePath, context);
+	UDT_INIT_MAPPED_DEMO_FILE_READER(file, demoFilePath, context);
 
-	if(!context->Parser.Init(&context->Context, protocol, protocol))
+	const bool firstGameStateOnly = (parseFlags & (u32)udtParseArgFlag::FirstGameStateOnly) != 0;
+	const bool firstMatchOnly = (parseFlags & (u32)udtParseArgFlag::FirstMatchOnly) != 0;
+	const bool timeWindow = (parseFlags & (u32)udtParseArgFlag::TimeWindow) != 0;
+	const bool writeSeekIndex =
+		(parseFlags & (u32)udtParseArgFlag::WriteSeekIndex) != 0 &&
+		!AreAllProtocolFlagsSet(protocol, udtProtocolFlags::ReadOnly) &&
+		!firstGameStateOnly &&
+		!timeWindow;
+	if(timeWindow)
+	{
+		const s32 gameStateIndex = udt_max(info->GameStateIndex, (s32)0);
+		if(gameStateIndex > 0)
+		{
+			// Find where the game state starts without parsing the ones before it.
+			udtGameStateScanner& scanner = context->GameStateScanner;
+			if(!scanner.Scan(file, protocol, info->CancelOperation) ||
+			   (u32)gameStateIndex >= scanner.GameStateFileOffsets.GetSize() ||
+			   file.Seek((s32)scanner.GameStateFileOffsets[gameStateIndex], udtSeekOrigin::Start) != 0)
+			{
+				return false;
+			}
+		}
+
+		if(!context->Parser.Init(&context->Context, protocol, protocol, gameStateIndex))
+		{
+			return false;
+		}
+
+		context->Parser.SetFilePath(demoFilePath);
+		context->Parser.FirstGameStateOnly = firstGameStateOnly;
+		context->Parser.FirstMatchOnly = firstMatchOnly;
+		context->Parser.TimeWindowEnabled = true;
+		context->Parser.TimeWindowStartMs = info->StartTimeMs;
+		context->Parser.TimeWindowEndMs = info->EndTimeMs;
+
+		return RunParser(context->Parser, file, info->CancelOperation);
+	}
+
+	if(!writeSeekIndex)
+	{
+		if(!context->Parser.Init(&context->Context, protocol, protocol))
+		{
+			return false;
+		}
+
+		context->Parser.SetFilePath(demoFilePath);
+		context->Parser.FirstGameStateOnly = firstGameStateOnly;
+		context->Parser.FirstMatchOnly = firstMatchOnly;
+
+		return RunParser(context->Parser, file, info->CancelOperation);
+	}
+
+	// The writer is only added for this demo.
+	udtSeekIndexWriter& seekIndexWriter = context->SeekIndexWriter;
+	seekIndexWriter.Init(1, context->PlugInTempAllocator);
+	context->Parser.AddPlugIn(&seekIndexWriter);
+	bool success = context->Parser.Init(&context->Context, protocol, protocol);
+	if(success)
+	{
+		context->Parser.SetFilePath(demoFilePath);
+		context->Parser.FirstMatchOnly = firstMatchOnly; // The seek index writer is never done.
+		success = RunParser(context->Parser, file, info->CancelOperation);
+	}
+	context->Parser.RemovePlugIn(&seekIndexWriter);
+	if(!success)
+	{
+		return false;
+	}
+
+	seekIndexWriter.Index.Save(demoFilePath, (u32)file.Length(), protocol);
+
+	return true;
+}
+
+static bool ParseDemoSegment(udtProtocol::Id protocol, udtParserContext* context, const udtParseArg* info, const char* demoFilePath, const udtDemoSegment& segment)
+{
+	context->ResetForNextDemo(true);
+	if(!context->Context.SetCallbacks(info->MessageCb, info->ProgressCb, info->ProgressContext))
+	{
+		return false;
+	}
+
+	UDT_INIT_DEMO_FILE_READER_AT(file, demoFilePath, context, segment.StartOffset);
+
+	if(!context->Parser.Init(&context->Context, protocol, protocol, segment.GameStateIndex))
 	{
 		return false;
 	}
 
 	context->Parser.SetFilePath(demoFilePath);
-	if(!RunParser(context->Parser, file, info->CancelOperation))
+	if(!RunParser(context->Parser, file, info->CancelOperation, segment.EndOffset))
 	{
 		return false;
 	}
@@ -146,18 +231,47 @@ static bool ParseDemoFile(udtParserContext* context, const udtParseArg* info, co
 		return false;
 	}
 
-	return ParseDemoFile(protocol, context, info, demoFilePath, clearPlugInData);
+	return ParseDemoFile(protocol, context, info, demoFilePath, clearPlugInData, info->Flags);
 }
 
-static bool CutByPattern(udtParserContext* context, const udtParseArg* info, const char* demoFilePath)
+// Analyzes the demo and writes the cuts it finds in the same pass.
+// If wroteAllCuts is false, the plug-in's cut sections still need to be written.
+static bool CutByPatternSinglePass(udtProtocol::Id protocol, udtParserContext* context, const udtParseArg* info, const char* demoFilePath, const udtDemoSegment* segment, udtPatternSearchPlugIn& plugIn, CallbackCutDemoFileStreamCreationInfo& cutCbInfo, bool& wroteAllCuts)
 {
-	const udtProtocol::Id protocol = (udtProtocol::Id)udtGetProtocolByFilePath(demoFilePath);
-	if(protocol == udtProtocol::Invalid)
+	context->ResetForNextDemo(true);
+	if(!context->Context.SetCallbacks(info->MessageCb, info->ProgressCb, info->ProgressContext))
 	{
 		return false;
 	}
 
-	if(!ParseDemoFile(protocol, context, info, demoFilePath, false))
+	const s32 gsIndex = segment != NULL ? segment->GameStateIndex : 0;
+	const u32 fileOffset = segment != NULL ? segment->StartOffset : 0;
+	const u32 fileEndOffset = segment != NULL ? segment->EndOffset : 0;
+	UDT_INIT_DEMO_FILE_READER_AT(file, demoFilePath, context, fileOffset);
+
+	if(!context->Parser.Init(&context->Context, protocol, protocol, gsIndex))
+	{
+		return false;
+	}
+
+	context->Parser.SetFilePath(demoFilePath);
+
+	udtSinglePassCutter& cutter = context->SinglePassCutter;
+	if(!cutter.Init(&context->Context, plugIn, protocol, demoFilePath, gsIndex, &CallbackCutDemoFileNameCreation, &cutCbInfo) ||
+	   !cutter.Run(context->Parser, file, info->CancelOperation, fileEndOffset))
+	{
+		return false;
+	}
+
+	wroteAllCuts = cutter.WroteAllCuts();
+
+	return true;
+}
+
+static bool CutByPattern(udtParserContext* context, const udtParseArg* info, const char* demoFilePath, const udtDemoSegment* segment)
+{
+	const udtProtocol::Id protocol = (udtProtocol::Id)udtGetProtocolByFilePath(demoFilePath);
+	if(protocol == udtProtocol::Invalid)
 	{
 		return false;
 	}
@@ -166,6 +280,33 @@ static bool CutByPattern(udtParserContext* context, const udtParseArg* info, con
 	context->GetPlugInById(plugInBase, udtPrivateParserPlugIn::FindPatterns);
 	udtPatternSearchPlugIn& plugIn = *(udtPatternSearchPlugIn*)plugInBase;
 
+	CallbackCutDemoFileStreamCreationInfo cutCbInfo;
+	cutCbInfo.OutputFolderPath = info->OutputFolderPath;
+
+	if((plugIn.GetInfo().Flags & (u32)udtPatternSearchArgMask::SinglePass) != 0)
+	{
+		bool wroteAllCuts = false;
+		if(!CutByPatternSinglePass(protocol, context, info, demoFilePath, segment, plugIn, cutCbInfo, wroteAllCuts))
+		{
+			return false;
+		}
+
+		if(wroteAllCuts)
+		{
+			return true;
+		}
+	}
+	else
+	{
+		const bool parsed = segment != NULL ?
+			ParseDemoSegment(protocol, context, info, demoFilePath, *segment) :
+			ParseDemoFile(protocol, context, info, demoFilePath, false, 0);
+		if(!parsed)
+		{
+			return false;
+		}
+	}
+
 	if(plugIn.CutSections.IsEmpty())
 	{
 		return true;
@@ -178,7 +319,8 @@ static bool CutByPattern(udtParserContext* context, const udtParseArg* info, con
 	}
 
 	const s32 gsIndex = plugIn.CutSections[0].GameStateIndex;
-	const u32 fileOffset = context->Parser._inGameStateFileOffsets[gsIndex];
+	const u32 fileOffset = segment != NULL ? segment->StartOffset : context->Parser._inGameStateFileOffsets[gsIndex];
+	const u32 fileEndOffset = segment != NULL ? segment->EndOffset : 0;
 	UDT_INIT_DEMO_FILE_READER_AT(file, demoFilePath, context, fileOffset);
 
 	// Save the cut sections in a temporary array.
@@ -196,9 +338,6 @@ static bool CutByPattern(udtParserContext* context, const udtParseArg* info, con
 
 	context->Parser.SetFilePath(demoFilePath);
 
-	CallbackCutDemoFileStreamCreationInfo cutCbInfo;
-	cutCbInfo.OutputFolderPath = info->OutputFolderPath;
-
 	for(u32 i = 0, count = sections.GetSize(); i < count; ++i)
 	{
 		const udtCutSection& section = sections[i];
@@ -210,13 +349,13 @@ static bool CutByPattern(udtParserContext* context, const udtParseArg* info, con
 	context->Context.LogInfo("Processing demo for applying cut(s): %s", demoFilePath);
 
 	context->Context.SetCallbacks(info->MessageCb, NULL, NULL);
-	const bool result = RunParser(context->Parser, file, info->CancelOperation);
+	const bool result = RunParser(context->Parser, file, info->CancelOperation, fileEndOffset);
 	context->Context.SetCallbacks(info->MessageCb, info->ProgressCb, info->ProgressContext);
 
 	return result;
 }
 
-static bool FindPatterns(udtParserContext* context, u32 demoIndex, const udtParseArg* info, const char* demoFilePath, udtPatternSearchContext* searchContext)
+static bool FindPatterns(udtParserContext* context, u32 demoIndex, const udtParseArg* info, const char* demoFilePath, udtPatternSearchContext* searchContext, const udtDemoSegment* segment)
 {
 	const udtProtocol::Id protocol = (udtProtocol::Id)udtGetProtocolByFilePath(demoFilePath);
 	if(protocol == udtProtocol::Invalid)
@@ -224,7 +363,10 @@ static bool FindPatterns(udtParserContext* context, u32 demoIndex, const udtPars
 		return false;
 	}
 
-	if(!ParseDemoFile(protocol, context, info, demoFilePath, false))
+	const bool parsed = segment != NULL ?
+		ParseDemoSegment(protocol, context, info, demoFilePath, *segment) :
+		ParseDemoFile(protocol, context, info, demoFilePath, false, 0);
+	if(!parsed)
 	{
 		return false;
 	}
@@ -488,15 +630,20 @@ static bool ExportToJSON(udtParserContext* context, u32 demoIndex, const udtPars
 	return true;
 }
 
-bool ProcessSingleDemoFile(udtParsingJobType::Id jobType, udtParserContext* context, u32 contextDemoIndex, u32 inputDemoIndex, const udtParseArg* info, const char* demoFilePath, const void* jobSpecificInfo)
+bool ProcessSingleDemoFile(udtParsingJobType::Id jobType, udtParserContext* context, u32 contextDemoIndex, u32 inputDemoIndex, const udtParseArg* info, const char* demoFilePath, const void* jobSpecificInfo, const udtDemoSegment* segment)
 {
+	if(segment != NULL && !CanProcessDemoSegments(jobType))
+	{
+		return false;
+	}
+
 	switch(jobType)
 	{
 		case udtParsingJobType::General:
 			return ParseDemoFile(context, info, demoFilePath, false);
 
 		case udtParsingJobType::CutByPattern:
-			return CutByPattern(context, info, demoFilePath);
+			return CutByPattern(context, info, demoFilePath, segment);
 
 		case udtParsingJobType::Conversion:
 			return ConvertDemoFile(context, info, demoFilePath, (const udtProtocolConversionArg*)jobSpecificInfo);
@@ -508,13 +655,22 @@ bool ProcessSingleDemoFile(udtParsingJobType::Id jobType, udtParserContext* cont
 			return ExportToJSON(context, contextDemoIndex, info, demoFilePath, (const udtJSONArg*)jobSpecificInfo);
 
 		case udtParsingJobType::FindPatterns:
-			return FindPatterns(context, inputDemoIndex, info, demoFilePath, (udtPatternSearchContext*)jobSpecificInfo);
+			return FindPatterns(context, inputDemoIndex, info, demoFilePath, (udtPatternSearchContext*)jobSpecificInfo, segment);
 
 		default:
 			return false;
 	}
 }
 
+bool CanProcessDemoSegments(udtParsingJobType::Id jobType)
+{
+	// The plug-in data of the other jobs can't be merged back 
+	// and conversions/time shifts need to write a single output file.
+	return 
+		jobType == udtParsingJobType::CutByPattern ||
+		jobType == udtParsingJobType::FindPatterns;
+}
+
 void SingleThreadProgressCallback(f32 jobProgress, void* userData)
 {
 	SingleThreadProgressContext* const context = (SingleThreadProgressContext*)userData;
@@ -21,6 +21,14 @@ struct udtParsingJobType
 
 struct udtTimer;
 
+// A part of a demo file that starts with a game state message.
+struct udtDemoSegment
+{
+	u32 StartOffset; // File offset of the game state message.
+	u32 EndOffset; // File offset of the next game state message or 0 to read until the end.
+	s32 GameStateIndex;
+};
+
 struct SingleThreadProgressContext
 {
 	u64 TotalByteCount;
@@ -34,6 +42,7 @@ struct SingleThreadProgressContext
 
 extern void SingleThreadProgressCallback(f32 jobProgress, void* userData);
 extern bool InitContextWithPlugIns(udtParserContext& context, const udtParseArg& info, u32 demoCount, udtParsingJobType::Id jobType, const void* jobSpecificInfo = NULL);
-extern bool ProcessSingleDemoFile(udtParsingJobType::Id jobType, udtParserContext* context, u32 contextDemoIndex, u32 inputDemoIndex, const udtParseArg* info, const char* demoFilePath, const void* jobSpecificInfo);
+extern bool ProcessSingleDemoFile(udtParsingJobType::Id jobType, udtParserContext* context, u32 contextDemoIndex, u32 inputDemoIndex, const udtParseArg* info, const char* demoFilePath, const void* jobSpecificInfo, const udtDemoSegment* segment = NULL);
+extern bool CanProcessDemoSegments(udtParsingJobType::Id jobType);
 extern bool MergeDemosNoInputCheck(const udtParseArg* info, const char** filePaths, u32 fileCount, udtProtocol::Id protocol);
 extern s32  udtParseMultipleDemosSingleThread(udtParsingJobType::Id jobType, udtParserContext* context, const udtParseArg* info, const udtMultiParseArg* extraInfo, const void* jobSpecificInfo);
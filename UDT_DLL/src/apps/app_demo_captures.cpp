@@ -462,7 +462,7 @@ int udt_main(int argc, char** argv)
 				arg.GetLength() >= 4 &&
 				StringParseInt(localMaxThreads, arg.GetPtr() + 3) &&
 				localMaxThreads >= 1 &&
-				localMaxThreads <= 16)
+				localMaxThreads <= 256)
 		{
 			maxThreadCount = (u32)localMaxThreads;
 		}
@@ -186,7 +186,7 @@ int udt_main(int argc, char** argv)
 				arg.GetLength() >= 4 &&
 				StringParseInt(localMaxThreads, arg.GetPtr() + 3) &&
 				localMaxThreads >= 1 &&
-				localMaxThreads <= 16)
+				localMaxThreads <= 256)
 		{
 			config.MaxThreadCount = (u32)localMaxThreads;
 		}
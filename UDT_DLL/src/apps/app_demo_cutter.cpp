@@ -21,8 +21,8 @@ void PrintHelp()
 	printf("Cuts demos by time, chat or matches.\n");
 	printf("\n");
 	printf("UDT_cutter t [-o=outputfolder] [-q] [-g=gamestateindex] -s=starttime -e=endtime inputfile\n");
-	printf("UDT_cutter c [-o=outputfolder] [-q] [-t=maxthreads] [-r] -c=configpath inputfile|inputfolder\n");
-	printf("UDT_cutter m [-o=outputfolder] [-q] [-t=maxthreads] [-r] [-s=startoffset] [-e=endoffset] inputfile|inputfolder\n");
+	printf("UDT_cutter c [-o=outputfolder] [-q] [-t=maxthreads] [-p] [-r] [-1] -c=configpath inputfile|inputfolder\n");
+	printf("UDT_cutter m [-o=outputfolder] [-q] [-t=maxthreads] [-p] [-r] [-s=startoffset] [-e=endoffset] inputfile|inputfolder\n");
 	printf("UDT_cutter g -c=configpath\n");
 	printf("\n");
 	printf("t     cut by time\n");
@@ -31,6 +31,8 @@ void PrintHelp()
 	printf("g     generate a cut by chat example config\n");
 	printf("-q    quiet mode: no logging to stdout    (default: off)\n");
 	printf("-r    enable recursive demo file search   (default: off)\n");
+	printf("-p    process game states in parallel     (default: off)\n");
+	printf("-1    cut while searching for chat        (default: off)\n");
 	printf("-o=p  set the output folder path to p     (default: input folder)\n");
 	printf("-g=N  set the game state index to N       (default: 0)\n");
 	printf("-t=N  set the maximum thread count to N   (default: 1)\n");
@@ -78,6 +80,8 @@ struct CutByChatConfig
 	int MaxThreadCount = 1;
 	int StartOffsetSec = 10;
 	int EndOffsetSec = 10;
+	bool SplitAtGameStates = false;
+	bool SinglePass = false;
 };
 
 
@@ -229,13 +233,14 @@ static bool LoadConfig(CutByChatConfig& config, const char* configPath)
 	return true;
 }
 
-static bool CutByTime(const char* filePath, const char* outputFolder, s32 startSec, s32 endSec)
+static bool CutByTime(const char* filePath, const char* outputFolder, u32 gameStateIndex, s32 startSec, s32 endSec)
 {
 	udtParseArg info;
 	memset(&info, 0, sizeof(info));
 	info.MessageCb = &CallbackConsoleMessage;
 	info.ProgressCb = &CallbackConsoleProgress;
 	info.OutputFolderPath = outputFolder;
+	info.GameStateIndex = (s32)gameStateIndex; // The file offset gets looked up by the library.
 	
 	udtCut cut;
 	memset(&cut, 0, sizeof(cut));
@@ -282,6 +287,7 @@ static bool CutByChatBatch(udtParseArg& parseArg, const udtFileInfo* files, cons
 	threadInfo.OutputErrorCodes = errorCodes.GetStartAddress();
 	threadInfo.FileCount = fileCount;
 	threadInfo.MaxThreadCount = (u32)config.MaxThreadCount;
+	threadInfo.Flags = config.SplitAtGameStates ? (u32)udtMultiParseArgFlag::SplitAtGameStates : 0;
 
 	udtChatPatternArg chatInfo;
 	memset(&chatInfo, 0, sizeof(chatInfo));
@@ -299,6 +305,7 @@ static bool CutByChatBatch(udtParseArg& parseArg, const udtFileInfo* files, cons
 	patternArg.EndOffsetSec = (u32)config.EndOffsetSec;
 	patternArg.PatternCount = 1;
 	patternArg.Patterns = &patternInfo;
+	patternArg.Flags = config.SinglePass ? (u32)udtPatternSearchArgMask::SinglePass : 0;
 
 	const s32 result = udtCutDemoFilesByPattern(&parseArg, &threadInfo, &patternArg);
 
@@ -360,6 +367,7 @@ struct CutByMatchConfig
 	s32 StartOffsetSec;
 	s32 EndOffsetSec;
 	u32 MaxThreadCount;
+	bool SplitAtGameStates;
 };
 
 static bool CutByMatchBatch(udtParseArg& parseArg, const udtFileInfo* files, const u32 fileCount, const CutByMatchConfig& config)
@@ -379,6 +387,7 @@ static bool CutByMatchBatch(udtParseArg& parseArg, const udtFileInfo* files, con
 	threadInfo.OutputErrorCodes = errorCodes.GetStartAddress();
 	threadInfo.FileCount = fileCount;
 	threadInfo.MaxThreadCount = config.MaxThreadCount;
+	threadInfo.Flags = config.SplitAtGameStates ? (u32)udtMultiParseArgFlag::SplitAtGameStates : 0;
 
 	udtMatchPatternArg matchInfo;
 	memset(&matchInfo, 0, sizeof(matchInfo));
@@ -505,6 +514,8 @@ struct ProgramOptions
 	s32 StartTimeSec = UDT_S32_MIN; // -s=
 	s32 EndTimeSec = UDT_S32_MIN; // -e=
 	bool Recursive = false;	 // -r
+	bool SplitAtGameStates = false; // -p
+	bool SinglePass = false; // -1
 };
 
 static bool LoadChatConfig(CutByChatConfig& config, const ProgramOptions& options)
@@ -517,6 +528,8 @@ static bool LoadChatConfig(CutByChatConfig& config, const ProgramOptions& option
 
 	config.CustomOutputFolder = options.OutputFolderPath;
 	config.MaxThreadCount = (int)options.MaxThreadCount;
+	config.SplitAtGameStates = options.SplitAtGameStates;
+	config.SinglePass = options.SinglePass;
 	if(options.StartTimeSec > 0) config.StartOffsetSec = (int)options.StartTimeSec;
 	if(options.EndTimeSec > 0) config.EndOffsetSec = (int)options.EndTimeSec;
 
@@ -527,6 +540,7 @@ static void LoadMatchConfig(CutByMatchConfig& config, const ProgramOptions& opti
 {
 	config.CustomOutputFolder = options.OutputFolderPath;
 	config.MaxThreadCount = options.MaxThreadCount;
+	config.SplitAtGameStates = options.SplitAtGameStates;
 	if(options.StartTimeSec > 0) config.StartOffsetSec = options.StartTimeSec;
 	if(options.EndTimeSec > 0) config.EndOffsetSec = options.EndTimeSec;
 }
@@ -573,6 +587,14 @@ int udt_main(int argc, char** argv)
 		{
 			options.Recursive = true;
 		}
+		else if(udtString::Equals(arg, "-p"))
+		{
+			options.SplitAtGameStates = true;
+		}
+		else if(udtString::Equals(arg, "-1"))
+		{
+			options.SinglePass = true;
+		}
 		else if(udtString::StartsWith(arg, "-c=") &&
 				arg.GetLength() >= 4)
 		{
@@ -587,7 +609,7 @@ int udt_main(int argc, char** argv)
 				arg.GetLength() >= 4 &&
 				StringParseInt(localInt, arg.GetPtr() + 3) &&
 				localInt >= 1 &&
-				localInt <= 16)
+				localInt <= 256)
 		{
 			options.MaxThreadCount = (u32)localInt;
 		}
@@ -655,7 +677,7 @@ int udt_main(int argc, char** argv)
 			return 1;
 		}
 
-		return CutByTime(inputPath, options.OutputFolderPath, options.StartTimeSec, options.EndTimeSec) ? 0 : 1;
+		return CutByTime(inputPath, options.OutputFolderPath, options.GameStateIndex, options.StartTimeSec, options.EndTimeSec) ? 0 : 1;
 	}
 
 	if(command == 'c' && options.ConfigFilePath == NULL)
@@ -16,12 +16,18 @@ void PrintHelp()
 {
 	printf("For each input demo, outputs JSON data with analysis results to one file per demo or optionally to the terminal.\n");
 	printf("\n");
-	printf("UDT_json [-c] [-r] [-q] [-t=maxthreads] [-a=analyzers] [-o=outputfolder] inputfile|inputfolder\n");
+	printf("UDT_json [-c] [-r] [-q] [-i] [-g] [-m] [-n=gamestate] [-s=start] [-e=end] [-t=maxthreads] [-a=analyzers] [-o=outputfolder] inputfile|inputfolder\n");
 	printf("\n");
 	printf("-q    quiet mode: no logging to stdout        (default: off)\n");
 	printf("-o=p  set the output folder path to p         (default: the input's folder)\n");
 	printf("-c    output to the console/terminal          (default: off)\n");
 	printf("-r    enable recursive demo file search       (default: off)\n");
+	printf("-i    write seek index files for fast cuts    (default: off)\n");
+	printf("-g    only read up to the first game state    (default: off)\n");
+	printf("-m    only analyze the first match            (default: off)\n");
+	printf("-n=N  only analyze the game state at index N  (default: all game states)\n");
+	printf("-s=T  start analysis at server time T         (default: game state start)\n");
+	printf("-e=T  stop analysis at server time T          (default: game state end)\n");
 	printf("-t=N  set the maximum number of threads to N  (default: 1)\n");
 	printf("-a=   select analyzers                        (default: all enabled)\n");
 	printf("        g: Game states         s: Stats\n");
@@ -34,6 +40,14 @@ void PrintHelp()
 	printf("still be active, so make sure you only read the stdout output from your programs and scripts.\n");
 	printf("\n");
 	printf("Example for selecting analyzers: -a=sd will select stats and deaths.\n");
+	printf("\n");
+	printf("The header scan option -g only selects the game states analyzer and reads no snapshot: ");
+	printf("it's much faster but only the first game state is output and the match and time information is missing.\n");
+	printf("With -m, the game states and stats analyzers stop after the first match of each demo. ");
+	printf("Reading a demo stops early only when all selected analyzers are done: use e.g. -m -a=gs.\n");
+	printf("\n");
+	printf("Any of the -n, -s and -e options restricts the analysis to a single game state (the first one by default). ");
+	printf("The times are server times in the format 'seconds' or 'minutes:seconds' and parsing stops at the end time.\n");
 }
 
 static bool KeepOnlyDemoFiles(const char* name, u64 /*size*/, void* /*userData*/)
@@ -117,13 +131,17 @@ static bool ProcessBatch(udtParseArg& parseArg, const udtFileInfo* files, u32 fi
 	return false;
 }
 
-static bool ProcessMultipleDemos(const udtFileInfo* files, u32 fileCount, const char* customOutputFolder, bool consoleOutput, u32 maxThreadCount, const u32* plugInIds, u32 plugInCount)
+static bool ProcessMultipleDemos(const udtFileInfo* files, u32 fileCount, const char* customOutputFolder, bool consoleOutput, u32 parseFlags, s32 gameStateIndex, s32 startTimeMs, s32 endTimeMs, u32 maxThreadCount, const u32* plugInIds, u32 plugInCount)
 {
 	CmdLineParseArg cmdLineParseArg;
 	udtParseArg& parseArg = cmdLineParseArg.ParseArg;
 	parseArg.PlugIns = plugInIds;
 	parseArg.PlugInCount = plugInCount;
 	parseArg.OutputFolderPath = customOutputFolder;
+	parseArg.Flags = parseFlags;
+	parseArg.GameStateIndex = gameStateIndex;
+	parseArg.StartTimeMs = startTimeMs;
+	parseArg.EndTimeMs = endTimeMs;
 
 	BatchRunner runner(parseArg, files, fileCount, UDT_JSON_BATCH_SIZE);
 	const u32 batchCount = runner.GetBatchCount();
@@ -166,6 +184,13 @@ int udt_main(int argc, char** argv)
 	u32 analyzers[udtParserPlugIn::Count];
 	bool recursive = false;
 	bool consoleOutput = false;
+	bool writeSeekIndex = false;
+	bool firstGameStateOnly = false;
+	bool firstMatchOnly = false;
+	bool timeWindow = false;
+	s32 gameStateIndex = 0;
+	s32 startTimeMs = UDT_S32_MIN;
+	s32 endTimeMs = UDT_S32_MAX;
 
 	for(u32 i = 0; i < (u32)udtParserPlugIn::Count; ++i)
 	{
@@ -175,6 +200,7 @@ int udt_main(int argc, char** argv)
 	for(int i = 1; i < argc - 1; ++i)
 	{
 		s32 localMaxThreads = 1;
+		s32 localInt = 0;
 
 		const udtString arg = udtString::NewConstRef(argv[i]);
 		if(udtString::Equals(arg, "-r"))
@@ -185,6 +211,40 @@ int udt_main(int argc, char** argv)
 		{
 			consoleOutput = true;
 		}
+		else if(udtString::Equals(arg, "-i"))
+		{
+			writeSeekIndex = true;
+		}
+		else if(udtString::Equals(arg, "-g"))
+		{
+			firstGameStateOnly = true;
+		}
+		else if(udtString::Equals(arg, "-m"))
+		{
+			firstMatchOnly = true;
+		}
+		else if(udtString::StartsWith(arg, "-n=") &&
+				arg.GetLength() >= 4 &&
+				StringParseInt(localInt, arg.GetPtr() + 3) &&
+				localInt >= 0)
+		{
+			timeWindow = true;
+			gameStateIndex = localInt;
+		}
+		else if(udtString::StartsWith(arg, "-s=") &&
+				arg.GetLength() >= 4 &&
+				StringParseSeconds(localInt, arg.GetPtr() + 3))
+		{
+			timeWindow = true;
+			startTimeMs = localInt * 1000;
+		}
+		else if(udtString::StartsWith(arg, "-e=") &&
+				arg.GetLength() >= 4 &&
+				StringParseSeconds(localInt, arg.GetPtr() + 3))
+		{
+			timeWindow = true;
+			endTimeMs = localInt * 1000;
+		}
 		else if(udtString::StartsWith(arg, "-o=") && 
 				arg.GetLength() >= 4 &&
 				IsValidDirectory(argv[i] + 3))
@@ -195,7 +255,7 @@ int udt_main(int argc, char** argv)
 				arg.GetLength() >= 4 &&
 				StringParseInt(localMaxThreads, arg.GetPtr() + 3) &&
 				localMaxThreads >= 1 &&
-				localMaxThreads <= 16)
+				localMaxThreads <= 256)
 		{
 			maxThreadCount = (u32)localMaxThreads;
 		}
@@ -222,6 +282,26 @@ int udt_main(int argc, char** argv)
 		}
 	}
 
+	u32 parseFlags = 0;
+	if(writeSeekIndex)
+	{
+		parseFlags |= (u32)udtParseArgFlag::WriteSeekIndex;
+	}
+	if(firstGameStateOnly)
+	{
+		parseFlags |= (u32)udtParseArgFlag::FirstGameStateOnly;
+		analyzers[0] = (u32)udtParserPlugIn::GameState;
+		analyzerCount = 1;
+	}
+	if(firstMatchOnly)
+	{
+		parseFlags |= (u32)udtParseArgFlag::FirstMatchOnly;
+	}
+	if(timeWindow)
+	{
+		parseFlags |= (u32)udtParseArgFlag::TimeWindow;
+	}
+
 	if(fileMode)
 	{
 		udtFileInfo fileInfo;
@@ -229,7 +309,7 @@ int udt_main(int argc, char** argv)
 		fileInfo.Path = udtString::NewConstRef(inputPath);
 		fileInfo.Size = 0;
 
-		return ProcessMultipleDemos(&fileInfo, 1, customOutputPath, consoleOutput, maxThreadCount, analyzers, analyzerCount) ? 0 : 1;
+		return ProcessMultipleDemos(&fileInfo, 1, customOutputPath, consoleOutput, parseFlags, gameStateIndex, startTimeMs, endTimeMs, maxThreadCount, analyzers, analyzerCount) ? 0 : 1;
 	}
 
 	udtFileListQuery query;
@@ -243,7 +323,7 @@ int udt_main(int argc, char** argv)
 		return 1;
 	}
 
-	if(!ProcessMultipleDemos(query.Files.GetStartAddress(), query.Files.GetSize(), customOutputPath, false, maxThreadCount, analyzers, analyzerCount))
+	if(!ProcessMultipleDemos(query.Files.GetStartAddress(), query.Files.GetSize(), customOutputPath, false, parseFlags, gameStateIndex, startTimeMs, endTimeMs, maxThreadCount, analyzers, analyzerCount))
 	{
 		return 1;
 	}
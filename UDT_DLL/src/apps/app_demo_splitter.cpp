@@ -2,7 +2,6 @@
 #include "file_stream.hpp"
 #include "shared.hpp"
 #include "utils.hpp"
-#include "analysis_splitter.hpp"
 #include "stack_trace.hpp"
 
 #include <stdio.h>
@@ -0,0 +1,138 @@
+#include "tokenizer.hpp"
+#include "server_commands.hpp"
+#include "utils.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// Regression tests for internal code the API doesn't expose.
+// Returns a non-zero exit code when any test fails.
+
+
+static u32 FailureCount = 0;
+
+static void Check(bool condition, const char* testName, const char* description)
+{
+	if(!condition)
+	{
+		fprintf(stderr, "FAILED: %s: %s\n", testName, description);
+		++FailureCount;
+	}
+}
+
+// Commands longer than UDT_TOKENIZER_MAX_COMMAND_LENGTH must be tokenized
+// exactly like their truncated copy, without writing past the tokenized command buffer.
+static void TestTokenizerLongCommand(const char* testName, const char* command)
+{
+	static idTokenizer tokenizer;
+	static idTokenizer truncatedTokenizer;
+	static char truncatedCommand[UDT_TOKENIZER_MAX_COMMAND_LENGTH + 1];
+	Q_strncpyz(truncatedCommand, command, (s32)sizeof(truncatedCommand));
+
+	tokenizer.Tokenize(command);
+	truncatedTokenizer.Tokenize(truncatedCommand);
+
+	const u32 argCount = tokenizer.GetArgCount();
+	Check(argCount == truncatedTokenizer.GetArgCount(), testName, "argument count mismatch");
+	if(argCount != truncatedTokenizer.GetArgCount())
+	{
+		return;
+	}
+
+	u32 totalLength = 0;
+	for(u32 i = 0; i < argCount; ++i)
+	{
+		const u32 length = tokenizer.GetArgLength(i);
+		totalLength += length + 1;
+		Check(length == truncatedTokenizer.GetArgLength(i), testName, "argument length mismatch");
+		Check(tokenizer.GetArgOffset(i) == truncatedTokenizer.GetArgOffset(i), testName, "argument offset mismatch");
+		Check(strcmp(tokenizer.GetArgString(i), truncatedTokenizer.GetArgString(i)) == 0, testName, "argument mismatch");
+	}
+
+	Check(totalLength <= (u32)(BIG_INFO_STRING + MAX_STRING_TOKENS), testName, "tokenized command too long");
+}
+
+static void FillCommand(char* command, u32 length, const char* pattern)
+{
+	const u32 patternLength = (u32)strlen(pattern);
+	for(u32 i = 0; i < length; ++i)
+	{
+		command[i] = pattern[i % patternLength];
+	}
+	command[length] = '\0';
+}
+
+static void TestTokenizer()
+{
+	const u32 commandLength = 4 * BIG_INFO_STRING;
+	char* const command = (char*)malloc((size_t)commandLength + 1);
+	if(command == NULL)
+	{
+		Check(false, "Tokenizer", "out of memory");
+		return;
+	}
+
+	FillCommand(command, commandLength, "a");
+	TestTokenizerLongCommand("Tokenizer: unquoted", command);
+
+	FillCommand(command, commandLength, "b");
+	memcpy(command, "cs 1 \"", 6);
+	TestTokenizerLongCommand("Tokenizer: quoted", command);
+
+	FillCommand(command, commandLength, "c/d ");
+	TestTokenizerLongCommand("Tokenizer: slashes", command);
+
+	FillCommand(command, commandLength, "e /*f*/ ");
+	TestTokenizerLongCommand("Tokenizer: comments", command);
+
+	FillCommand(command, commandLength, "g ");
+	TestTokenizerLongCommand("Tokenizer: too many tokens", command);
+
+	// Make the limit fall on a slash, right before a comment.
+	FillCommand(command, commandLength, "h");
+	command[UDT_TOKENIZER_MAX_COMMAND_LENGTH - 1] = '/';
+	command[UDT_TOKENIZER_MAX_COMMAND_LENGTH] = '/';
+	TestTokenizerLongCommand("Tokenizer: slash at the limit", command);
+
+	free(command);
+}
+
+static void TestServerCommandId(const char* name, udtServerCommand::Id expectedId, bool expectedMatchesCase)
+{
+	bool matchesCase = !expectedMatchesCase;
+	const udtServerCommand::Id id = GetServerCommandId(matchesCase, udtString::NewConstRef(name));
+	Check(id == expectedId, name, "wrong server command id");
+	Check(matchesCase == expectedMatchesCase, name, "wrong case match");
+}
+
+// The look-up ignores case, but still tells when the case didn't match.
+static void TestServerCommands()
+{
+	BuildServerCommandLookUpTable();
+
+	TestServerCommandId("print", udtServerCommand::Print, true);
+	TestServerCommandId("Print", udtServerCommand::Print, false);
+	TestServerCommandId("xStats2", udtServerCommand::CPMAXStats2, false);
+	TestServerCommandId("SCORES", udtServerCommand::Scores, false);
+	TestServerCommandId("cs", udtServerCommand::ConfigString, true);
+	TestServerCommandId("printx", udtServerCommand::Unknown, false);
+	TestServerCommandId("", udtServerCommand::Unknown, false);
+}
+
+int main(int, char**)
+{
+	TestTokenizer();
+	TestServerCommands();
+
+	if(FailureCount > 0)
+	{
+		fprintf(stderr, "%u test(s) failed\n", (unsigned int)FailureCount);
+		return 1;
+	}
+
+	printf("All tests passed\n");
+
+	return 0;
+}
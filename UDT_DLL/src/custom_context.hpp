@@ -19,9 +19,11 @@ struct udtCuContext_s
 	udtVMArray<udtString> CommandTokens { "CuContext::CommandTokensArray" };
 	udtVMArray<const char*> CommandTokenAddresses { "CuContext::CommandTokensRawArray" };
 	udtVMArray<const idEntityStateBase*> ChangedEntities { "CuContext::ChangedEntitiesArray" };
+	udtVMArray<u8> CheckpointData { "CuContext::CheckpointDataArray" };
 	udtVMLinearAllocator StringAllocator { "CuContext::Strings" };
 	udtCuSnapshotMessage Snapshot;
 	udtCuGamestateMessage GameState;
 	udtCuMessageOutput Message;
 	udtMessage InMessage;
+	u8 InMessageData[ID_MAX_MSG_LENGTH + UDT_MESSAGE_READ_PADDING]; // The caller's buffer has no read padding.
 };
@@ -39,6 +39,25 @@ u64 udtFileStream::GetFileLength(const char* filePath)
 	return (u64)size.QuadPart;
 }
 
+bool udtFileStream::Delete(const char* filePath)
+{
+	udtVMLinearAllocator& allocator = udtThreadLocalAllocators::GetTempAllocator();
+	udtVMScopedStackAllocator allocatorScope(allocator);
+	wchar_t* const wideFilePath = udtString::ConvertToUTF16(allocator, udtString::NewConstRef(filePath));
+
+	return DeleteFileW(wideFilePath) != FALSE;
+}
+
+bool udtFileStream::Rename(const char* oldFilePath, const char* newFilePath)
+{
+	udtVMLinearAllocator& allocator = udtThreadLocalAllocators::GetTempAllocator();
+	udtVMScopedStackAllocator allocatorScope(allocator);
+	wchar_t* const wideOldFilePath = udtString::ConvertToUTF16(allocator, udtString::NewConstRef(oldFilePath));
+	wchar_t* const wideNewFilePath = udtString::ConvertToUTF16(allocator, udtString::NewConstRef(newFilePath));
+
+	return MoveFileExW(wideOldFilePath, wideNewFilePath, MOVEFILE_REPLACE_EXISTING) != FALSE;
+}
+
 bool udtFileStream::Open(const char* filePath, udtFileOpenMode::Id mode)
 {
 	if(mode < 0 || mode >= udtFileOpenMode::Count)
@@ -75,6 +94,16 @@ u64 udtFileStream::GetFileLength(const char* filePath)
 	return (u64)fileStat.st_size;
 }
 
+bool udtFileStream::Delete(const char* filePath)
+{
+	return remove(filePath) == 0;
+}
+
+bool udtFileStream::Rename(const char* oldFilePath, const char* newFilePath)
+{
+	return rename(oldFilePath, newFilePath) == 0;
+}
+
 bool udtFileStream::Open(const char* filePath, udtFileOpenMode::Id mode)
 {
 	if(mode < 0 || mode >= udtFileOpenMode::Count)
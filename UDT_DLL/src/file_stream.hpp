@@ -25,6 +25,8 @@ public:
 
 	static bool Exists(const char* filePath);
 	static u64  GetFileLength(const char* filePath);
+	static bool Delete(const char* filePath);
+	static bool Rename(const char* oldFilePath, const char* newFilePath); // Replaces the destination file if it exists.
 
 	bool   Open(const char* filePath, udtFileOpenMode::Id mode);
 
@@ -0,0 +1,144 @@
+#include "game_state_scanner.hpp"
+#include "memory_mapped_file_stream.hpp"
+#include "file_stream.hpp"
+#include "utils.hpp"
+
+
+udtGameStateScanner::udtGameStateScanner()
+{
+	_message.InitContext(&_context);
+}
+
+bool udtGameStateScanner::Scan(udtStream& file, udtProtocol::Id protocol, const s32* cancelOperation)
+{
+	GameStateFileOffsets.Clear();
+	GameStateServerTimes.Clear();
+	if(!udtIsValidProtocol(protocol))
+	{
+		return false;
+	}
+
+	_message.InitProtocol(protocol);
+	const bool huffman = !AreAllProtocolFlagsSet(protocol, udtProtocolFlagsEx::NoHuffman);
+
+	u32 fileOffset = (u32)file.Offset();
+	bool waitingForSnapshot = false;
+	for(;;)
+	{
+		if(cancelOperation != NULL && *cancelOperation != 0)
+		{
+			return false;
+		}
+
+		// Message sequence number and byte count.
+		s32 header[2];
+		if(file.Read(header, 8, 1) != 1 || header[1] == -1)
+		{
+			break;
+		}
+
+		const s32 messageByteCount = header[1];
+		if((u32)messageByteCount > (u32)ID_MAX_MSG_LENGTH)
+		{
+			return false;
+		}
+
+		_message.Init(_messageData, ID_MAX_MSG_LENGTH);
+		const u8* const inPlaceData = file.ReadInPlace((u32)messageByteCount, UDT_MESSAGE_READ_PADDING);
+		if(inPlaceData != NULL)
+		{
+			_message.Buffer.data = (u8*)inPlaceData;
+		}
+		else if(file.Read(_messageData, (u32)messageByteCount, 1) != 1)
+		{
+			break;
+		}
+
+		_message.Buffer.cursize = messageByteCount;
+		_message.SetHuffman(huffman);
+
+		bool gameState = false;
+		s32 serverTime = UDT_S32_MIN;
+		ReadMessageStart(protocol, gameState, serverTime);
+		if(gameState)
+		{
+			GameStateFileOffsets.Add(fileOffset);
+			GameStateServerTimes.Add(UDT_S32_MIN);
+			waitingForSnapshot = true;
+		}
+		else if(waitingForSnapshot && serverTime != UDT_S32_MIN)
+		{
+			GameStateServerTimes[GameStateServerTimes.GetSize() - 1] = serverTime;
+			waitingForSnapshot = false;
+		}
+
+		fileOffset += 8 + (u32)messageByteCount;
+	}
+
+	return true;
+}
+
+bool udtGameStateScanner::ScanFile(const char* filePath, udtProtocol::Id protocol, const s32* cancelOperation)
+{
+	udtMemoryMappedFileStream mappedFile;
+	if(mappedFile.Open(filePath))
+	{
+		return Scan(mappedFile, protocol, cancelOperation);
+	}
+
+	udtFileStream file;
+	if(!file.Open(filePath, udtFileOpenMode::Read))
+	{
+		return false;
+	}
+
+	return Scan(file, protocol, cancelOperation);
+}
+
+void udtGameStateScanner::ReadMessageStart(udtProtocol::Id protocol, bool& gameState, s32& serverTime)
+{
+	// Same layout as udtBaseParser::ParseServerMessage:
+	// server commands can come first but the snapshot is always last.
+	udtMessage& msg = _message;
+	if(protocol > udtProtocol::Dm3)
+	{
+		msg.ReadLong(); // Reliable sequence acknowledge.
+	}
+
+	while(msg.ValidState() && msg.Buffer.readcount < msg.Buffer.cursize)
+	{
+		s32 stringLength = 0;
+		const s32 command = msg.ReadByte();
+		switch(command)
+		{
+			case svc_nop:
+				break;
+
+			case svc_serverCommand:
+				msg.ReadLong(); // Command sequence number.
+				msg.ReadString(stringLength);
+				break;
+
+			case svc_gamestate:
+				gameState = true;
+				return;
+
+			case svc_snapshot:
+				// Same layout as udtBaseParser::ParseSnapshot.
+				if(protocol == udtProtocol::Dm3)
+				{
+					msg.ReadLong(); // Client command sequence.
+				}
+				serverTime = msg.ReadLong();
+				return;
+
+			default:
+				return;
+		}
+
+		if(protocol <= udtProtocol::Dm48)
+		{
+			msg.GoToNextByte();
+		}
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+
+#include "context.hpp"
+#include "message.hpp"
+#include "stream.hpp"
+#include "array.hpp"
+
+
+// Finds where the game states begin by only decoding the server commands at the start of each message
+// and the server time at the start of the first snapshot of each game state.
+// Snapshots are never fully decoded, so this runs much faster than a regular parse.
+// Don't ever allocate an instance of this on the stack.
+struct udtGameStateScanner
+{
+public:
+	udtGameStateScanner();
+
+	bool Scan(udtStream& file, udtProtocol::Id protocol, const s32* cancelOperation = NULL);
+	bool ScanFile(const char* filePath, udtProtocol::Id protocol, const s32* cancelOperation = NULL);
+
+	udtVMArray<u32> GameStateFileOffsets { "GameStateScanner::GameStateFileOffsetsArray" };
+	udtVMArray<s32> GameStateServerTimes { "GameStateScanner::GameStateServerTimesArray" }; // Of the first snapshot, UDT_S32_MIN if there isn't any.
+
+private:
+	UDT_NO_COPY_SEMANTICS(udtGameStateScanner);
+
+	void ReadMessageStart(udtProtocol::Id protocol, bool& gameState, s32& serverTime);
+
+	udtContext _context;
+	udtMessage _message;
+	u8 _messageData[ID_MAX_MSG_LENGTH + UDT_MESSAGE_READ_PADDING];
+};
@@ -0,0 +1,172 @@
+#include "info_string_table.hpp"
+
+#include <string.h>
+
+
+static u32 HashInfoStringKey(const char* key, u32 length)
+{
+	// FNV-1a.
+	u32 hash = 2166136261u;
+	for(u32 i = 0; i < length; ++i)
+	{
+		hash = (hash ^ (u32)(u8)key[i]) * 16777619u;
+	}
+
+	return hash;
+}
+
+
+udtInfoStringTable::udtInfoStringTable()
+{
+}
+
+udtInfoStringTable::~udtInfoStringTable()
+{
+}
+
+void udtInfoStringTable::Init(u32 stringCount)
+{
+	_tables.Resize(stringCount);
+	Clear();
+}
+
+void udtInfoStringTable::Clear()
+{
+	for(u32 i = 0, count = _tables.GetSize(); i < count; ++i)
+	{
+		_tables[i].SourceOffset = UDT_U32_MAX;
+	}
+
+	_entries.Clear();
+	_slots.Clear();
+	_data.Clear();
+}
+
+bool udtInfoStringTable::GetValue(udtString& value, u32 stringIndex, const udtString& infoString, const char* varName)
+{
+	if(stringIndex >= _tables.GetSize() || 
+	   udtString::IsNull(infoString) || 
+	   varName == NULL)
+	{
+		return false;
+	}
+
+	// Config strings are never modified in place: a new value means a new offset.
+	Table& table = _tables[stringIndex];
+	if(table.SourceOffset != infoString.GetOffset() ||
+	   table.SourceLength != infoString.GetLength())
+	{
+		Build(table, infoString);
+	}
+
+	const Entry* const entry = Find(table, varName, HashInfoStringKey(varName, (u32)strlen(varName)));
+	if(entry == NULL)
+	{
+		return false;
+	}
+
+	value = udtString::NewFromAllocAndOffset(_data, entry->ValueOffset, entry->ValueLength);
+
+	return true;
+}
+
+void udtInfoStringTable::Build(Table& table, const udtString& infoString)
+{
+	const u32 length = infoString.GetLength();
+	const u32 dataOffset = (u32)_data.Allocate((uptr)length + 1);
+	char* const data = (char*)_data.GetAddressAt((uptr)dataOffset);
+	memcpy(data, infoString.GetPtr(), (size_t)length);
+	data[length] = '\0';
+
+	table.SourceOffset = infoString.GetOffset();
+	table.SourceLength = length;
+	table.FirstEntry = _entries.GetSize();
+	table.FirstSlot = _slots.GetSize();
+	table.SlotCount = 0;
+
+	// The format is the following: "key1\value1\key2\value2"
+	// We work with no guarantee of a leading or trailing backslash.
+	u32 i = (length > 0 && data[0] == '\\') ? 1 : 0;
+	while(i < length)
+	{
+		const char* const keySeparator = (const char*)memchr(data + i, '\\', (size_t)(length - i));
+		if(keySeparator == NULL)
+		{
+			break;
+		}
+
+		const u32 keyStart = i;
+		const u32 keyLength = (u32)(keySeparator - data) - keyStart;
+		const u32 valueStart = keyStart + keyLength + 1;
+		const char* const valueSeparator = (const char*)memchr(data + valueStart, '\\', (size_t)(length - valueStart));
+		const u32 valueEnd = valueSeparator != NULL ? (u32)(valueSeparator - data) : length;
+		data[keyStart + keyLength] = '\0';
+		data[valueEnd] = '\0';
+
+		Entry entry;
+		entry.KeyHash = HashInfoStringKey(data + keyStart, keyLength);
+		entry.KeyOffset = dataOffset + keyStart;
+		entry.ValueOffset = dataOffset + valueStart;
+		entry.ValueLength = valueEnd - valueStart;
+		_entries.Add(entry);
+
+		i = valueEnd + 1;
+	}
+
+	const u32 entryCount = _entries.GetSize() - table.FirstEntry;
+	if(entryCount == 0)
+	{
+		return;
+	}
+
+	u32 slotCount = 4;
+	while(slotCount < 2 * entryCount)
+	{
+		slotCount *= 2;
+	}
+
+	table.SlotCount = slotCount;
+	_slots.Resize(table.FirstSlot + slotCount);
+	u16* const slots = _slots.GetStartAddress() + table.FirstSlot;
+	memset(slots, 0, (size_t)slotCount * sizeof(u16));
+	for(u32 e = 0; e < entryCount; ++e)
+	{
+		const Entry& entry = _entries[table.FirstEntry + e];
+
+		// When a key is duplicated, the first occurrence wins.
+		const char* const key = (const char*)_data.GetAddressAt((uptr)entry.KeyOffset);
+		if(Find(table, key, entry.KeyHash) != NULL)
+		{
+			continue;
+		}
+
+		u32 slot = entry.KeyHash & (slotCount - 1);
+		while(slots[slot] != 0)
+		{
+			slot = (slot + 1) & (slotCount - 1);
+		}
+		slots[slot] = (u16)(e + 1);
+	}
+}
+
+const udtInfoStringTable::Entry* udtInfoStringTable::Find(const Table& table, const char* varName, u32 hash) const
+{
+	if(table.SlotCount == 0)
+	{
+		return NULL;
+	}
+
+	const u16* const slots = _slots.GetStartAddress() + table.FirstSlot;
+	const u32 slotMask = table.SlotCount - 1;
+	for(u32 slot = hash & slotMask; slots[slot] != 0; slot = (slot + 1) & slotMask)
+	{
+		const Entry& entry = _entries[table.FirstEntry + slots[slot] - 1];
+		if(entry.KeyHash == hash &&
+		   strcmp((const char*)_data.GetAddressAt((uptr)entry.KeyOffset), varName) == 0)
+		{
+			return &entry;
+		}
+	}
+
+	return NULL;
+}
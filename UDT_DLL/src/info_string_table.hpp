@@ -0,0 +1,51 @@
+#pragma once
+
+
+#include "string.hpp"
+#include "array.hpp"
+#include "linear_allocator.hpp"
+
+
+// Key/value look-ups in info strings of the form "\key1\value1\key2\value2".
+// A string is parsed once, on the first look-up after it changed, into a hash table of its keys.
+struct udtInfoStringTable
+{
+public:
+	udtInfoStringTable();
+	~udtInfoStringTable();
+
+	void Init(u32 stringCount);
+	void Clear(); // Must be called when the memory of the indexed strings gets reused.
+
+	// The variable name matching is case sensitive.
+	// The value is null-terminated, must not be modified and remains valid until Clear is called.
+	bool GetValue(udtString& value, u32 stringIndex, const udtString& infoString, const char* varName);
+
+private:
+	UDT_NO_COPY_SEMANTICS(udtInfoStringTable);
+
+	struct Entry
+	{
+		u32 KeyHash;
+		u32 KeyOffset; // In _data.
+		u32 ValueOffset; // In _data.
+		u32 ValueLength;
+	};
+
+	struct Table
+	{
+		u32 SourceOffset; // Of the indexed string in its allocator. UDT_U32_MAX when not indexed.
+		u32 SourceLength;
+		u32 FirstEntry;
+		u32 FirstSlot;
+		u32 SlotCount; // 0 or a power of 2.
+	};
+
+	void        Build(Table& table, const udtString& infoString);
+	const Entry* Find(const Table& table, const char* varName, u32 hash) const;
+
+	udtVMArray<Table> _tables { "InfoStringTable::TablesArray" };
+	udtVMArray<Entry> _entries { "InfoStringTable::EntriesArray" };
+	udtVMArray<u16> _slots { "InfoStringTable::SlotsArray" }; // Entry index relative to Table::FirstEntry plus 1, 0 when free.
+	udtVMLinearAllocator _data { "InfoStringTable::Data" }; // String copies with null terminators in place of the separators.
+};
@@ -628,8 +628,16 @@ static void WriteGameStates(udtJSONExporter& writer, const udtParseDataGameState
 		}
 
 		writer.WriteIntValue("file offset", (s32)info.FileOffset);
-		writer.WriteIntValue("start time", info.FirstSnapshotTimeMs);
-		writer.WriteIntValue("end time", info.LastSnapshotTimeMs);
+		if(info.FirstSnapshotTimeMs <= info.LastSnapshotTimeMs) // No snapshot read in header scans.
+		{
+			writer.WriteIntValue("start time", info.FirstSnapshotTimeMs);
+			writer.WriteIntValue("end time", info.LastSnapshotTimeMs);
+		}
+		writer.WriteStringValue("map", info.MapName);
+		WriteUDTMod(writer, info.Mod);
+		WriteUDTGameTypeShort(writer, info.GameType);
+		WriteUDTGameTypeLong(writer, info.GameType);
+		writer.WriteStringValue("protocol", udtGetFileExtensionByProtocol(info.Protocol));
 
 		writer.StartArray("matches");
 		for(u32 j = info.FirstMatchIndex, endM = j + info.MatchCount; j < endM; ++j)
@@ -648,8 +656,11 @@ static void WriteGameStates(udtJSONExporter& writer, const udtParseDataGameState
 			writer.WriteIntValue("client number", gameStateBuffers.Players[j].Index);
 			writer.WriteStringValue("clean name", gameStateBuffers.Players[j].FirstName);
 			WriteUDTTeamIndex(writer, (udtTeam::Id)gameStateBuffers.Players[j].FirstTeam);
-			writer.WriteIntValue("start time", gameStateBuffers.Players[j].FirstSnapshotTimeMs);
-			writer.WriteIntValue("end time", gameStateBuffers.Players[j].LastSnapshotTimeMs);
+			if(gameStateBuffers.Players[j].FirstSnapshotTimeMs <= gameStateBuffers.Players[j].LastSnapshotTimeMs)
+			{
+				writer.WriteIntValue("start time", gameStateBuffers.Players[j].FirstSnapshotTimeMs);
+				writer.WriteIntValue("end time", gameStateBuffers.Players[j].LastSnapshotTimeMs);
+			}
 			writer.EndObject();
 		}
 		writer.EndArray();
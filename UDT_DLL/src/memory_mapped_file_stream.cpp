@@ -0,0 +1,229 @@
+#include "memory_mapped_file_stream.hpp"
+#include "assert_or_fatal.hpp"
+#include "utils.hpp"
+
+#include <string.h>
+
+
+#if defined(UDT_WINDOWS)
+
+
+#include "scoped_stack_allocator.hpp"
+#include "thread_local_allocators.hpp"
+
+#include <Windows.h>
+
+
+bool udtMemoryMappedFileStream::Map(const char* filePath)
+{
+	udtVMLinearAllocator& allocator = udtThreadLocalAllocators::GetTempAllocator();
+	udtVMScopedStackAllocator allocatorScope(allocator);
+	wchar_t* const wideFilePath = udtString::ConvertToUTF16(allocator, udtString::NewConstRef(filePath));
+	const HANDLE file = CreateFileW(wideFilePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if(file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER size;
+	if(GetFileSizeEx(file, &size) == FALSE || size.QuadPart == 0 || size.QuadPart > (LONGLONG)0xFFFFFFFF)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	const HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if(mapping == NULL)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	const void* const data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if(data == NULL)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	_data = (const u8*)data;
+	_fileHandle = (uptr)file;
+	_mappingHandle = (uptr)mapping;
+	_byteCount = (u32)size.QuadPart;
+
+	return true;
+}
+
+void udtMemoryMappedFileStream::Unmap()
+{
+	UnmapViewOfFile(_data);
+	CloseHandle((HANDLE)_mappingHandle);
+	CloseHandle((HANDLE)_fileHandle);
+}
+
+
+#else
+
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+bool udtMemoryMappedFileStream::Map(const char* filePath)
+{
+	const int file = open(filePath, O_RDONLY);
+	if(file == -1)
+	{
+		return false;
+	}
+
+	struct stat fileInfo;
+	if(fstat(file, &fileInfo) != 0 || fileInfo.st_size == 0 || (u64)fileInfo.st_size > (u64)0xFFFFFFFF)
+	{
+		close(file);
+		return false;
+	}
+
+	void* const data = mmap(NULL, (size_t)fileInfo.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file); // The mapping keeps its own reference.
+	if(data == MAP_FAILED)
+	{
+		return false;
+	}
+
+	madvise(data, (size_t)fileInfo.st_size, MADV_SEQUENTIAL);
+
+	_data = (const u8*)data;
+	_byteCount = (u32)fileInfo.st_size;
+
+	return true;
+}
+
+void udtMemoryMappedFileStream::Unmap()
+{
+	munmap((void*)_data, (size_t)_byteCount);
+}
+
+
+#endif
+
+
+udtMemoryMappedFileStream::udtMemoryMappedFileStream()
+{
+	_data = NULL;
+	_fileHandle = 0;
+	_mappingHandle = 0;
+	_byteCount = 0;
+	_offset = 0;
+}
+
+udtMemoryMappedFileStream::~udtMemoryMappedFileStream()
+{
+	Close();
+}
+
+bool udtMemoryMappedFileStream::Open(const char* filePath, u32 offset)
+{
+	Close();
+	if(!Map(filePath))
+	{
+		return false;
+	}
+
+	if(offset > _byteCount)
+	{
+		Close();
+		return false;
+	}
+
+	_offset = offset;
+
+	return true;
+}
+
+u32 udtMemoryMappedFileStream::Read(void* dstBuff, u32 elementSize, u32 count)
+{
+	if(elementSize == 0)
+	{
+		return 0;
+	}
+
+	const u32 bytesLeft = _byteCount - _offset;
+	const u32 elementCount = udt_min(count, bytesLeft / elementSize);
+	const u32 byteCount = elementCount * elementSize;
+	memcpy(dstBuff, _data + _offset, (size_t)byteCount);
+	_offset += byteCount;
+
+	return elementCount;
+}
+
+u32 udtMemoryMappedFileStream::Write(const void* /*srcBuff*/, u32 /*elementSize*/, u32 /*count*/)
+{
+	UDT_ASSERT_OR_FATAL_ALWAYS("Calling Write on a udtMemoryMappedFileStream is invalid!");
+	return 0;
+}
+
+s32 udtMemoryMappedFileStream::Seek(s32 offset, udtSeekOrigin::Id origin)
+{
+	s64 newOffset = (s64)offset;
+	if(origin == udtSeekOrigin::Current)
+	{
+		newOffset += (s64)_offset;
+	}
+	else if(origin == udtSeekOrigin::End)
+	{
+		newOffset += (s64)_byteCount;
+	}
+
+	if(newOffset < 0 || newOffset > (s64)_byteCount)
+	{
+		return -1;
+	}
+
+	_offset = (u32)newOffset;
+
+	return 0;
+}
+
+s32 udtMemoryMappedFileStream::Offset()
+{
+	return (s32)_offset;
+}
+
+u64 udtMemoryMappedFileStream::Length()
+{
+	return (u64)_byteCount;
+}
+
+s32 udtMemoryMappedFileStream::Close()
+{
+	if(_data != NULL)
+	{
+		Unmap();
+	}
+
+	_data = NULL;
+	_fileHandle = 0;
+	_mappingHandle = 0;
+	_byteCount = 0;
+	_offset = 0;
+
+	return 0;
+}
+
+const u8* udtMemoryMappedFileStream::ReadInPlace(u32 byteCount, u32 paddingByteCount)
+{
+	const u32 bytesLeft = _byteCount - _offset;
+	if(byteCount + paddingByteCount > bytesLeft)
+	{
+		return NULL;
+	}
+
+	const u8* const data = _data + _offset;
+	_offset += byteCount;
+
+	return data;
+}
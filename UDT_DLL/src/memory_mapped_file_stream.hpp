@@ -0,0 +1,37 @@
+#pragma once
+
+
+#include "stream.hpp"
+
+
+// Read-only view of an entire file.
+// Only use this when the data will never be modified.
+struct udtMemoryMappedFileStream : udtStream
+{
+public:
+	udtMemoryMappedFileStream();
+	~udtMemoryMappedFileStream();
+
+	bool Open(const char* filePath, u32 offset = 0);
+
+	u32  Read(void* dstBuff, u32 elementSize, u32 count) override;
+	u32  Write(const void* srcBuff, u32 elementSize, u32 count) override;
+	s32  Seek(s32 offset, udtSeekOrigin::Id origin) override;
+	s32  Offset() override;
+	u64  Length() override;
+	s32  Close() override;
+
+	const u8* ReadInPlace(u32 byteCount, u32 paddingByteCount) override;
+
+private:
+	UDT_NO_COPY_SEMANTICS(udtMemoryMappedFileStream);
+
+	bool Map(const char* filePath);
+	void Unmap();
+
+	const u8* _data;     // If invalid: NULL.
+	uptr _fileHandle;    // Platform-specific.
+	uptr _mappingHandle; // Platform-specific.
+	u32 _byteCount;
+	u32 _offset;
+};
@@ -154,6 +154,33 @@ static const u16 HuffmanEncoderTable[256] =
 	7546, 3850, 11354, 12298, 15642, 14986, 8666, 20491, 90, 13706, 12186, 6794, 11162, 10458, 759, 582
 };
 
+// Indexed with the next 16 bits of the stream.
+// Bits  0-15: up to 2 decoded symbols, the first one in the low byte
+// Bits 16-23: number of bits consumed
+// Bits 24-31: number of symbols decoded (1 or 2)
+static u32 HuffmanMultiDecoderTable[1 << 16];
+
+void BuildHuffmanLookUpTables()
+{
+	for(u32 i = 0; i < (u32)UDT_COUNT_OF(HuffmanMultiDecoderTable); ++i)
+	{
+		const u32 entry0 = (u32)HuffmanDecoderTable[i & 0x7FF];
+		const u32 length0 = entry0 >> 8;
+		const u32 entry1 = (u32)HuffmanDecoderTable[(i >> length0) & 0x7FF];
+		const u32 length1 = entry1 >> 8;
+		
+		// Codes are prefix-free, so the second symbol is valid when its code fits in the window.
+		if(length0 + length1 <= 16)
+		{
+			HuffmanMultiDecoderTable[i] = (entry0 & 0xFF) | ((entry1 & 0xFF) << 8) | ((length0 + length1) << 16) | (2 << 24);
+		}
+		else
+		{
+			HuffmanMultiDecoderTable[i] = (entry0 & 0xFF) | (length0 << 16) | (1 << 24);
+		}
+	}
+}
+
 static UDT_FORCE_INLINE void HuffmanPutBit(u8* fout, s32 bitIndex, s32 bit)
 {
 	const s32 byteIndex = bitIndex >> 3;
@@ -169,21 +196,44 @@ static UDT_FORCE_INLINE void HuffmanPutBit(u8* fout, s32 bitIndex, s32 bit)
 	fout[(bitIndex >> 3)] |= bit << (bitIndex & 7);
 }
 
-static UDT_FORCE_INLINE void HuffmanOffsetTransmit(u8* fout, s32* offset, s32 ch)
+// Writes up to 57 bits gathered in an accumulator, the first bit in the lowest position.
+// Like HuffmanPutBit, it preserves the bits already written to the current byte only.
+static UDT_FORCE_INLINE void HuffmanPutBits(u8* fout, s32 maxByteCount, s32 bitIndex, u64 bits, s32 bitCount)
 {
-	const u16 result = HuffmanEncoderTable[ch];
-	const u16 bitCount = result & 15;
-	const u16 code = (result >> 4) & 0x7FF;
-	const u32 bitIndex = *(const u32*)offset;
+	u8* const dest = fout + (bitIndex >> 3);
+	const s32 bitOffset = bitIndex & 7;
+	bits = (bits << bitOffset) | (u64)(*dest & ((1 << bitOffset) - 1));
+	if((bitIndex >> 3) + 8 <= maxByteCount)
+	{
+		*(u64*)dest = bits;
+		return;
+	}
 
-	s32 bits = (s32)code;
-	for(u32 i = 0; i < bitCount; ++i)
+	const s32 byteCount = (bitOffset + bitCount + 7) >> 3;
+	for(s32 i = 0; i < byteCount; ++i)
 	{
-		HuffmanPutBit(fout, bitIndex + i, bits & 1);
-		bits >>= 1;
+		dest[i] = (u8)bits;
+		bits >>= 8;
 	}
+}
 
-	*offset += (s32)bitCount;
+// Appends what RealWriteBits writes in Huffman mode for a bit count in [1, 32]:
+// the raw low bits come first, followed by the Huffman code of every full byte.
+// At most 7 + 4 x 11 = 51 bits.
+static UDT_FORCE_INLINE void HuffmanEncodeBits(u64& accumulator, s32& accumulatorBitCount, u32 value, s32 bits)
+{
+	value &= (0xffffffff >> (32-bits));
+	const s32 rawBitCount = bits & 7;
+	accumulator |= (u64)(value & ((1 << rawBitCount) - 1)) << accumulatorBitCount;
+	accumulatorBitCount += rawBitCount;
+	value >>= rawBitCount;
+	for(s32 i = rawBitCount; i < bits; i += 8)
+	{
+		const u32 entry = (u32)HuffmanEncoderTable[value & 0xFF];
+		accumulator |= (u64)((entry >> 4) & 0x7FF) << accumulatorBitCount;
+		accumulatorBitCount += (s32)(entry & 15);
+		value >>= 8;
+	}
 }
 
 
@@ -193,6 +243,208 @@ static UDT_FORCE_INLINE void HuffmanOffsetTransmit(u8* fout, s32* offset, s32 ch
 #define	FLOAT_INT_BIAS	(1<<(FLOAT_INT_BITS-1))
 
 
+// Sneaking around the strict aliasing rules.
+union FloatAndInt
+{
+	FloatAndInt(f32 f) : AsFloat(f) {}
+
+	f32 AsFloat;
+	s32 AsInt;
+};
+
+// Gathers the writes of a delta-encoded entity or player state in Huffman mode
+// and stores them up to 57 bits at a time instead of going through udtMessage::WriteBits.
+struct udtHuffmanDeltaWriter
+{
+	udtHuffmanDeltaWriter(u8* data, s32 maxByteCount, s32 bitIndex)
+		: Data(data)
+		, Bits(0)
+		, MaxByteCount(maxByteCount)
+		, BitIndex(bitIndex)
+		, BitCount(0)
+		, Overflowed(false)
+	{
+	}
+
+	UDT_FORCE_INLINE void WriteBit(u32 bit)
+	{
+		Reserve(1);
+		Bits |= (u64)bit << BitCount;
+		++BitCount;
+	}
+
+	// Same as udtMessage::WriteBits: negative bit counts are for signed values.
+	UDT_FORCE_INLINE void WriteBits(s32 value, s32 signedBits)
+	{
+		Reserve(51);
+		HuffmanEncodeBits(Bits, BitCount, (u32)value, signedBits < 0 ? -signedBits : signedBits);
+	}
+
+	// Same as udtMessage::WriteField.
+	UDT_FORCE_INLINE void WriteField(s32 value, s32 bits)
+	{
+		if(bits != 0)
+		{
+			WriteBits(value, bits);
+			return;
+		}
+
+		// Same as udtMessage::RealWriteFloat.
+		f32 fullFloat;
+		memcpy(&fullFloat, &value, sizeof(f32));
+		const s32 truncatedFloat = (s32)fullFloat;
+		if(truncatedFloat == fullFloat &&
+		   truncatedFloat + FLOAT_INT_BIAS >= 0 &&
+		   truncatedFloat + FLOAT_INT_BIAS < (1 << FLOAT_INT_BITS))
+		{
+			WriteBit(0);
+			WriteBits(truncatedFloat + FLOAT_INT_BIAS, FLOAT_INT_BITS);
+		}
+		else
+		{
+			WriteBit(1);
+			WriteBits(value, 32);
+		}
+	}
+
+	s32 GetBitIndex() const { return BitIndex + BitCount; }
+
+	// Returns false if the message buffer overflowed.
+	bool Finish()
+	{
+		Flush();
+		return !Overflowed;
+	}
+
+private:
+	UDT_FORCE_INLINE void Reserve(s32 bitCount)
+	{
+		if(BitCount + bitCount > 57)
+		{
+			Flush();
+		}
+	}
+
+	void Flush()
+	{
+		if(BitIndex + BitCount > MaxByteCount * 8)
+		{
+			Overflowed = true;
+		}
+		else if(BitCount > 0)
+		{
+			HuffmanPutBits(Data, MaxByteCount, BitIndex, Bits, BitCount);
+		}
+
+		BitIndex += BitCount;
+		Bits = 0;
+		BitCount = 0;
+	}
+
+	u8* Data;
+	u64 Bits; // Not flushed yet.
+	s32 MaxByteCount;
+	s32 BitIndex; // Of the first bit not flushed yet.
+	s32 BitCount; // Not flushed yet.
+	bool Overflowed;
+};
+
+// Same as udtMessage::RealReadBitHuffman but with the bit index kept in a register.
+static UDT_FORCE_INLINE s32 HuffmanReadBit(const u8* data, s32& bitIndex)
+{
+	const s32 value = s32((data[bitIndex >> 3] >> (u8)(bitIndex & 7)) & 1);
+	++bitIndex;
+
+	return value;
+}
+
+// Decodes an unsigned value of 1 to 32 bits. Overflow checking is left to the caller.
+static UDT_FORCE_INLINE s32 HuffmanDecodeBits(const u8* data, s32& bitIndex, s32 bits)
+{
+	u32 value = 0;
+	const s32 nbits = bits & 7;
+	if(nbits)
+	{
+		const s16 allBits = *(const s16*)(data + (bitIndex >> 3)) >> (bitIndex & 7);
+		value = (u32)(allBits & ((1 << nbits) - 1));
+		bitIndex += nbits;
+		bits -= nbits;
+	}
+
+	// A single load covers the worst case of 4 codes of 11 bits.
+	// We decode 2 symbols per look-up when both codes fit in 16 bits.
+	u64 window = (*(const u64*)(data + (bitIndex >> 3))) >> ((u32)bitIndex & 7);
+	s32 shift = nbits;
+	while(bits >= 16)
+	{
+		const u32 entry = HuffmanMultiDecoderTable[window & 0xFFFF];
+		const u32 codeBits = (entry >> 16) & 0xFF;
+		const s32 decodedBits = (s32)(entry >> 24) << 3;
+		value |= (entry & 0xFFFF) << shift;
+		window >>= codeBits;
+		bitIndex += (s32)codeBits;
+		shift += decodedBits;
+		bits -= decodedBits;
+	}
+
+	if(bits)
+	{
+		const u16 entry = HuffmanDecoderTable[window & 0x7FF];
+		value |= (u32)(entry & 0xFF) << shift;
+		bitIndex += s32(entry >> 8);
+	}
+
+	return (s32)value;
+}
+
+// Same as the Huffman path of udtMessage::RealReadBits for unsigned values.
+static UDT_FORCE_INLINE bool HuffmanReadBits(s32& result, const u8* data, s32& bitIndex, s32 bits, s32 maxBitIndex)
+{
+	if(bitIndex + bits > maxBitIndex)
+	{
+		return false;
+	}
+
+	result = HuffmanDecodeBits(data, bitIndex, bits);
+
+	return true;
+}
+
+// The number of consecutive 0 bits starting at bitIndex, capped at 57.
+// The caller must make sure 8 bytes can be read at byte index (bitIndex / 8).
+static UDT_FORCE_INLINE s32 GetZeroBitRunLength(const u8* data, s32 bitIndex)
+{
+	const u64 window = (*(const u64*)(data + (bitIndex >> 3))) >> ((u32)bitIndex & 7);
+
+	return (s32)GetLowestSetBitIndex(window | ((u64)1 << 57));
+}
+
+// Same as udtMessage::ReadField for Huffman-compressed messages.
+static UDT_FORCE_INLINE bool HuffmanReadField(s32& result, const u8* data, s32& bitIndex, s32 bits, s32 maxBitIndex)
+{
+	if(bits != 0)
+	{
+		return HuffmanReadBits(result, data, bitIndex, bits, maxBitIndex);
+	}
+
+	if(HuffmanReadBit(data, bitIndex))
+	{
+		return HuffmanReadBits(result, data, bitIndex, 32, maxBitIndex);
+	}
+
+	s32 intValue = 0;
+	if(!HuffmanReadBits(intValue, data, bitIndex, FLOAT_INT_BITS, maxBitIndex))
+	{
+		return false;
+	}
+
+	const FloatAndInt realValue((f32)(intValue - FLOAT_INT_BIAS));
+	result = realValue.AsInt;
+
+	return true;
+}
+
+
 // Offset from the start of the structure == absolute address when the struct is at address 0.
 #if defined(UDT_GCC)
 #	define	OFFSET_OF(type, member)		__builtin_offsetof(type, member)
@@ -1172,8 +1424,11 @@ udtMessage::udtMessage()
 	_protocolSizeOfPlayerState = sizeof(idPlayerState68);
 	_entityStateFields = EntityStateFields68;
 	_entityStateFieldCount = EntityStateFieldCount68;
+	_readDeltaEntityHuffman = &udtMessage::ReadDeltaEntityHuffman<EntityStateFields68, EntityStateFieldCount68>;
+	_writeDeltaEntityHuffman = &udtMessage::WriteDeltaEntityHuffman<EntityStateFields68, EntityStateFieldCount68>;
 	_playerStateFields = PlayerStateFields68;
 	_playerStateFieldCount = PlayerStateFieldCount68;
+	_writeDeltaPlayerHuffman = &udtMessage::WriteDeltaPlayerHuffman<PlayerStateFields68, PlayerStateFieldCount68>;
 	_fileName = udtString::NewNull();
 }
 
@@ -1193,8 +1448,11 @@ void udtMessage::InitProtocol(udtProtocol::Id protocol)
 			_protocolSizeOfPlayerState = sizeof(idPlayerState91);
 			_entityStateFields = EntityStateFields91;
 			_entityStateFieldCount = EntityStateFieldCount91;
+			_readDeltaEntityHuffman = &udtMessage::ReadDeltaEntityHuffman<EntityStateFields91, EntityStateFieldCount91>;
+			_writeDeltaEntityHuffman = &udtMessage::WriteDeltaEntityHuffman<EntityStateFields91, EntityStateFieldCount91>;
 			_playerStateFields = PlayerStateFields91;
 			_playerStateFieldCount = PlayerStateFieldCount91;
+			_writeDeltaPlayerHuffman = &udtMessage::WriteDeltaPlayerHuffman<PlayerStateFields91, PlayerStateFieldCount91>;
 			break;
 
 		case udtProtocol::Dm90:
@@ -1202,8 +1460,11 @@ void udtMessage::InitProtocol(udtProtocol::Id protocol)
 			_protocolSizeOfPlayerState = sizeof(idPlayerState90);
 			_entityStateFields = EntityStateFields90;
 			_entityStateFieldCount = EntityStateFieldCount90;
+			_readDeltaEntityHuffman = &udtMessage::ReadDeltaEntityHuffman<EntityStateFields90, EntityStateFieldCount90>;
+			_writeDeltaEntityHuffman = &udtMessage::WriteDeltaEntityHuffman<EntityStateFields90, EntityStateFieldCount90>;
 			_playerStateFields = PlayerStateFields90;
 			_playerStateFieldCount = PlayerStateFieldCount90;
+			_writeDeltaPlayerHuffman = &udtMessage::WriteDeltaPlayerHuffman<PlayerStateFields90, PlayerStateFieldCount90>;
 			break;
 
 		case udtProtocol::Dm73:
@@ -1211,8 +1472,11 @@ void udtMessage::InitProtocol(udtProtocol::Id protocol)
 			_protocolSizeOfPlayerState = sizeof(idPlayerState73);
 			_entityStateFields = EntityStateFields73;
 			_entityStateFieldCount = EntityStateFieldCount73;
+			_readDeltaEntityHuffman = &udtMessage::ReadDeltaEntityHuffman<EntityStateFields73, EntityStateFieldCount73>;
+			_writeDeltaEntityHuffman = &udtMessage::WriteDeltaEntityHuffman<EntityStateFields73, EntityStateFieldCount73>;
 			_playerStateFields = PlayerStateFields73;
 			_playerStateFieldCount = PlayerStateFieldCount73;
+			_writeDeltaPlayerHuffman = &udtMessage::WriteDeltaPlayerHuffman<PlayerStateFields73, PlayerStateFieldCount73>;
 			break;
 
 		case udtProtocol::Dm3:
@@ -1220,8 +1484,11 @@ void udtMessage::InitProtocol(udtProtocol::Id protocol)
 			_protocolSizeOfPlayerState = sizeof(idPlayerState3);
 			_entityStateFields = EntityStateFields3;
 			_entityStateFieldCount = EntityStateFieldCount3;
+			_readDeltaEntityHuffman = &udtMessage::RealReadDeltaEntity;
+			_writeDeltaEntityHuffman = &udtMessage::RealWriteDeltaEntity;
 			_playerStateFields = PlayerStateFields3;
 			_playerStateFieldCount = PlayerStateFieldCount3;
+			_writeDeltaPlayerHuffman = &udtMessage::RealWriteDeltaPlayer;
 			break;
 
 		case udtProtocol::Dm48:
@@ -1229,8 +1496,11 @@ void udtMessage::InitProtocol(udtProtocol::Id protocol)
 			_protocolSizeOfPlayerState = sizeof(idPlayerState48);
 			_entityStateFields = EntityStateFields48;
 			_entityStateFieldCount = EntityStateFieldCount48;
+			_readDeltaEntityHuffman = &udtMessage::RealReadDeltaEntity;
+			_writeDeltaEntityHuffman = &udtMessage::RealWriteDeltaEntity;
 			_playerStateFields = PlayerStateFields48;
 			_playerStateFieldCount = PlayerStateFieldCount48;
+			_writeDeltaPlayerHuffman = &udtMessage::RealWriteDeltaPlayer;
 			break;
 
 		case udtProtocol::Dm57:
@@ -1241,8 +1511,11 @@ void udtMessage::InitProtocol(udtProtocol::Id protocol)
 			_protocolSizeOfPlayerState = sizeof(idPlayerState60);
 			_entityStateFields = EntityStateFields60;
 			_entityStateFieldCount = EntityStateFieldCount60;
+			_readDeltaEntityHuffman = &udtMessage::ReadDeltaEntityHuffman<EntityStateFields60, EntityStateFieldCount60>;
+			_writeDeltaEntityHuffman = &udtMessage::RealWriteDeltaEntity;
 			_playerStateFields = PlayerStateFields60;
 			_playerStateFieldCount = PlayerStateFieldCount60;
+			_writeDeltaPlayerHuffman = &udtMessage::RealWriteDeltaPlayer;
 			break;
 
 		case udtProtocol::Dm66:
@@ -1250,8 +1523,11 @@ void udtMessage::InitProtocol(udtProtocol::Id protocol)
 			_protocolSizeOfPlayerState = sizeof(idPlayerState66);
 			_entityStateFields = EntityStateFields68;
 			_entityStateFieldCount = EntityStateFieldCount68;
+			_readDeltaEntityHuffman = &udtMessage::ReadDeltaEntityHuffman<EntityStateFields68, EntityStateFieldCount68>;
+			_writeDeltaEntityHuffman = &udtMessage::WriteDeltaEntityHuffman<EntityStateFields68, EntityStateFieldCount68>;
 			_playerStateFields = PlayerStateFields68;
 			_playerStateFieldCount = PlayerStateFieldCount68;
+			_writeDeltaPlayerHuffman = &udtMessage::WriteDeltaPlayerHuffman<PlayerStateFields68, PlayerStateFieldCount68>;
 			break;
 
 		case udtProtocol::Dm67:
@@ -1259,8 +1535,11 @@ void udtMessage::InitProtocol(udtProtocol::Id protocol)
 			_protocolSizeOfPlayerState = sizeof(idPlayerState67);
 			_entityStateFields = EntityStateFields68;
 			_entityStateFieldCount = EntityStateFieldCount68;
+			_readDeltaEntityHuffman = &udtMessage::ReadDeltaEntityHuffman<EntityStateFields68, EntityStateFieldCount68>;
+			_writeDeltaEntityHuffman = &udtMessage::WriteDeltaEntityHuffman<EntityStateFields68, EntityStateFieldCount68>;
 			_playerStateFields = PlayerStateFields68;
 			_playerStateFieldCount = PlayerStateFieldCount68;
+			_writeDeltaPlayerHuffman = &udtMessage::WriteDeltaPlayerHuffman<PlayerStateFields68, PlayerStateFieldCount68>;
 			break;
 
 		case udtProtocol::Dm68:
@@ -1268,8 +1547,11 @@ void udtMessage::InitProtocol(udtProtocol::Id protocol)
 			_protocolSizeOfPlayerState = sizeof(idPlayerState68);
 			_entityStateFields = EntityStateFields68;
 			_entityStateFieldCount = EntityStateFieldCount68;
+			_readDeltaEntityHuffman = &udtMessage::ReadDeltaEntityHuffman<EntityStateFields68, EntityStateFieldCount68>;
+			_writeDeltaEntityHuffman = &udtMessage::WriteDeltaEntityHuffman<EntityStateFields68, EntityStateFieldCount68>;
 			_playerStateFields = PlayerStateFields68;
 			_playerStateFieldCount = PlayerStateFieldCount68;
+			_writeDeltaPlayerHuffman = &udtMessage::WriteDeltaPlayerHuffman<PlayerStateFields68, PlayerStateFieldCount68>;
 			break;
 
 		default:
@@ -1357,29 +1639,20 @@ void udtMessage::RealWriteBits(s32 value, s32 signedBits)
 	} 
 	else 
 	{
-		value &= (0xffffffff >> (32-bits));
+		// The whole write is built in one accumulator.
+		u64 accumulator = 0;
+		s32 accumulatorBitCount = 0;
+		HuffmanEncodeBits(accumulator, accumulatorBitCount, (u32)value, bits);
 
-		if(bits & 7) 
+		if(Buffer.bit + accumulatorBitCount > Buffer.maxsize * 8)
 		{
-			s32 nbits = bits&7;
-			for(s32 i = 0; i < nbits; ++i) 
-			{
-				HuffmanPutBit(Buffer.data, Buffer.bit, value & 1);
-				value = value >> 1;
-				++Buffer.bit;
-			}
-			bits = bits - nbits;
-		}
-
-		if(bits) 
-		{
-			for(s32 i = 0; i < bits; i += 8) 
-			{
-				HuffmanOffsetTransmit(Buffer.data, &Buffer.bit, value & 0xFF);
-				value = value >> 8;
-			}
+			Context->LogError("udtMessage::RealWriteBits: Overflowed! (in file: %s)", GetFileNamePtr());
+			SetValid(false);
+			return;
 		}
 
+		HuffmanPutBits(Buffer.data, Buffer.maxsize, Buffer.bit, accumulator, accumulatorBitCount);
+		Buffer.bit += accumulatorBitCount;
 		Buffer.cursize = (Buffer.bit >> 3) + 1;
 	}
 }
@@ -1461,27 +1734,8 @@ s32 udtMessage::RealReadBits(s32 signedBits)
 	} 
 	else
 	{
-		const s32 nbits = bits & 7;
 		s32 bitIndex = Buffer.bit;
-		if(nbits)
-		{		
-			const s16 allBits = *(const s16*)(bufferData + (bitIndex >> 3)) >> (bitIndex & 7);
-			value = allBits & ((1 << nbits) - 1);
-			bitIndex += nbits;
-			bits -= nbits;
-		}
-
-		if(bits)
-		{
-			for(s32 i = 0; i < bits; i += 8)
-			{
-				const u16 code = ((*(const u32*)(bufferData + (bitIndex >> 3))) >> ((u32)bitIndex & 7)) & 0x7FF;
-				const u16 entry = HuffmanDecoderTable[code];
-				value |= (s32(entry & 0xFF) << (i + nbits));
-				bitIndex += s32(entry >> 8);
-			}
-		}
-
+		value = HuffmanDecodeBits(bufferData, bitIndex, bits);
 		Buffer.bit = bitIndex;
 		Buffer.readcount = (bitIndex >> 3) + 1;
 	}
@@ -1526,6 +1780,70 @@ s32 udtMessage::RealReadBitHuffman()
 	return value;
 }
 
+void udtMessage::WriteHuffmanBits(const u8* source, s32 firstBit, s32 bitCount)
+{
+	if(Buffer.oob || firstBit < 0 || bitCount < 0)
+	{
+		Context->LogError("udtMessage::WriteHuffmanBits: Invalid arguments (in file: %s)", GetFileNamePtr());
+		SetValid(false);
+		return;
+	}
+
+	if(Buffer.bit + bitCount > Buffer.maxsize * 8)
+	{
+		Context->LogError("udtMessage::WriteHuffmanBits: Overflowed! (in file: %s)", GetFileNamePtr());
+		SetValid(false);
+		return;
+	}
+
+	u8* const dest = Buffer.data;
+	s32 destBit = Buffer.bit;
+	s32 sourceBit = firstBit;
+	s32 bitsLeft = bitCount;
+
+	// Complete the current output byte.
+	while(bitsLeft > 0 && (destBit & 7) != 0)
+	{
+		HuffmanPutBit(dest, destBit, (source[sourceBit >> 3] >> (sourceBit & 7)) & 1);
+		++destBit;
+		++sourceBit;
+		--bitsLeft;
+	}
+
+	// Write whole output bytes.
+	const s32 shift = sourceBit & 7;
+	if(shift == 0)
+	{
+		const s32 byteCount = bitsLeft >> 3;
+		memcpy(dest + (destBit >> 3), source + (sourceBit >> 3), (size_t)byteCount);
+		destBit += byteCount << 3;
+		sourceBit += byteCount << 3;
+		bitsLeft -= byteCount << 3;
+	}
+	else
+	{
+		while(bitsLeft >= 8)
+		{
+			const s32 byteIndex = sourceBit >> 3;
+			dest[destBit >> 3] = (u8)((source[byteIndex] >> shift) | (source[byteIndex + 1] << (8 - shift)));
+			destBit += 8;
+			sourceBit += 8;
+			bitsLeft -= 8;
+		}
+	}
+
+	while(bitsLeft > 0)
+	{
+		HuffmanPutBit(dest, destBit, (source[sourceBit >> 3] >> (sourceBit & 7)) & 1);
+		++destBit;
+		++sourceBit;
+		--bitsLeft;
+	}
+
+	Buffer.bit = destBit;
+	Buffer.cursize = (Buffer.bit >> 3) + 1;
+}
+
 void udtMessage::WriteData(const void* data, s32 length) 
 {
 	for(s32 i = 0; i < length; ++i) 
@@ -1606,15 +1924,6 @@ s32 udtMessage::RealReadFloat()
 		return ReadBits(32);
 	}
 
-	// Sneaking around the strict aliasing rules.
-	union FloatAndInt
-	{
-		FloatAndInt(f32 f) : AsFloat(f) {}
-
-		f32 AsFloat;
-		s32 AsInt;
-	};
-
 	const s32 intValue = ReadBits(FLOAT_INT_BITS) - FLOAT_INT_BIAS;
 	const FloatAndInt realValue((f32)intValue);
 	
@@ -1989,6 +2298,88 @@ bool udtMessage::RealWriteDeltaPlayer(const idPlayerStateBase* from, idPlayerSta
 	return ValidState();
 }
 
+// Bit i is set when the i-th values differ.
+static UDT_FORCE_INLINE s32 GetChangedValueMask16(const s32* from, const s32* to)
+{
+	s32 mask = 0;
+	for(s32 i = 0; i < 16; ++i)
+	{
+		mask |= (s32)(from[i] != to[i]) << i;
+	}
+
+	return mask;
+}
+
+static UDT_FORCE_INLINE void WriteChangedValues16(udtHuffmanDeltaWriter& writer, s32 changedMask, const s32* values, s32 valueBits)
+{
+	if(changedMask == 0)
+	{
+		writer.WriteBit(0); // no change
+		return;
+	}
+
+	writer.WriteBit(1); // changed
+	writer.WriteBits(changedMask, 16);
+	u64 mask = (u64)changedMask;
+	while(mask != 0)
+	{
+		writer.WriteBits(values[GetLowestSetBitIndex(mask)], valueBits);
+		mask &= mask - 1;
+	}
+}
+
+template<const idNetField* Fields, s32 FieldCount>
+bool udtMessage::WriteDeltaPlayerHuffman(const idPlayerStateBase* from, idPlayerStateBase* to)
+{
+	static_assert(FieldCount <= 64, "The changed field mask has 64 bits");
+	static_assert(ID_MAX_PS_STATS == 16 && ID_MAX_PS_PERSISTANT == 16 && ID_MAX_PS_POWERUPS == 16, "The changed value masks have 16 bits");
+
+	if(from == NULL)
+	{
+		return RealWriteDeltaPlayer(from, to);
+	}
+
+	u64 changedFields = 0;
+	for(s32 i = 0; i < FieldCount; ++i)
+	{
+		const s32 offset = Fields[i].offset;
+		changedFields |= (u64)(*(const s32*)((const u8*)from + offset) != *(const s32*)((const u8*)to + offset)) << i;
+	}
+
+	udtHuffmanDeltaWriter writer(Buffer.data, Buffer.maxsize, Buffer.bit);
+	const s32 lc = changedFields != 0 ? (s32)GetHighestSetBitIndex(changedFields) + 1 : 0;
+	writer.WriteBits(lc, 8); // # of changes
+	for(s32 i = 0; i < lc; ++i)
+	{
+		if((changedFields & ((u64)1 << (u64)i)) == 0)
+		{
+			writer.WriteBit(0);
+			continue;
+		}
+
+		writer.WriteBit(1);
+		writer.WriteField(*(const s32*)((const u8*)to + Fields[i].offset), Fields[i].bits);
+	}
+
+	const s32 statsbits = GetChangedValueMask16(from->stats, to->stats);
+	const s32 persistantbits = GetChangedValueMask16(from->persistant, to->persistant);
+	const s32 ammobits = GetChangedValueMask16(from->ammo, to->ammo);
+	const s32 powerupbits = GetChangedValueMask16(from->powerups, to->powerups);
+	if(!statsbits && !persistantbits && !ammobits && !powerupbits)
+	{
+		writer.WriteBit(0); // no change
+		return WriteDeltaHuffmanEnd(writer.GetBitIndex(), writer.Finish());
+	}
+
+	writer.WriteBit(1); // changed
+	WriteChangedValues16(writer, statsbits, to->stats, 16);
+	WriteChangedValues16(writer, persistantbits, to->persistant, 16);
+	WriteChangedValues16(writer, ammobits, to->ammo, 16);
+	WriteChangedValues16(writer, powerupbits, to->powerups, 32);
+
+	return WriteDeltaHuffmanEnd(writer.GetBitIndex(), writer.Finish());
+}
+
 void udtMessage::ReadDeltaPlayerDM3(idPlayerStateBase* to)
 {
 	const idNetField* field = _playerStateFields;
@@ -2090,8 +2481,24 @@ bool udtMessage::RealReadDeltaPlayer(const idPlayerStateBase* from, idPlayerStat
 	}
 
 	const idNetField* field;
-	for(i = 0, field = _playerStateFields; i < lc; i++, field++)
+	i = 0;
+	while(i < lc)
 	{
+		// Each unchanged field is a single 0 bit: skip entire runs at once.
+		// There's nothing to copy since 'to' starts off as a copy of 'from'.
+		if(Buffer.valid && !Buffer.oob && Buffer.bit + 64 <= (Buffer.cursize + 4) * 8)
+		{
+			const s32 unchangedCount = udt_min(GetZeroBitRunLength(Buffer.data, Buffer.bit), lc - i);
+			Buffer.bit += unchangedCount;
+			Buffer.readcount = (Buffer.bit >> 3) + 1;
+			i += unchangedCount;
+			if(i == lc)
+			{
+				break;
+			}
+		}
+
+		field = &_playerStateFields[i++];
 		fromF = (s32 *)((u8 *)from + field->offset);
 		toF = (s32 *)((u8 *)to + field->offset);
 
@@ -2379,6 +2786,84 @@ bool udtMessage::RealWriteDeltaEntity(const idEntityStateBase* from, const idEnt
 	return ValidState();
 }
 
+template<const idNetField* Fields, s32 FieldCount>
+bool udtMessage::WriteDeltaEntityHuffman(const idEntityStateBase* from, const idEntityStateBase* to, bool force)
+{
+	static_assert(FieldCount <= 64, "The changed field mask has 64 bits");
+
+	// Removals, invalid numbers and missing sources are rare enough.
+	if(from == NULL || to == NULL || to->number < 0 || to->number >= MAX_GENTITIES)
+	{
+		return RealWriteDeltaEntity(from, to, force);
+	}
+
+	// Every field is a 32-bit word after "number", so a single wide compare
+	// spots entities that didn't change at all.
+	u64 changedFields = 0;
+	if(memcmp((const u8*)from + sizeof(s32), (const u8*)to + sizeof(s32), _protocolSizeOfEntityState - sizeof(s32)) != 0)
+	{
+		for(s32 i = 0; i < FieldCount; ++i)
+		{
+			const s32 offset = Fields[i].offset;
+			changedFields |= (u64)(*(const s32*)((const u8*)from + offset) != *(const s32*)((const u8*)to + offset)) << i;
+		}
+	}
+
+	if(changedFields == 0 && !force)
+	{
+		return ValidState(); // nothing at all
+	}
+
+	udtHuffmanDeltaWriter writer(Buffer.data, Buffer.maxsize, Buffer.bit);
+	writer.WriteBits(to->number, GENTITYNUM_BITS);
+	writer.WriteBit(0); // not removed
+	if(changedFields == 0)
+	{
+		writer.WriteBit(0); // no delta
+		return WriteDeltaHuffmanEnd(writer.GetBitIndex(), writer.Finish());
+	}
+
+	writer.WriteBit(1); // we have a delta
+	const s32 lc = (s32)GetHighestSetBitIndex(changedFields) + 1;
+	writer.WriteBits(lc, 8); // # of changes
+	for(s32 i = 0; i < lc; ++i)
+	{
+		if((changedFields & ((u64)1 << (u64)i)) == 0)
+		{
+			writer.WriteBit(0);
+			continue;
+		}
+
+		writer.WriteBit(1);
+		const s32 value = *(const s32*)((const u8*)to + Fields[i].offset);
+		if(value == 0)
+		{
+			writer.WriteBit(0);
+			continue;
+		}
+
+		writer.WriteBit(1);
+		writer.WriteField(value, Fields[i].bits);
+	}
+
+	return WriteDeltaHuffmanEnd(writer.GetBitIndex(), writer.Finish());
+}
+
+bool udtMessage::WriteDeltaHuffmanEnd(s32 bitIndex, bool success)
+{
+	if(!success)
+	{
+		Context->LogError("udtMessage::WriteDeltaHuffman: Overflowed! (in file: %s)", GetFileNamePtr());
+		SetValid(false);
+		return false;
+	}
+
+	Buffer.bit = bitIndex;
+	Buffer.cursize = (bitIndex >> 3) + 1;
+
+	return true;
+}
+
 /*
 The entity number has already been read from the message, which
 is how the from state is identified.
@@ -2544,6 +3029,121 @@ bool udtMessage::RealReadDeltaEntity(bool& addedOrChanged, const idEntityStateBa
 	return ValidState();
 }
 
+template<const idNetField* Fields, s32 FieldCount>
+bool udtMessage::ReadDeltaEntityHuffman(bool& addedOrChanged, const idEntityStateBase* from, idEntityStateBase* to, s32 number)
+{
+	if(number < 0 || number >= MAX_GENTITIES) 
+	{
+		Context->LogError("udtMessage::ReadDeltaEntityHuffman: Bad delta entity number: %d (max is %d) (in file: %s)", number, MAX_GENTITIES - 1, GetFileNamePtr());
+		SetValid(false);
+		return false;
+	}
+
+	const u8* const data = Buffer.data;
+	const s32 maxBitIndex = (Buffer.cursize + 4) * 8; // See RealReadBits.
+	s32 bitIndex = Buffer.bit;
+
+	// check for a remove
+	if(HuffmanReadBit(data, bitIndex) == 1) 
+	{
+		Com_Memset(to, 0, _protocolSizeOfEntityState);
+		to->number = MAX_GENTITIES - 1;
+		addedOrChanged = false;
+		return ReadDeltaEntityHuffmanEnd(bitIndex, true);
+	}
+
+	// check for no delta
+	if(HuffmanReadBit(data, bitIndex) == 0) 
+	{
+		Com_Memcpy(to, from, _protocolSizeOfEntityState);
+		to->number = number;
+		addedOrChanged = false;
+		return ReadDeltaEntityHuffmanEnd(bitIndex, true);
+	}
+
+	addedOrChanged = true;
+
+	s32 fieldCount = 0;
+	if(!HuffmanReadBits(fieldCount, data, bitIndex, 8, maxBitIndex))
+	{
+		return ReadDeltaEntityHuffmanEnd(bitIndex, false);
+	}
+
+	if(fieldCount > FieldCount)
+	{
+		Context->LogError("udtMessage::ReadDeltaEntityHuffman: Invalid entityState field count: %d (max is %d) (in file: %s)", fieldCount, FieldCount, GetFileNamePtr());
+		SetValid(false);
+		return false;
+	}
+
+	to->number = number;
+
+	s32 i = 0;
+	while(i < fieldCount) 
+	{
+		// Each unchanged field is a single 0 bit: skip entire runs at once.
+		if(bitIndex + 64 <= maxBitIndex)
+		{
+			const s32 unchangedCount = udt_min(GetZeroBitRunLength(data, bitIndex), fieldCount - i);
+			for(s32 j = i, end = i + unchangedCount; j < end; ++j)
+			{
+				const idNetField& field = Fields[j];
+				*(s32*)((u8*)to + field.offset) = *(const s32*)((const u8*)from + field.offset);
+			}
+			bitIndex += unchangedCount;
+			i += unchangedCount;
+			if(i == fieldCount)
+			{
+				break;
+			}
+		}
+
+		const idNetField& field = Fields[i++];
+		const s32* const fromF = (const s32*)((const u8*)from + field.offset);
+		s32* const toF = (s32*)((u8*)to + field.offset);
+
+		if(HuffmanReadBit(data, bitIndex) == 0) 
+		{
+			*toF = *fromF;
+			continue;
+		} 
+
+		if(HuffmanReadBit(data, bitIndex) == 0)
+		{
+			*toF = 0;
+			continue;
+		}
+
+		if(!HuffmanReadField(*toF, data, bitIndex, field.bits, maxBitIndex))
+		{
+			return ReadDeltaEntityHuffmanEnd(bitIndex, false);
+		}
+	}
+
+	for(s32 i = fieldCount; i < FieldCount; i++)
+	{
+		const idNetField& field = Fields[i];
+		const s32* const fromF = (const s32*)((const u8*)from + field.offset);
+		s32* const toF = (s32*)((u8*)to + field.offset);
+		*toF = *fromF;
+	}
+
+	return ReadDeltaEntityHuffmanEnd(bitIndex, true);
+}
+
+bool udtMessage::ReadDeltaEntityHuffmanEnd(s32 bitIndex, bool success)
+{
+	Buffer.bit = bitIndex;
+	Buffer.readcount = (bitIndex >> 3) + 1;
+	if(!success)
+	{
+		Context->LogError("udtMessage::ReadDeltaEntityHuffman: Overflowed! (in file: %s)", GetFileNamePtr());
+		SetValid(false);
+	}
+
+	return success;
+}
+
 void udtMessage::SetValid(bool valid)
 {
 	Buffer.valid = valid;
@@ -2555,13 +3155,13 @@ void udtMessage::SetValid(bool valid)
 		_readString = &udtMessage::RealReadString;
 		_readData = &udtMessage::RealReadData;
 		_peekByte = &udtMessage::RealPeekByte;
-		_readDeltaEntity = &udtMessage::RealReadDeltaEntity;
+		_readDeltaEntity = Buffer.oob ? &udtMessage::RealReadDeltaEntity : _readDeltaEntityHuffman;
 		_readDeltaPlayer = &udtMessage::RealReadDeltaPlayer;
 		_writeBits = &udtMessage::RealWriteBits;
 		_writeFloat = &udtMessage::RealWriteFloat;
 		_writeString = &udtMessage::RealWriteString;
-		_writeDeltaPlayer = &udtMessage::RealWriteDeltaPlayer;
-		_writeDeltaEntity = &udtMessage::RealWriteDeltaEntity;
+		_writeDeltaPlayer = Buffer.oob ? &udtMessage::RealWriteDeltaPlayer : _writeDeltaPlayerHuffman;
+		_writeDeltaEntity = Buffer.oob ? &udtMessage::RealWriteDeltaEntity : _writeDeltaEntityHuffman;
 	}
 	else
 	{
@@ -5,6 +5,12 @@
 #include "context.hpp"
 
 
+// Builds the multi-symbol Huffman decoder table. Called once by udtInitLibrary.
+extern void BuildHuffmanLookUpTables();
+
+// The number of bytes past cursize that udtMessage::RealReadBits might access.
+#define UDT_MESSAGE_READ_PADDING 16
+
 struct idMessage
 {
 	u8*  data;
@@ -47,6 +53,7 @@ public:
 	void  WriteBigString(const char* s, s32 length) { (this->*_writeString)(s, length, (s32)sizeof(Context->ReadBigStringBuffer), Context->ReadBigStringBuffer); } // The string must be null-terminated.
 	bool  WriteDeltaPlayer(const idPlayerStateBase* from, idPlayerStateBase* to) { return (this->*_writeDeltaPlayer)(from, to); }
 	bool  WriteDeltaEntity(const idEntityStateBase* from, const idEntityStateBase* to, bool force) { return (this->*_writeDeltaEntity)(from, to, force); }
+	void  WriteHuffmanBits(const u8* source, s32 firstBit, s32 bitCount); // Copies bits of a Huffman-compressed message verbatim.
 
 	// Functions with return type s32: -1 is returned when the state has become invalid.
 	s32   ReadBits(s32 bits) { return (this->*_readBits)(bits); }
@@ -91,6 +98,18 @@ private:
 	bool  RealReadDeltaEntity(bool& addedOrChanged, const idEntityStateBase* from, idEntityStateBase* to, s32 number);
 	bool  RealReadDeltaPlayer(const idPlayerStateBase* from, idPlayerStateBase* to);
 
+	// Specialized for a given field table, only valid when Huffman compression is on.
+	template<const idNetField* Fields, s32 FieldCount>
+	bool  ReadDeltaEntityHuffman(bool& addedOrChanged, const idEntityStateBase* from, idEntityStateBase* to, s32 number);
+	bool  ReadDeltaEntityHuffmanEnd(s32 bitIndex, bool success);
+
+	// Specialized for a given field table, only valid when Huffman compression is on.
+	template<const idNetField* Fields, s32 FieldCount>
+	bool  WriteDeltaEntityHuffman(const idEntityStateBase* from, const idEntityStateBase* to, bool force);
+	template<const idNetField* Fields, s32 FieldCount>
+	bool  WriteDeltaPlayerHuffman(const idPlayerStateBase* from, idPlayerStateBase* to); // Not for RTCW protocols.
+	bool  WriteDeltaHuffmanEnd(s32 bitIndex, bool success);
+
 	void  RealWriteBits(s32 value, s32 bits);
 	void  RealWriteFloat(s32 c);
 	void  RealWriteString(const char* s, s32 length, s32 bufferLength, char* buffer);
@@ -136,10 +155,13 @@ private:
 	ReadDataFunc         _readData;
 	PeekByteFunc         _peekByte;
 	ReadDeltaEntityFunc  _readDeltaEntity;
+	ReadDeltaEntityFunc  _readDeltaEntityHuffman; // Selected by protocol.
 	ReadDeltaPlayerFunc  _readDeltaPlayer;
 	WriteBitsFunc        _writeBits;
 	WriteFloatFunc       _writeFloat;
 	WriteStringFunc      _writeString;
 	WriteDeltaPlayerFunc _writeDeltaPlayer;
+	WriteDeltaPlayerFunc _writeDeltaPlayerHuffman; // Selected by protocol.
 	WriteDeltaEntityFunc _writeDeltaEntity;
+	WriteDeltaEntityFunc _writeDeltaEntityHuffman; // Selected by protocol.
 };
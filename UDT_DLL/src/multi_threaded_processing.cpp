@@ -6,46 +6,113 @@
 #include "system.hpp"
 #include "timer.hpp"
 #include "api_helpers.hpp"
+#include "game_state_scanner.hpp"
+#include "pattern_search_context.hpp"
 
 #include <stdlib.h>
 #include <assert.h>
-
-
-#define    UDT_MIN_BYTE_SIZE_PER_THREAD    ((u64)(6 * (1<<20)))
-#define    UDT_MAX_THREAD_COUNT            (16)
+#include <new>
 
 
 struct FileInfo
 {
 	u64 ByteCount;
 	const char* FilePath;
-	u32 ThreadIdx;
+	udtDemoSegment Segment; // GameStateIndex is -1 for whole files.
 	u32 InputIdx;
 };
 
 static int SortByFileSizesDescending(const void* aPtr, const void* bPtr)
 {
-	const u64 a = ((FileInfo*)aPtr)->ByteCount;
-	const u64 b = ((FileInfo*)bPtr)->ByteCount;
+	const FileInfo& a = *(const FileInfo*)aPtr;
+	const FileInfo& b = *(const FileInfo*)bPtr;
+	if(a.ByteCount == b.ByteCount)
+	{
+		const int byInput = (int)a.InputIdx - (int)b.InputIdx;
+
+		return byInput != 0 ? byInput : (int)(a.Segment.GameStateIndex - b.Segment.GameStateIndex);
+	}
 
-	return (int)(b - a);
+	return a.ByteCount < b.ByteCount ? 1 : -1;
 }
 
-static int SortByThreadIndexAscending(const void* aPtr, const void* bPtr)
+static void SplitAtGameStates(udtVMArray<FileInfo>& items, u64 minByteCount)
 {
-	const u32 a = ((FileInfo*)aPtr)->ThreadIdx;
-	const u32 b = ((FileInfo*)bPtr)->ThreadIdx;
+	// @NOTE: We don't use the standard operator new approach to avoid C++ exceptions.
+	udtGameStateScanner* const scanner = (udtGameStateScanner*)malloc(sizeof(udtGameStateScanner));
+	if(scanner == NULL)
+	{
+		return;
+	}
+	new (scanner) udtGameStateScanner;
+
+	for(u32 i = 0, fileCount = items.GetSize(); i < fileCount; ++i)
+	{
+		// Don't bother with demos that would only give tiny segments.
+		const FileInfo file = items[i];
+		if(file.ByteCount < 2 * minByteCount)
+		{
+			continue;
+		}
+
+		const udtProtocol::Id protocol = (udtProtocol::Id)udtGetProtocolByFilePath(file.FilePath);
+		if(!scanner->ScanFile(file.FilePath, protocol))
+		{
+			continue;
+		}
+
+		const u32 gsCount = scanner->GameStateFileOffsets.GetSize();
+		if(gsCount <= 1)
+		{
+			continue;
+		}
+
+		// The first segment starts at the very beginning, 
+		// so that it reads exactly the same messages as a full parse would.
+		const u32* const offsets = scanner->GameStateFileOffsets.GetStartAddress();
+		for(u32 gs = 0; gs < gsCount; ++gs)
+		{
+			const u32 startOffset = gs == 0 ? 0 : offsets[gs];
+			const u32 endOffset = gs + 1 < gsCount ? offsets[gs + 1] : 0;
+			FileInfo segment = file;
+			segment.Segment.StartOffset = startOffset;
+			segment.Segment.EndOffset = endOffset;
+			segment.Segment.GameStateIndex = (s32)gs;
+			segment.ByteCount = (endOffset > 0 ? (u64)endOffset : file.ByteCount) - (u64)startOffset;
+			if(gs == 0)
+			{
+				items[i] = segment;
+			}
+			else
+			{
+				items.Add(segment);
+			}
+		}
+	}
 
-	return (int)(a - b);
+	scanner->~udtGameStateScanner();
+	free(scanner);
 }
 
 udtDemoThreadAllocator::udtDemoThreadAllocator()
 {
+	TotalByteCount = 0;
 }
 
-bool udtDemoThreadAllocator::Process(const char** filePaths, u32 fileCount, u32 maxThreadCount)
+bool udtDemoThreadAllocator::Process(const udtMultiParseArg& info, udtParsingJobType::Id jobType)
 {
-	if(maxThreadCount <= 1 || fileCount <= 1)
+	const char** const filePaths = info.FilePaths;
+	const u32 fileCount = info.FileCount;
+	u32 maxThreadCount = info.MaxThreadCount;
+	if(info.ThreadPool != NULL)
+	{
+		maxThreadCount = udt_min(maxThreadCount, info.ThreadPool->ThreadCount);
+	}
+
+	const bool splitDemos = 
+		(info.Flags & (u32)udtMultiParseArgFlag::SplitAtGameStates) != 0 && 
+		CanProcessDemoSegments(jobType);
+	if(maxThreadCount <= 1 || (fileCount <= 1 && !splitDemos))
 	{
 		return false;
 	}
@@ -67,88 +134,75 @@ bool udtDemoThreadAllocator::Process(const char** filePaths, u32 fileCount, u32
 		const u64 byteCount = udtFileStream::GetFileLength(filePaths[i]);
 		files[i].FilePath = filePaths[i];
 		files[i].ByteCount = byteCount;
-		files[i].ThreadIdx = (u32)-1;
+		files[i].Segment.StartOffset = 0;
+		files[i].Segment.EndOffset = 0;
+		files[i].Segment.GameStateIndex = -1;
 		files[i].InputIdx = i;
 		totalByteCount += byteCount;
 	}
 
-	if(totalByteCount < 2 * UDT_MIN_BYTE_SIZE_PER_THREAD)
+	const u64 minByteCountPerThread = info.MinByteCountPerThread > 0 ? 
+		(u64)info.MinByteCountPerThread : 
+		(u64)UDT_DEFAULT_MIN_BYTE_COUNT_PER_THREAD;
+	if(totalByteCount < 2 * minByteCountPerThread)
+	{
+		return false;
+	}
+
+	if(splitDemos)
+	{
+		SplitAtGameStates(files, minByteCountPerThread);
+	}
+
+	const u32 itemCount = files.GetSize();
+	if(itemCount <= 1)
 	{
 		return false;
 	}
 
 	// Prepare the final thread array.
-	maxThreadCount = udt_min(maxThreadCount, (u32)UDT_MAX_THREAD_COUNT);
 	maxThreadCount = udt_min(maxThreadCount, processorCoreCount);
-	maxThreadCount = udt_min(maxThreadCount, fileCount);
-	const u32 finalThreadCount = udt_min(maxThreadCount, (u32)(totalByteCount / UDT_MIN_BYTE_SIZE_PER_THREAD));
+	maxThreadCount = udt_min(maxThreadCount, itemCount);
+	const u32 finalThreadCount = (u32)udt_min((u64)maxThreadCount, totalByteCount / minByteCountPerThread);
 	Threads.Resize(finalThreadCount);
 	memset(Threads.GetStartAddress(), 0, (size_t)Threads.GetSize() * sizeof(udtParsingThreadData));
 	for(u32 i = 0; i < finalThreadCount; ++i)
 	{
 		Threads[i].Finished = false;
-		Threads[i].Stop = false;
 		Threads[i].Result = false;
 	}
 
-	// Sort files by size.
-	qsort(files.GetStartAddress(), (size_t)fileCount, sizeof(FileInfo), &SortByFileSizesDescending);
-
-	// Assign files to threads.
-	for(u32 i = 0; i < fileCount; ++i)
-	{
-		u32 threadIdx = 0;
-		u64 smallestThreadByteCount = (u64)-1;
-		for(u32 j = 0; j < finalThreadCount; ++j)
-		{
-			if(Threads[j].TotalByteCount < smallestThreadByteCount)
-			{
-				smallestThreadByteCount = Threads[j].TotalByteCount;
-				threadIdx = j;
-			}
-		}
-
-		Threads[threadIdx].TotalByteCount += files[i].ByteCount;
-		files[i].ThreadIdx = threadIdx;
-	}
-
-	// Sort files by thread index.
-	qsort(files.GetStartAddress(), (size_t)fileCount, sizeof(FileInfo), &SortByThreadIndexAscending);
-	assert(files[0].ThreadIdx == 0); // Ascending order means thread 0 is always first.
-
-	// Build and finalize the arrays.
-	u32 threadIdx = 0;
-	u32 firstFileIdx = 0;
-	FilePaths.Resize(fileCount);
-	FileSizes.Resize(fileCount);
-	InputIndices.Resize(fileCount);
-	for(u32 i = 0; i < fileCount; ++i)
+	// The threads don't get files assigned up front: 
+	// they pull them from the queue as they go, so that one slow demo doesn't leave the others idle.
+	// Handing out the largest files first keeps the small ones around to fill in the tail end.
+	qsort(files.GetStartAddress(), (size_t)itemCount, sizeof(FileInfo), &SortByFileSizesDescending);
+
+	TotalByteCount = totalByteCount;
+	FilePaths.Resize(itemCount);
+	FileSizes.Resize(itemCount);
+	InputIndices.Resize(itemCount);
+	ErrorCodes.Resize(itemCount);
+	Segments.Resize(itemCount > fileCount ? itemCount : 0);
+	for(u32 i = 0; i < itemCount; ++i)
 	{
-		if(files[i].ThreadIdx != threadIdx)
-		{
-			assert(threadIdx < Threads.GetSize());
-			Threads[threadIdx].FirstFileIndex = firstFileIdx;
-			Threads[threadIdx].FileCount = i - firstFileIdx;
-			firstFileIdx = i;
-			++threadIdx;
-		}
-
 		FilePaths[i] = files[i].FilePath;
 		FileSizes[i] = files[i].ByteCount;
 		InputIndices[i] = files[i].InputIdx;
+		ErrorCodes[i] = (s32)udtErrorCode::Unprocessed;
+	}
+	for(u32 i = 0, count = Segments.GetSize(); i < count; ++i)
+	{
+		Segments[i] = files[i].Segment;
 	}
-	Threads[threadIdx].FirstFileIndex = firstFileIdx;
-	Threads[threadIdx].FileCount = fileCount - firstFileIdx;
 	
 	return true;
 }
 
 struct MultiThreadedProgressContext
 {
-	u64 TotalByteCount;
 	u64 ProcessedByteCount;
 	u64 CurrentJobByteCount;
-	f32* Progress;
+	u64* ThreadProcessedByteCount;
 	udtTimer* Timer;
 	u32 MinProgressTimeMs;
 };
@@ -156,7 +210,7 @@ struct MultiThreadedProgressContext
 static void MultiThreadedProgressProgressCallback(f32 jobProgress, void* userData)
 {
 	MultiThreadedProgressContext* const context = (MultiThreadedProgressContext*)userData;
-	if(context == NULL || context->Timer == NULL || context->Progress == NULL)
+	if(context == NULL || context->Timer == NULL || context->ThreadProcessedByteCount == NULL)
 	{
 		return;
 	}
@@ -168,11 +222,9 @@ static void MultiThreadedProgressProgressCallback(f32 jobProgress, void* userDat
 
 	context->Timer->Restart();
 
-	const u64 jobProcessed = (u64)((f64)context->CurrentJobByteCount * (f64)jobProgress);
-	const u64 totalProcessed = context->ProcessedByteCount + jobProcessed;
-	const f32 realProgress = udt_clamp((f32)totalProcessed / (f32)context->TotalByteCount, 0.0f, 1.0f);
+	const u64 jobProcessed = (u64)((f64)context->CurrentJobByteCount * (f64)udt_clamp(jobProgress, 0.0f, 1.0f));
 
-	*context->Progress = realProgress;
+	*context->ThreadProcessedByteCount = context->ProcessedByteCount + jobProcessed;
 }
 
 static void ThreadFunction(void* userData)
@@ -202,57 +254,77 @@ static void ThreadFunction(void* userData)
 		return;
 	}
 
-	const u32 startIdx = data->FirstFileIndex;
-	const u32 endIdx = startIdx + data->FileCount;
+	udtTimer busyTimer;
+	busyTimer.Start();
 
 	udtTimer timer;
 	timer.Start();
 
 	MultiThreadedProgressContext progressContext;
-	progressContext.TotalByteCount = data->TotalByteCount;
 	progressContext.ProcessedByteCount = 0;
 	progressContext.CurrentJobByteCount = 0;
+	progressContext.ThreadProcessedByteCount = &data->ProcessedByteCount;
 	progressContext.Timer = &timer;
-	progressContext.Progress = &data->Progress;
 	progressContext.MinProgressTimeMs = shared->ParseInfo->MinProgressTimeMs;
 
 	udtParseArg newParseInfo = *shared->ParseInfo;
 	newParseInfo.ProgressCb = &MultiThreadedProgressProgressCallback;
 	newParseInfo.ProgressContext = &progressContext;
 
-	s32* const errorCodes = shared->MultiParseInfo->OutputErrorCodes;
+	const void* const jobSpecificInfo = data->JobSpecificInfo != NULL ? data->JobSpecificInfo : shared->JobSpecificInfo;
 
-	if(!InitContextWithPlugIns(*data->Context, newParseInfo, data->FileCount, (udtParsingJobType::Id)shared->JobType, shared->JobSpecificInfo))
+	// We don't know yet how many demos this thread will end up processing.
+	// The context might have been used by a previous job of a thread pool.
+	udtParserContext* const context = data->Context;
+	context->ResetForNextDemo(false);
+	if(!InitContextWithPlugIns(*context, newParseInfo, shared->FileCount, (udtParsingJobType::Id)shared->JobType, jobSpecificInfo))
 	{
 		data->Result = false;
 		data->Finished = true;
 		return;
 	}
 
+	context->InputIndices.Clear();
+
 	u64 actualProcessedByteCount = 0;
-	for(u32 i = startIdx; i < endIdx; ++i)
+	for(;;)
 	{
 		if(shared->ParseInfo->CancelOperation != NULL && *shared->ParseInfo->CancelOperation != 0)
 		{
 			break;
 		}
 
-		const u32 originalInputIdx = data->Context->InputIndices[i - startIdx];
+		const u32 i = AtomicIncrement(&shared->NextFileIndex) - 1;
+		if(i >= shared->FileCount)
+		{
+			break;
+		}
+
+		const u32 contextDemoIdx = context->InputIndices.GetSize();
+		const u32 originalInputIdx = shared->InputIndices[i];
+		context->InputIndices.Add(originalInputIdx);
+
 		const u64 currentJobByteCount = shared->FileSizes[i];
 		progressContext.CurrentJobByteCount = currentJobByteCount;
 
 		const udtParsingJobType::Id jobType = (udtParsingJobType::Id)shared->JobType;
-		const bool success = ProcessSingleDemoFile(jobType, data->Context, i - startIdx, originalInputIdx, &newParseInfo, shared->FilePaths[i], shared->JobSpecificInfo);
-		errorCodes[originalInputIdx] = GetErrorCode(success, shared->ParseInfo->CancelOperation);
+		const udtDemoSegment* const segment = 
+			(shared->Segments != NULL && shared->Segments[i].GameStateIndex >= 0) ? 
+			&shared->Segments[i] : 
+			NULL;
+		const bool success = ProcessSingleDemoFile(jobType, context, contextDemoIdx, originalInputIdx, &newParseInfo, shared->FilePaths[i], jobSpecificInfo, segment);
+		shared->ErrorCodes[i] = GetErrorCode(success, shared->ParseInfo->CancelOperation);
 
 		progressContext.ProcessedByteCount += currentJobByteCount;
+		data->ProcessedByteCount = progressContext.ProcessedByteCount;
 		if(success)
 		{
 			actualProcessedByteCount += currentJobByteCount;
 		}
 	}
 
-	data->Context->UpdatePlugInBufferStructs();
+	context->DemoCount = context->InputIndices.GetSize();
+	context->UpdatePlugInBufferStructs();
 	
 	if(data->Shared->ParseInfo->PerformanceStats != NULL)
 	{
@@ -260,67 +332,169 @@ static void ThreadFunction(void* userData)
 	}
 
 #if defined(UDT_DEBUG) && defined(UDT_LOG_ALLOCATOR_DEBUG_STATS)
-	data->Context->Parser._tempAllocator.Clear();
-	LogLinearAllocatorDebugStats(data->Context->Context, data->Context->Parser._tempAllocator);
+	context->Parser._tempAllocator.Clear();
+	LogLinearAllocatorDebugStats(context->Context, context->Parser._tempAllocator);
 #endif
 
+	data->BusyTimeUs = busyTimer.GetElapsedUs();
 	data->Result = true;
 	data->Finished = true;
 }
 
-bool udtMultiThreadedParsing::Process(udtTimer& jobTimer, 
-									  udtParserContext* contexts,
-									  udtDemoThreadAllocator& threadInfo,
-									  const udtParseArg* parseInfo,
-									  const udtMultiParseArg* multiParseInfo,
-									  udtParsingJobType::Id jobType,
-									  const void* jobSpecificInfo)
+static void ThreadPoolWorkerFunction(void* userData)
 {
-	assert(contexts != NULL);
-	assert(parseInfo != NULL);
-	assert(multiParseInfo != NULL);
-	assert(jobType < (u32)udtParsingJobType::Count);
+	udtThreadPoolWorker* const worker = (udtThreadPoolWorker*)userData;
+	if(worker == NULL)
+	{
+		return;
+	}
 
-	if(parseInfo->PerformanceStats != NULL)
+	udtThreadPool_s* const pool = worker->Pool;
+	for(;;)
 	{
-		PerfStatsInit(parseInfo->PerformanceStats);
+		if(!worker->StartSignal.Wait() || pool->Quit)
+		{
+			break;
+		}
+
+		ThreadFunction(worker->Data);
+		pool->DoneSignal.Post();
 	}
+}
 
-	const u32 threadCount = threadInfo.Threads.GetSize();
+udtThreadPool_s::udtThreadPool_s()
+{
+	Contexts = NULL;
+	Workers = NULL;
+	ThreadCount = 0;
+	JobCount = 0;
+	Quit = false;
+}
 
-	udtParsingSharedData sharedData;
-	memset(&sharedData, 0, sizeof(sharedData));
-	sharedData.JobSpecificInfo = jobSpecificInfo;
-	sharedData.MultiParseInfo = multiParseInfo;
-	sharedData.ParseInfo = parseInfo;
-	sharedData.FilePaths = threadInfo.FilePaths.GetStartAddress();
-	sharedData.FileSizes = threadInfo.FileSizes.GetStartAddress();
-	sharedData.JobType = (u32)jobType;
-	
-	for(u32 i = 0, count = multiParseInfo->FileCount; i < count; ++i)
+udtThreadPool_s::~udtThreadPool_s()
+{
+	Destroy();
+}
+
+bool udtThreadPool_s::Init(u32 threadCount)
+{
+	if(threadCount == 0 || Workers != NULL)
 	{
-		multiParseInfo->OutputErrorCodes[i] = (s32)udtErrorCode::Unprocessed;
+		return false;
+	}
+
+	// @NOTE: We don't use the standard operator new approach to avoid C++ exceptions.
+	Contexts = (udtParserContext*)malloc((size_t)threadCount * sizeof(udtParserContext));
+	Workers = (udtThreadPoolWorker*)malloc((size_t)threadCount * sizeof(udtThreadPoolWorker));
+	if(Contexts == NULL || Workers == NULL || !DoneSignal.Init(0))
+	{
+		free(Contexts);
+		free(Workers);
+		Contexts = NULL;
+		Workers = NULL;
+		return false;
 	}
 
+	Quit = false;
+	for(u32 i = 0; i < threadCount; ++i)
+	{
+		new (Contexts + i) udtParserContext;
+		new (Workers + i) udtThreadPoolWorker;
+		ThreadCount = i + 1;
+
+		udtThreadPoolWorker& worker = Workers[i];
+		worker.Data = NULL;
+		worker.Pool = this;
+		if(!worker.StartSignal.Init(0) ||
+		   !worker.Thread.CreateAndStart(&ThreadPoolWorkerFunction, &worker))
+		{
+			Destroy();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void udtThreadPool_s::Destroy()
+{
+	if(Workers == NULL)
+	{
+		return;
+	}
+
+	Quit = true;
+	for(u32 i = 0; i < ThreadCount; ++i)
+	{
+		Workers[i].StartSignal.Post();
+	}
+
+	for(u32 i = 0; i < ThreadCount; ++i)
+	{
+		udtThreadPoolWorker& worker = Workers[i];
+		worker.Thread.Join();
+		worker.Thread.Release();
+		worker.~udtThreadPoolWorker();
+		Contexts[i].~udtParserContext();
+	}
+
+	DoneSignal.Destroy();
+	free(Workers);
+	free(Contexts);
+	Workers = NULL;
+	Contexts = NULL;
+	ThreadCount = 0;
+}
+
+bool udtThreadPool_s::BeginJob()
+{
+	if(AtomicIncrement(&JobCount) != 1)
+	{
+		AtomicDecrement(&JobCount);
+		return false;
+	}
+
+	return true;
+}
+
+void udtThreadPool_s::EndJob()
+{
+	AtomicDecrement(&JobCount);
+}
+
+static void ReportProgress(udtTimer& progressTimer, const udtDemoThreadAllocator& threadInfo, const udtParseArg* parseInfo)
+{
+	if(progressTimer.GetElapsedMs() < u64(parseInfo->MinProgressTimeMs) || 
+	   parseInfo->ProgressCb == NULL)
+	{
+		return;
+	}
+
+	progressTimer.Restart();
+
+	u64 processedByteCount = 0;
+	for(u32 i = 0, count = threadInfo.Threads.GetSize(); i < count; ++i)
+	{
+		processedByteCount += threadInfo.Threads[i].ProcessedByteCount;
+	}
+	const f32 progress = udt_clamp((f32)processedByteCount / (f32)threadInfo.TotalByteCount, 0.0f, 1.0f);
+
+	(*parseInfo->ProgressCb)(progress, parseInfo->ProgressContext);
+}
+
+static bool RunWithNewThreads(udtParserContext* contexts, udtDemoThreadAllocator& threadInfo, udtParsingSharedData& sharedData, const udtParseArg* parseInfo)
+{
 	udtTimer progressTimer;
 	progressTimer.Start();
 
+	const u32 threadCount = threadInfo.Threads.GetSize();
 	const u32 minProgressTimeMs = parseInfo->MinProgressTimeMs;
 	bool success = true;
 	udtVMArray<udtThread> threads("MultiThreadedParsing::Process::ThreadsArray");
 	threads.Resize(threadCount);
 	for(u32 i = 0; i < threadCount; ++i)
 	{
-		udtParserContext* const context = contexts + i;
 		udtParsingThreadData& threadData = threadInfo.Threads[i];
-		const u32 demoCount = threadData.FileCount;
-		const u32 firstDemoIdx = threadData.FirstFileIndex;
-		context->InputIndices.Resize(demoCount);
-		for(u32 j = 0; j < demoCount; ++j)
-		{
-			context->InputIndices[j] = threadInfo.InputIndices[firstDemoIdx + j];
-		}
-
 		udtThread& thread = threads[i];
 		new (&thread) udtThread;
 		threadData.Context = contexts + i;
@@ -356,21 +530,7 @@ bool udtMultiThreadedParsing::Process(udtTimer& jobTimer,
 			data.Finished = true;
 		}
 
-		if(progressTimer.GetElapsedMs() < u64(minProgressTimeMs))
-		{
-			continue;
-		}
-
-		progressTimer.Restart();
-
-		// The actual progress is that of the slowest thread.
-		f32 progress = 2.0f;
-		for(u32 i = 0; i < threadCount; ++i)
-		{
-			progress = udt_min(progress, threadInfo.Threads[i].Progress);
-		}
-
-		(*parseInfo->ProgressCb)(progress, parseInfo->ProgressContext);
+		ReportProgress(progressTimer, threadInfo, parseInfo);
 	}
 	
 	// If the above code is correct and never fails, this is redundant.
@@ -385,10 +545,210 @@ thread_clean_up:
 		threads[i].Release();
 	}
 
+	return success;
+}
+
+static bool RunWithThreadPool(udtThreadPool_s& threadPool, udtParserContext* contexts, udtDemoThreadAllocator& threadInfo, udtParsingSharedData& sharedData, const udtParseArg* parseInfo)
+{
+	udtTimer progressTimer;
+	progressTimer.Start();
+
+	const u32 threadCount = threadInfo.Threads.GetSize();
+	assert(threadCount <= threadPool.ThreadCount);
+
+	// The workers are already running, we just hand them the job.
+	bool success = true;
+	u32 startedCount = 0;
+	for(u32 i = 0; i < threadCount; ++i)
+	{
+		udtParsingThreadData& threadData = threadInfo.Threads[i];
+		threadData.Context = contexts + i;
+		threadData.Shared = &sharedData;
+		threadPool.Workers[i].Data = &threadData;
+		if(!threadPool.Workers[i].StartSignal.Post())
+		{
+			success = false;
+			break;
+		}
+		++startedCount;
+	}
+
+	u32 doneCount = 0;
+	while(doneCount < startedCount)
+	{
+		if(threadPool.DoneSignal.TimedWait(parseInfo->MinProgressTimeMs))
+		{
+			++doneCount;
+		}
+
+		ReportProgress(progressTimer, threadInfo, parseInfo);
+	}
+
+	return success;
+}
+
+struct PatternMatch
+{
+	udtPatternMatch Match;
+	u32 Order; // qsort isn't guaranteed to be stable, so we work around that.
+};
+
+static int SortByDemoAndGameStateAscending(const void* aPtr, const void* bPtr)
+{
+	const PatternMatch& a = *(const PatternMatch*)aPtr;
+	const PatternMatch& b = *(const PatternMatch*)bPtr;
+	if(a.Match.DemoInputIndex != b.Match.DemoInputIndex)
+	{
+		return a.Match.DemoInputIndex < b.Match.DemoInputIndex ? -1 : 1;
+	}
+
+	if(a.Match.GameStateIndex != b.Match.GameStateIndex)
+	{
+		return a.Match.GameStateIndex < b.Match.GameStateIndex ? -1 : 1;
+	}
+
+	return (int)a.Order - (int)b.Order;
+}
+
+// Each thread gets its own match list and the lists are merged in input order at the end,
+// which gives the same result as processing the demos one after the other.
+static void MergePatternMatches(udtPatternSearchContext_s& searchContext, const udtPatternSearchContext_s* threadContexts, u32 threadCount)
+{
+	udtVMArray<PatternMatch> matches("MultiThreadedParsing::MergePatternMatches::MatchesArray");
+	for(u32 i = 0; i < threadCount; ++i)
+	{
+		const udtVMArray<udtPatternMatch>& threadMatches = threadContexts[i].Matches;
+		for(u32 j = 0, count = threadMatches.GetSize(); j < count; ++j)
+		{
+			PatternMatch match;
+			match.Match = threadMatches[j];
+			match.Order = matches.GetSize();
+			matches.Add(match);
+		}
+	}
+
+	const u32 matchCount = matches.GetSize();
+	qsort(matches.GetStartAddress(), (size_t)matchCount, sizeof(PatternMatch), &SortByDemoAndGameStateAscending);
+	for(u32 i = 0; i < matchCount; ++i)
+	{
+		searchContext.Matches.Add(matches[i].Match);
+	}
+}
+
+// A demo processed as multiple segments only gets a success code if all its segments were processed successfully.
+static void MergeErrorCodes(const udtMultiParseArg& multiParseInfo, const udtDemoThreadAllocator& threadInfo)
+{
+	s32* const outputErrorCodes = multiParseInfo.OutputErrorCodes;
+	for(u32 i = 0, count = multiParseInfo.FileCount; i < count; ++i)
+	{
+		outputErrorCodes[i] = (s32)udtErrorCode::None;
+	}
+
+	for(u32 i = 0, count = threadInfo.ErrorCodes.GetSize(); i < count; ++i)
+	{
+		const u32 inputIdx = threadInfo.InputIndices[i];
+		if(outputErrorCodes[inputIdx] == (s32)udtErrorCode::None)
+		{
+			outputErrorCodes[inputIdx] = threadInfo.ErrorCodes[i];
+		}
+	}
+}
+
+bool udtMultiThreadedParsing::Process(udtTimer& jobTimer, 
+									  udtParserContext* contexts,
+									  udtDemoThreadAllocator& threadInfo,
+									  const udtParseArg* parseInfo,
+									  const udtMultiParseArg* multiParseInfo,
+									  udtParsingJobType::Id jobType,
+									  const void* jobSpecificInfo)
+{
+	assert(contexts != NULL);
+	assert(parseInfo != NULL);
+	assert(multiParseInfo != NULL);
+	assert(jobType < (u32)udtParsingJobType::Count);
+
+	if(parseInfo->PerformanceStats != NULL)
+	{
+		PerfStatsInit(parseInfo->PerformanceStats);
+	}
+
+	const u32 threadCount = threadInfo.Threads.GetSize();
+
+	udtParsingSharedData sharedData;
+	memset(&sharedData, 0, sizeof(sharedData));
+	sharedData.JobSpecificInfo = jobSpecificInfo;
+	sharedData.MultiParseInfo = multiParseInfo;
+	sharedData.ParseInfo = parseInfo;
+	sharedData.FilePaths = threadInfo.FilePaths.GetStartAddress();
+	sharedData.FileSizes = threadInfo.FileSizes.GetStartAddress();
+	sharedData.InputIndices = threadInfo.InputIndices.GetStartAddress();
+	sharedData.Segments = threadInfo.Segments.IsEmpty() ? NULL : threadInfo.Segments.GetStartAddress();
+	sharedData.ErrorCodes = threadInfo.ErrorCodes.GetStartAddress();
+	sharedData.FileCount = threadInfo.FilePaths.GetSize();
+	sharedData.NextFileIndex = 0;
+	sharedData.JobType = (u32)jobType;
+	
+	for(u32 i = 0, count = multiParseInfo->FileCount; i < count; ++i)
+	{
+		multiParseInfo->OutputErrorCodes[i] = (s32)udtErrorCode::Unprocessed;
+	}
+
+	udtPatternSearchContext_s* threadSearchContexts = NULL;
+	if(jobType == udtParsingJobType::FindPatterns)
+	{
+		// @NOTE: We don't use the standard operator new approach to avoid C++ exceptions.
+		const udtPatternSearchContext_s* const searchContext = (const udtPatternSearchContext_s*)jobSpecificInfo;
+		threadSearchContexts = (udtPatternSearchContext_s*)malloc((size_t)threadCount * sizeof(udtPatternSearchContext_s));
+		if(threadSearchContexts == NULL)
+		{
+			return false;
+		}
+
+		for(u32 i = 0; i < threadCount; ++i)
+		{
+			new (threadSearchContexts + i) udtPatternSearchContext_s(searchContext->PatternInfo);
+			threadInfo.Threads[i].JobSpecificInfo = threadSearchContexts + i;
+		}
+	}
+
+	udtThreadPool_s* const threadPool = multiParseInfo->ThreadPool;
+	const bool success = threadPool != NULL ?
+		RunWithThreadPool(*threadPool, contexts, threadInfo, sharedData, parseInfo) :
+		RunWithNewThreads(contexts, threadInfo, sharedData, parseInfo);
+
+	MergeErrorCodes(*multiParseInfo, threadInfo);
+
+	if(threadSearchContexts != NULL)
+	{
+		MergePatternMatches(*(udtPatternSearchContext_s*)jobSpecificInfo, threadSearchContexts, threadCount);
+		for(u32 i = 0; i < threadCount; ++i)
+		{
+			threadSearchContexts[i].~udtPatternSearchContext_s();
+		}
+		free(threadSearchContexts);
+	}
+
 	if(success && parseInfo->PerformanceStats != NULL)
 	{
-		PerfStatsAddCurrentThread(parseInfo->PerformanceStats, 0);
-		PerfStatsFinalize(parseInfo->PerformanceStats, threadCount, jobTimer.GetElapsedUs());
+		u64* const perfStats = parseInfo->PerformanceStats;
+		PerfStatsAddCurrentThread(perfStats, 0);
+		PerfStatsFinalize(perfStats, threadCount, jobTimer.GetElapsedUs());
+
+		// How much of the job's duration each thread spent processing demos.
+		const u64 durationUs = perfStats[udtPerfStatsField::Duration];
+		if(durationUs > 0 && threadCount > 0)
+		{
+			u64 totalBusyTimeUs = 0;
+			u64 minBusyTimeUs = (u64)-1;
+			for(u32 i = 0; i < threadCount; ++i)
+			{
+				const u64 busyTimeUs = udt_min(threadInfo.Threads[i].BusyTimeUs, durationUs);
+				totalBusyTimeUs += busyTimeUs;
+				minBusyTimeUs = udt_min(minBusyTimeUs, busyTimeUs);
+			}
+			perfStats[udtPerfStatsField::ThreadUtilization] = (1000 * totalBusyTimeUs) / ((u64)threadCount * durationUs);
+			perfStats[udtPerfStatsField::MinThreadUtilization] = (1000 * minBusyTimeUs) / durationUs;
+		}
 	}
 
 #if defined(UDT_DEBUG) && defined(UDT_LOG_ALLOCATOR_DEBUG_STATS)
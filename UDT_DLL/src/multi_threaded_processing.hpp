@@ -5,41 +5,81 @@
 #include "array.hpp"
 #include "api_helpers.hpp"
 #include "timer.hpp"
+#include "threads.hpp"
 
 
+// The work items are either whole demo files or game state segments of demo files.
 struct udtParsingSharedData
 {
 	const char** FilePaths;
 	u64* FileSizes;
+	const u32* InputIndices;
+	const udtDemoSegment* Segments; // NULL when all items are whole demo files.
+	s32* ErrorCodes; // Merged into udtMultiParseArg::OutputErrorCodes when the job is done.
 	const udtParseArg* ParseInfo;
 	const udtMultiParseArg* MultiParseInfo;
 	const void* JobSpecificInfo;
+	u32 FileCount;
 	u32 JobType; // Of type udtParsingJobType::Id.
+	volatile u32 NextFileIndex; // The shared work queue: threads claim items in order, largest first.
 };
 
 struct udtParsingThreadData
 {
-	u64 TotalByteCount;
+	u64 ProcessedByteCount; // Includes the progress of the file currently being processed.
+	u64 BusyTimeUs;
 	udtParsingSharedData* Shared;
 	udtParserContext* Context;
-	u32 FirstFileIndex;
-	u32 FileCount;
-	f32 Progress;
+	const void* JobSpecificInfo; // Replaces the shared one when not NULL.
 	bool Finished;
-	bool Stop;
 	bool Result;
 };
 
+struct udtThreadPoolWorker
+{
+	udtThread Thread;
+	udtSemaphore StartSignal;
+	udtParsingThreadData* Data; // The job's thread data, set before StartSignal is posted.
+	udtThreadPool_s* Pool;
+};
+
+// Don't ever allocate an instance of this on the stack.
+struct udtThreadPool_s
+{
+	udtThreadPool_s();
+	~udtThreadPool_s();
+
+	bool Init(u32 threadCount);
+	void Destroy();
+	bool BeginJob(); // Returns false if the pool is already running a job.
+	void EndJob();
+
+	udtParserContext* Contexts; // One per worker, kept alive between jobs.
+	udtThreadPoolWorker* Workers;
+	udtSemaphore DoneSignal; // Posted by each worker when it's done with its part of the job.
+	u32 ThreadCount;
+	volatile u32 JobCount;
+	volatile bool Quit;
+
+private:
+	UDT_NO_COPY_SEMANTICS(udtThreadPool_s);
+};
+
 struct udtDemoThreadAllocator
 {
 	udtDemoThreadAllocator();
 
 	// Returns true if more than 1 thread should be launched.
-	bool Process(const char** filePaths, u32 fileCount, u32 maxThreadCount);
+	bool Process(const udtMultiParseArg& info, udtParsingJobType::Id jobType);
+
+	u64 TotalByteCount;
 
+	// Sorted by decreasing item size.
 	udtVMArray<const char*> FilePaths { "DemoThreadAllocator::FilePathsArray" };
 	udtVMArray<u64> FileSizes { "DemoThreadAllocator::FileSizesArray" };
 	udtVMArray<u32> InputIndices { "DemoThreadAllocator::InputIndicesArray" };
+	udtVMArray<udtDemoSegment> Segments { "DemoThreadAllocator::SegmentsArray" }; // Empty unless demos are split at game states.
+	udtVMArray<s32> ErrorCodes { "DemoThreadAllocator::ErrorCodesArray" };
 	udtVMArray<udtParsingThreadData> Threads { "DemoThreadAllocator::ThreadsArray" };
 };
 
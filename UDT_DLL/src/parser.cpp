@@ -16,6 +16,13 @@ udtBaseParser::udtBaseParser()
 
 	UserData = NULL;
 	EnablePlugIns = true;
+	FirstGameStateOnly = false;
+	FirstMatchOnly = false;
+	TimeWindowEnabled = false;
+	TimeWindowStartMs = UDT_S32_MIN;
+	TimeWindowEndMs = UDT_S32_MAX;
+
+	_inConfigStringTable.Init((u32)UDT_COUNT_OF(_inConfigStrings));
 
 	_inFileName = udtString::NewEmptyConstant();
 	_inFilePath = udtString::NewEmptyConstant();
@@ -27,6 +34,8 @@ udtBaseParser::udtBaseParser()
 	_inChecksumFeed = -1;
 	_inParseEntitiesNum = 0;
 	_inGameStateIndex = -1;
+	_inFirstGameStateIndex = 0;
+	_inTimeWindowReached = false;
 	_inServerTime = UDT_S32_MIN;
 	_inLastSnapshotMessageNumber = UDT_S32_MIN;
 
@@ -36,6 +45,7 @@ udtBaseParser::udtBaseParser()
 	_outSnapshotsWritten = 0;
 	_outWriteFirstMessage = false;
 	_outWriteMessage = false;
+	_outFileError = false;
 }
 
 udtBaseParser::~udtBaseParser()
@@ -51,6 +61,11 @@ bool udtBaseParser::Init(udtContext* context, udtProtocol::Id inProtocol, udtPro
 	}
 
 	EnablePlugIns = enablePlugIns;
+	FirstGameStateOnly = false;
+	FirstMatchOnly = false;
+	TimeWindowEnabled = false;
+	TimeWindowStartMs = UDT_S32_MIN;
+	TimeWindowEndMs = UDT_S32_MAX;
 
 	_context = context;
 	_inProtocol = inProtocol;
@@ -67,14 +82,19 @@ bool udtBaseParser::Init(udtContext* context, udtProtocol::Id inProtocol, udtPro
 	_inFilePath = udtString::NewEmptyConstant();
 	_outFileName = udtString::NewEmptyConstant();
 	_outFilePath = udtString::NewEmptyConstant();
+	_outFileError = false;
 
 	_cuts.Clear();
 	_persistentAllocator.Clear();
 	_configStringAllocator.Clear();
+	_inConfigStringTable.Clear();
+	_inPlayerRoster.Clear();
 	_tempAllocator.Clear();
 	_privateTempAllocator.Clear();
 
 	_inGameStateIndex = gameStateIndex - 1;
+	_inFirstGameStateIndex = gameStateIndex;
+	_inTimeWindowReached = false;
 	if(gameStateIndex == 0)
 	{
 		_inGameStateFileOffsets.Clear();
@@ -120,6 +140,8 @@ void udtBaseParser::ResetForGamestateMessage()
 	}
 
 	_configStringAllocator.Clear();
+	_inConfigStringTable.Clear();
+	_inPlayerRoster.Clear();
 	_tempAllocator.Clear();
 	_privateTempAllocator.Clear();
 }
@@ -173,10 +195,15 @@ bool udtBaseParser::ParseServerMessage()
 		info.ReliableSequenceAcknowledge = reliableSequenceAcknowledge;
 		for(u32 i = 0, count = PlugIns.GetSize(); i < count; ++i)
 		{
-			PlugIns[i]->ProcessMessageBundleStart(info, *this);
+			if(PlugIns[i]->ShouldProcess(udtParserPlugInCallback::MessageBundleStart))
+			{
+				PlugIns[i]->ProcessMessageBundleStart(info, *this);
+			}
 		}
 	}
 
+	const bool skipSnapshots = ShouldSkipSnapshots();
+	bool parsedGameState = false;
 	for(;;)
 	{
 		if(_inMsg.Buffer.readcount > _inMsg.Buffer.cursize) 
@@ -212,10 +239,23 @@ bool udtBaseParser::ParseServerMessage()
 			break;
 
 		case svc_gamestate:
+			if(TimeWindowEnabled && _inGameStateIndex >= _inFirstGameStateIndex)
+			{
+				// The time window only applies to the first game state read.
+				return false;
+			}
 			if(!ParseGamestate()) return false;
+			parsedGameState = true;
 			break;
 
 		case svc_snapshot:
+			if(skipSnapshots)
+			{
+				// The server commands come first, there's nothing left we need.
+				ParseSnapshotServerTime();
+				_inMsg.Buffer.readcount = _inMsg.Buffer.cursize;
+				continue;
+			}
 			if(!ParseSnapshot()) return false;
 			break;
 
@@ -243,10 +283,28 @@ bool udtBaseParser::ParseServerMessage()
 		info.ReliableSequenceAcknowledge = reliableSequenceAcknowledge;
 		for(u32 i = 0, count = PlugIns.GetSize(); i < count; ++i)
 		{
-			PlugIns[i]->ProcessMessageBundleEnd(info, *this);
+			if(PlugIns[i]->ShouldProcess(udtParserPlugInCallback::MessageBundleEnd))
+			{
+				PlugIns[i]->ProcessMessageBundleEnd(info, *this);
+			}
 		}
 	}
 
+	if(parsedGameState && FirstGameStateOnly)
+	{
+		// We have everything the header scan needs, we're done parsing the file now.
+		return false;
+	}
+
+	if(_inServerTime != UDT_S32_MIN && IsInTimeWindow())
+	{
+		_inTimeWindowReached = true;
+	}
+	else if(_inTimeWindowReached && _inServerTime > TimeWindowEndMs)
+	{
+		return false;
+	}
+
 	if(_cuts.GetSize() > 0)
 	{
 		const udtCutInfo cut = _cuts[0];
@@ -267,7 +325,10 @@ bool udtBaseParser::ParseServerMessage()
 			_outWriteFirstMessage = false;
 			_outServerCommandSequence = 0;
 			_outSnapshotsWritten = 0;
-			_outFile.Close();
+			if(!CloseOutputFile())
+			{
+				return false;
+			}
 			_cuts.Remove(0);
 			if(_cuts.GetSize() == 0)
 			{
@@ -298,8 +359,11 @@ bool udtBaseParser::ParseServerMessage()
 			info.FilePathAllocator = &_persistentAllocator;
 			filePath = (*cut.StreamCreator)(info);
 		}
-		_outFile.Close();
-		if(_outFile.Open(filePath.GetPtr(), udtFileOpenMode::Write))
+		if(!CloseOutputFile())
+		{
+			return false;
+		}
+		if(_outFile.Open(filePath.GetPtr()))
 		{
 			_outFilePath = filePath;
 			udtPath::GetFileName(_outFileName, _persistentAllocator, filePath);
@@ -330,10 +394,12 @@ void udtBaseParser::FinishParsing(bool /*success*/)
 		_outWriteFirstMessage = false;
 		_outServerCommandSequence = 0;
 		_outSnapshotsWritten = 0;
-		_outFile.Close();
 		_cuts.Clear();
 	}
 
+	// Also closes the file of a cut that was interrupted by a new game state.
+	CloseOutputFile();
+
 	if(EnablePlugIns)
 	{
 		for(u32 i = 0, count = PlugIns.GetSize(); i < count; ++i)
@@ -343,6 +409,21 @@ void udtBaseParser::FinishParsing(bool /*success*/)
 	}
 }
 
+bool udtBaseParser::CloseOutputFile()
+{
+	if(_outFile.Close() == 0)
+	{
+		return true;
+	}
+
+	// Don't leave a truncated demo behind.
+	_context->LogError("Failed to write the output demo file %s", _outFilePath.GetPtrSafe("N/A"));
+	udtFileStream::Delete(_outFilePath.GetPtr());
+	_outFileError = true;
+
+	return false;
+}
+
 void udtBaseParser::AddCut(s32 gsIndex, s32 startTimeMs, s32 endTimeMs, udtDemoNameCreator streamCreator, const char* veryShortDesc, void* userData)
 {
 	udtCutInfo cut;
@@ -372,6 +453,53 @@ bool udtBaseParser::ShouldWriteMessage() const
 	return _outWriteMessage && !AreAllProtocolFlagsSet(_outProtocol, udtProtocolFlags::ReadOnly);
 }
 
+bool udtBaseParser::ShouldSkipSnapshots() const
+{
+	return EnablePlugIns && !PlugIns.IsEmpty() && _cuts.IsEmpty() && 
+		!HasPlugInSubscribedTo(udtParserPlugInCallback::Snapshot);
+}
+
+bool udtBaseParser::HasPlugInSubscribedTo(udtParserPlugInCallback::Mask callback) const
+{
+	if(!EnablePlugIns)
+	{
+		return false;
+	}
+
+	for(u32 i = 0, count = PlugIns.GetSize(); i < count; ++i)
+	{
+		if(PlugIns[i]->ShouldProcess(callback))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool udtBaseParser::IsInTimeWindow() const
+{
+	return _inServerTime >= TimeWindowStartMs && _inServerTime <= TimeWindowEndMs;
+}
+
+bool udtBaseParser::AreAllPlugInsDone() const
+{
+	if(!EnablePlugIns || PlugIns.IsEmpty() || !_cuts.IsEmpty())
+	{
+		return false;
+	}
+
+	for(u32 i = 0, count = PlugIns.GetSize(); i < count; ++i)
+	{
+		if(!PlugIns[i]->Done)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 void udtBaseParser::WriteFirstMessage()
 {
 	WriteGameState();
@@ -397,7 +525,6 @@ void udtBaseParser::WriteLastMessage()
 	s32 length = -1;
 	stream.Write(&length, 4, 1);
 	stream.Write(&length, 4, 1);
-	stream.Close();
 }
 
 bool udtBaseParser::ParseCommandString()
@@ -425,11 +552,12 @@ bool udtBaseParser::ParseCommandString()
 tokenize:
 	idTokenizer& tokenizer = _tokenizer;
 	tokenizer.Tokenize(commandString.GetPtr());
-	const int tokenCount = tokenizer.GetArgCount();
-	const udtString commandName = (tokenCount > 0) ? tokenizer.GetArg(0) : udtString::NewEmptyConstant();
+	bool commandIdMatchesCase = false;
+	const udtServerCommand::Id commandIdNoCase = GetServerCommandId(commandIdMatchesCase, tokenizer.GetArg(0));
+	const udtServerCommand::Id commandId = commandIdMatchesCase ? commandIdNoCase : udtServerCommand::Unknown;
 	s32 csIndex = -1;
 	bool isConfigString = false;
-	if(tokenCount == 3 && udtString::Equals(commandName, "cs"))
+	if(commandId == udtServerCommand::ConfigString && tokenizer.GetArgCount() == 3)
 	{
 		if(StringParseInt(csIndex, tokenizer.GetArgString(1)) && csIndex >= 0 && csIndex < (s32)UDT_COUNT_OF(_inConfigStrings))
 		{
@@ -452,19 +580,19 @@ tokenize:
 			_inConfigStrings[csIndex] = udtString::NewClone(_configStringAllocator, csStringTemp, csStringLength);
 		}
 	}
-	else if(tokenCount == 3 && udtString::Equals(commandName, "bcs0"))
+	else if(commandId == udtServerCommand::BigConfigStringStart && tokenizer.GetArgCount() == 3)
 	{
 		// Start a new big config string.
 		sprintf(_inBigConfigString, "cs %s \"%s", tokenizer.GetArgString(1), tokenizer.GetArgString(2));
 		plugInSkipsThisCommand = true;
 	}
-	else if(tokenCount == 3 && udtString::Equals(commandName, "bcs1"))
+	else if(commandId == udtServerCommand::BigConfigStringAppend && tokenizer.GetArgCount() == 3)
 	{
 		// Append to current big config string.
 		strcat(_inBigConfigString, tokenizer.GetArgString(2));
 		plugInSkipsThisCommand = true;
 	}
-	else if(tokenCount == 3 && udtString::Equals(commandName, "bcs2"))
+	else if(commandId == udtServerCommand::BigConfigStringEnd && tokenizer.GetArgCount() == 3)
 	{
 		// Append to current big config string and finalize it.
 		strcat(_inBigConfigString, tokenizer.GetArgString(2));
@@ -474,19 +602,31 @@ tokenize:
 		goto tokenize;
 	}
 
-	if(EnablePlugIns && !PlugIns.IsEmpty() && !plugInSkipsThisCommand)
+	// When parsing starts in the middle of a demo, the commands preceding the first game state
+	// belong to the previous one and the plug-ins haven't been set up for them.
+	if(EnablePlugIns && !PlugIns.IsEmpty() && !plugInSkipsThisCommand && 
+	   (_inFirstGameStateIndex == 0 || _inGameStateIndex >= _inFirstGameStateIndex) &&
+	   IsInTimeWindow())
 	{
 		udtCommandCallbackArg info;
 		info.CommandSequence = commandSequence;
 		info.String = commandString.GetPtr();
 		info.StringLength = commandStringLength;
+		info.CommandId = commandId;
+		info.CommandIdNoCase = commandIdNoCase;
 		info.ConfigStringIndex = csIndex;
 		info.IsConfigString = isConfigString;
 		info.IsEmptyConfigString = isConfigString ? udtString::IsNullOrEmpty(tokenizer.GetArg(2)) : false;
 
+		const u64 commandBit = (u64)1 << (u64)commandIdNoCase; // Plug-ins check the case themselves when they need to.
 		for(u32 i = 0, count = PlugIns.GetSize(); i < count; ++i)
 		{
-			PlugIns[i]->ProcessCommandMessage(info, *this);
+			udtBaseParserPlugIn* const plugIn = PlugIns[i];
+			if(plugIn->ShouldProcess(udtParserPlugInCallback::Command) &&
+			   (plugIn->SubscribedCommands & commandBit) != 0)
+			{
+				plugIn->ProcessCommandMessage(info, *this);
+			}
 		}
 	}
 
@@ -593,16 +733,20 @@ bool udtBaseParser::ParseGamestate()
 		_inChecksumFeed = 0;
 	}
 
+	udtGamestateCallbackArg info;
+	info.ServerCommandSequence = _inServerCommandSequence;
+	info.ClientNum = _inClientNum;
+	info.ChecksumFeed = _inChecksumFeed;
+	info.GameStateIndex = _inGameStateIndex + 1;
+
 	if(EnablePlugIns && !PlugIns.IsEmpty())
 	{
-		udtGamestateCallbackArg info;
-		info.ServerCommandSequence = _inServerCommandSequence;
-		info.ClientNum = _inClientNum;
-		info.ChecksumFeed = _inChecksumFeed;
-
 		for(u32 i = 0, count = PlugIns.GetSize(); i < count; ++i)
 		{
-			PlugIns[i]->ProcessGamestateMessage(info, *this);
+			if(PlugIns[i]->ShouldProcess(udtParserPlugInCallback::GameState))
+			{
+				PlugIns[i]->ProcessGamestateMessage(info, *this);
+			}
 		}
 	}
 
@@ -610,13 +754,23 @@ bool udtBaseParser::ParseGamestate()
 	_inGameStateFileOffsets.Add(_inFileOffset);
 
 	_analyzer->ResetForNextDemo();
-	_analyzer->ProcessGamestateMessage(udtGamestateCallbackArg(), *this);
+	_analyzer->ProcessGamestateMessage(info, *this);
 	_inMod = _analyzer->Mod();
 	_inModVersion = _analyzer->ModVersion();
 
 	return true;
 }
 
+void udtBaseParser::ParseSnapshotServerTime()
+{
+	if(_inProtocol == udtProtocol::Dm3)
+	{
+		_inMsg.ReadLong(); // Client command sequence.
+	}
+
+	_inServerTime = _inMsg.ReadLong();
+}
+
 bool udtBaseParser::ParseSnapshot()
 {
 	//
@@ -631,6 +785,7 @@ bool udtBaseParser::ParseSnapshot()
 		_inMsg.ReadLong(); // Client command sequence.
 	}
 
+	const s32 snapshotFirstBit = _inMsg.Buffer.bit;
 	_inServerTime = _inMsg.ReadLong();
 
 	idLargestClientSnapshot newSnap;
@@ -721,6 +876,7 @@ bool udtBaseParser::ParseSnapshot()
 	{
 		return false;
 	}
+	const s32 snapshotBitCount = _inMsg.Buffer.bit - snapshotFirstBit;
 
 	// Did we write enough snapshots already?
 	const bool noDelta = _outSnapshotsWritten < deltaNum;
@@ -769,7 +925,7 @@ bool udtBaseParser::ParseSnapshot()
 	// Process plug-ins now so that modifiers can alter the snapshots.
 	//
 
-	if(EnablePlugIns && !PlugIns.IsEmpty())
+	if(HasPlugInSubscribedTo(udtParserPlugInCallback::Snapshot) && IsInTimeWindow())
 	{
 		_inEntities.Clear();
 		_inEntityFlags.Clear();
@@ -810,7 +966,10 @@ bool udtBaseParser::ParseSnapshot()
 
 		for(u32 i = 0, count = PlugIns.GetSize(); i < count; ++i)
 		{
-			PlugIns[i]->ProcessSnapshotMessage(info, *this);
+			if(PlugIns[i]->ShouldProcess(udtParserPlugInCallback::Snapshot))
+			{
+				PlugIns[i]->ProcessSnapshotMessage(info, *this);
+			}
 		}
 	}
 
@@ -818,7 +977,19 @@ bool udtBaseParser::ParseSnapshot()
 	// Write to the output message.
 	//
 
-	if(ShouldWriteMessage())
+	// When the snapshot would be encoded just like in the input, we copy it instead.
+	// The delta snapshot, if any, was written to the output since noDelta is false.
+	if(ShouldWriteMessage() && 
+	   _outProtocol == _inProtocol && 
+	   !noDelta && 
+	   !_inMsg.Buffer.oob && 
+	   !HasPlugInSubscribedTo(udtParserPlugInCallback::Snapshot))
+	{
+		_outMsg.WriteByte(svc_snapshot);
+		_outMsg.WriteHuffmanBits(_inMsg.Buffer.data, snapshotFirstBit, snapshotBitCount);
+		++_outSnapshotsWritten;
+	}
+	else if(ShouldWriteMessage())
 	{
 		_outMsg.WriteByte(svc_snapshot);
 		_outMsg.WriteLong(newSnap.serverTime);
@@ -1241,6 +1412,41 @@ const udtString udtBaseParser::GetConfigString(s32 csIndex) const
 	return _inConfigStrings[csIndex];
 }
 
+bool udtBaseParser::GetConfigStringValueInt(s32& varValue, s32 csIndex, const char* varName)
+{
+	udtString valueString;
+	if(!GetConfigStringValueString(valueString, csIndex, varName) ||
+	   udtString::IsEmpty(valueString))
+	{
+		return false;
+	}
+
+	int result = 0;
+	if(sscanf(valueString.GetPtr(), "%d", &result) != 1)
+	{
+		return false;
+	}
+
+	varValue = (s32)result;
+
+	return true;
+}
+
+bool udtBaseParser::GetConfigStringValueString(udtString& varValue, s32 csIndex, const char* varName)
+{
+	if(csIndex < 0 || csIndex >= (s32)UDT_COUNT_OF(_inConfigStrings))
+	{
+		return false;
+	}
+
+	return _inConfigStringTable.GetValue(varValue, (u32)csIndex, _inConfigStrings[csIndex], varName);
+}
+
+const udtPlayerRosterEntry& udtBaseParser::GetPlayer(s32 playerIndex)
+{
+	return _inPlayerRoster.GetPlayer(*this, playerIndex);
+}
+
 const udtGameInfo udtBaseParser::GetGameInfo() const
 {
 	const udtGameInfo gameInfo = { _inModVersion, _inProtocol, _inMod };
@@ -1252,3 +1458,286 @@ void udtBaseParser::AddPlugIn(udtBaseParserPlugIn* plugIn)
 {
 	PlugIns.Add(plugIn);
 }
+
+void udtBaseParser::RemovePlugIn(udtBaseParserPlugIn* plugIn)
+{
+	for(u32 i = 0, count = PlugIns.GetSize(); i < count; ++i)
+	{
+		if(PlugIns[i] == plugIn)
+		{
+			PlugIns.Remove(i);
+			break;
+		}
+	}
+}
+
+bool udtBaseParser::SaveCheckpoint(udtMessage& output)
+{
+	if(_inGameStateIndex < 0 || _inGameStateFileOffsets.IsEmpty())
+	{
+		return false;
+	}
+
+	udtMessage& msg = output;
+	msg.WriteLong((s32)_inProtocol);
+	msg.WriteLong(_inGameStateIndex);
+	msg.WriteLong((s32)_inGameStateFileOffsets[_inGameStateFileOffsets.GetSize() - 1]);
+	msg.WriteLong(_inServerMessageSequence);
+	msg.WriteLong(_inServerCommandSequence);
+	msg.WriteLong(_inReliableSequenceAcknowledge);
+	msg.WriteLong(_inClientNum);
+	msg.WriteLong(_inChecksumFeed);
+	msg.WriteLong(_inParseEntitiesNum);
+	msg.WriteLong(_inServerTime);
+	msg.WriteLong(_inLastSnapshotMessageNumber);
+	msg.WriteBigString(_inBigConfigString, (s32)strlen(_inBigConfigString));
+
+	u32 configStringCount = 0;
+	for(u32 i = 0; i < (u32)UDT_COUNT_OF(_inConfigStrings); ++i)
+	{
+		if(!udtString::IsNull(_inConfigStrings[i]))
+		{
+			++configStringCount;
+		}
+	}
+
+	msg.WriteShort((s32)configStringCount);
+	for(u32 i = 0; i < (u32)UDT_COUNT_OF(_inConfigStrings); ++i)
+	{
+		const udtString& cs = _inConfigStrings[i];
+		if(!udtString::IsNull(cs))
+		{
+			msg.WriteShort((s32)i);
+			msg.WriteBigString(cs.GetPtr(), (s32)cs.GetLength());
+		}
+	}
+
+	idLargestEntityState nullState;
+	Com_Memset(&nullState, 0, sizeof(nullState));
+
+	// Entity states are delta-compressed from the null state, like the baselines of game state messages.
+	u32 baselineCount = 0;
+	for(s32 i = 0; i < MAX_GENTITIES; ++i)
+	{
+		if(memcmp(&nullState, GetBaseline(i), (size_t)_inProtocolSizeOfEntityState))
+		{
+			++baselineCount;
+		}
+	}
+
+	msg.WriteShort((s32)baselineCount);
+	for(s32 i = 0; i < MAX_GENTITIES; ++i)
+	{
+		const idEntityStateBase* const baseline = GetBaseline(i);
+		if(memcmp(&nullState, baseline, (size_t)_inProtocolSizeOfEntityState))
+		{
+			msg.WriteDeltaEntity(&nullState, baseline, true);
+		}
+	}
+
+	u32 eventTimeCount = 0;
+	for(s32 i = 0; i < MAX_GENTITIES; ++i)
+	{
+		if(_inEntityEventTimesMs[i] != UDT_S32_MIN)
+		{
+			++eventTimeCount;
+		}
+	}
+
+	msg.WriteShort((s32)eventTimeCount);
+	for(s32 i = 0; i < MAX_GENTITIES; ++i)
+	{
+		if(_inEntityEventTimesMs[i] != UDT_S32_MIN)
+		{
+			msg.WriteBits(i, GENTITYNUM_BITS);
+			msg.WriteLong(_inEntityEventTimesMs[i]);
+		}
+	}
+
+	// Only the valid snapshots can be delta-compressed from
+	// and only their entities are needed in the parse entities ring.
+	u32 snapshotCount = 0;
+	s32 firstParseEntity = _inParseEntitiesNum;
+	for(s32 i = 0; i < PACKET_BACKUP; ++i)
+	{
+		const idClientSnapshotBase* const snap = GetClientSnapshot(i);
+		if(snap->valid)
+		{
+			++snapshotCount;
+			firstParseEntity = udt_min(firstParseEntity, snap->parseEntitiesNum);
+		}
+	}
+	firstParseEntity = udt_max(firstParseEntity, _inParseEntitiesNum - ID_MAX_PARSE_ENTITIES);
+
+	msg.WriteByte((s32)snapshotCount);
+	for(s32 i = 0; i < PACKET_BACKUP; ++i)
+	{
+		idClientSnapshotBase* const snap = GetClientSnapshot(i);
+		if(!snap->valid)
+		{
+			continue;
+		}
+
+		msg.WriteByte(i);
+		msg.WriteLong(snap->snapFlags);
+		msg.WriteLong(snap->serverTime);
+		msg.WriteLong(snap->messageNum);
+		msg.WriteLong(snap->deltaNum);
+		msg.WriteLong(snap->numEntities);
+		msg.WriteLong(snap->parseEntitiesNum);
+		msg.WriteLong(snap->serverCommandNum);
+		msg.WriteData(snap->areamask, (s32)sizeof(snap->areamask));
+		msg.WriteDeltaPlayer(NULL, GetPlayerState(snap, _inProtocol));
+	}
+
+	msg.WriteLong(firstParseEntity);
+	for(s32 i = firstParseEntity; i < _inParseEntitiesNum; ++i)
+	{
+		msg.WriteDeltaEntity(&nullState, GetEntity(i & (ID_MAX_PARSE_ENTITIES - 1)), true);
+	}
+
+	return msg.ValidState();
+}
+
+bool udtBaseParser::RestoreCheckpoint(udtMessage& input)
+{
+	ResetForGamestateMessage();
+
+	udtMessage& msg = input;
+	if(msg.ReadLong() != (s32)_inProtocol)
+	{
+		return false;
+	}
+
+	const s32 gameStateIndex = msg.ReadLong();
+	const u32 gameStateFileOffset = (u32)msg.ReadLong();
+	if(gameStateIndex < 0)
+	{
+		return false;
+	}
+
+	_inGameStateIndex = gameStateIndex;
+	_inFirstGameStateIndex = gameStateIndex;
+	_inTimeWindowReached = false;
+	// Only the current game state's offset is stored in the checkpoint.
+	_inGameStateFileOffsets.Resize((u32)gameStateIndex + 1);
+	for(s32 i = 0; i < gameStateIndex; ++i)
+	{
+		_inGameStateFileOffsets[i] = UDT_U32_MAX;
+	}
+	_inGameStateFileOffsets[gameStateIndex] = gameStateFileOffset;
+	_inServerMessageSequence = msg.ReadLong();
+	_inServerCommandSequence = msg.ReadLong();
+	_inReliableSequenceAcknowledge = msg.ReadLong();
+	_inClientNum = msg.ReadLong();
+	_inChecksumFeed = msg.ReadLong();
+	_inParseEntitiesNum = msg.ReadLong();
+	_inServerTime = msg.ReadLong();
+	_inLastSnapshotMessageNumber = msg.ReadLong();
+	
+	s32 stringLength = 0;
+	const char* const bigConfigString = msg.ReadBigString(stringLength);
+	if((u32)stringLength >= (u32)sizeof(_inBigConfigString))
+	{
+		return false;
+	}
+	Q_strncpyz(_inBigConfigString, bigConfigString, (s32)sizeof(_inBigConfigString));
+
+	const s32 configStringCount = msg.ReadShort();
+	for(s32 i = 0; i < configStringCount; ++i)
+	{
+		const s32 index = msg.ReadShort();
+		const char* const configString = msg.ReadBigString(stringLength);
+		if(index < 0 || index >= (s32)UDT_COUNT_OF(_inConfigStrings))
+		{
+			return false;
+		}
+
+		_inConfigStrings[index] = udtString::NewClone(_configStringAllocator, configString, (u32)stringLength);
+	}
+
+	idLargestEntityState nullState;
+	Com_Memset(&nullState, 0, sizeof(nullState));
+
+	const s32 baselineCount = msg.ReadShort();
+	for(s32 i = 0; i < baselineCount; ++i)
+	{
+		const s32 number = msg.ReadBits(GENTITYNUM_BITS);
+		bool addedOrChanged = false;
+		if(number < 0 || !msg.ReadDeltaEntity(addedOrChanged, &nullState, GetBaseline(number), number))
+		{
+			return false;
+		}
+	}
+
+	const s32 eventTimeCount = msg.ReadShort();
+	for(s32 i = 0; i < eventTimeCount; ++i)
+	{
+		const s32 number = msg.ReadBits(GENTITYNUM_BITS);
+		const s32 timeMs = msg.ReadLong();
+		if(number < 0)
+		{
+			return false;
+		}
+
+		_inEntityEventTimesMs[number] = timeMs;
+	}
+
+	const s32 snapshotCount = msg.ReadByte();
+	for(s32 i = 0; i < snapshotCount; ++i)
+	{
+		const s32 index = msg.ReadByte();
+		if(index < 0 || index >= PACKET_BACKUP)
+		{
+			return false;
+		}
+
+		idClientSnapshotBase* const snap = GetClientSnapshot(index);
+		snap->snapFlags = msg.ReadLong();
+		snap->serverTime = msg.ReadLong();
+		snap->messageNum = msg.ReadLong();
+		snap->deltaNum = msg.ReadLong();
+		snap->numEntities = msg.ReadLong();
+		snap->parseEntitiesNum = msg.ReadLong();
+		snap->serverCommandNum = msg.ReadLong();
+		msg.ReadData(snap->areamask, (s32)sizeof(snap->areamask));
+		if(!msg.ReadDeltaPlayer(NULL, GetPlayerState(snap, _inProtocol)))
+		{
+			return false;
+		}
+		snap->valid = true;
+	}
+
+	const s32 firstParseEntity = msg.ReadLong();
+	if(_inParseEntitiesNum - firstParseEntity > ID_MAX_PARSE_ENTITIES)
+	{
+		return false;
+	}
+
+	for(s32 i = firstParseEntity; i < _inParseEntitiesNum; ++i)
+	{
+		const s32 number = msg.ReadBits(GENTITYNUM_BITS);
+		bool addedOrChanged = false;
+		if(number < 0 || !msg.ReadDeltaEntity(addedOrChanged, &nullState, GetEntity(i & (ID_MAX_PARSE_ENTITIES - 1)), number))
+		{
+			return false;
+		}
+	}
+
+	if(!msg.ValidState())
+	{
+		return false;
+	}
+
+	udtGamestateCallbackArg info;
+	info.ServerCommandSequence = _inServerCommandSequence;
+	info.ClientNum = _inClientNum;
+	info.ChecksumFeed = _inChecksumFeed;
+	info.GameStateIndex = _inGameStateIndex;
+	_analyzer->ResetForNextDemo();
+	_analyzer->ProcessGamestateMessage(info, *this);
+	_inMod = _analyzer->Mod();
+	_inModVersion = _analyzer->ModVersion();
+
+	return true;
+}
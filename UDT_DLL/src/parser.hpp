@@ -5,15 +5,22 @@
 #include "message.hpp"
 #include "tokenizer.hpp"
 #include "file_stream.hpp"
+#include "write_only_sequ_file_stream.hpp"
 #include "linear_allocator.hpp"
 #include "parser_plug_in.hpp"
 #include "array.hpp"
+#include "info_string_table.hpp"
+#include "player_roster.hpp"
 #include "protocol_conversion.hpp"
 
 // For the placement new operator.
 #include <new>
 
 
+// Large enough for the serialized decoding state of any supported protocol.
+#define UDT_PARSER_MAX_CHECKPOINT_BYTE_COUNT (1 << 20)
+
+
 struct udtDemoStreamCreatorArg
 {
 	s32 StartTimeMs;
@@ -51,17 +58,32 @@ public:
 
 	bool	ParseNextMessage(const udtMessage& inMsg, s32 inServerMessageSequence, u32 fileOffset); // Returns true if should continue parsing.
 	void	FinishParsing(bool success);
+	bool	CloseOutputFile(); // Returns false and deletes the file if some of its data couldn't be written.
 
 	void	AddCut(s32 gsIndex, s32 startTimeMs, s32 endTimeMs, udtDemoNameCreator streamCreator, const char* veryShortDesc, void* userData = NULL);
 	void	AddCut(s32 gsIndex, s32 startTimeMs, s32 endTimeMs, const char* filePath);
 	void    AddPlugIn(udtBaseParserPlugIn* plugIn);
+	void    RemovePlugIn(udtBaseParserPlugIn* plugIn);
+
+	// The decoding state at the end of the last message parsed.
+	// Restoring it after Init with the same protocol lets parsing resume with the message that followed.
+	// The plug-ins aren't notified of the restored game state.
+	bool    SaveCheckpoint(udtMessage& output);
+	bool    RestoreCheckpoint(udtMessage& input);
 
 	const udtString       GetConfigString(s32 csIndex) const;
+	bool                  GetConfigStringValueInt(s32& varValue, s32 csIndex, const char* varName); // Case sensitive.
+	bool                  GetConfigStringValueString(udtString& varValue, s32 csIndex, const char* varName); // Case sensitive. Read-only, valid until the next game state.
+	const udtPlayerRosterEntry& GetPlayer(s32 playerIndex); // Read-only, valid until the next game state.
 	const udtGameInfo     GetGameInfo() const;
+	bool                  AreAllPlugInsDone() const; // False when there are cuts left to write.
+	bool                  ShouldSkipSnapshots() const; // If true, the snapshots are skipped without being validated.
 
 private:
 	bool                  ParseServerMessage(); // Returns true if should continue parsing.
 	bool                  ShouldWriteMessage() const;
+	bool                  HasPlugInSubscribedTo(udtParserPlugInCallback::Mask callback) const;
+	bool                  IsInTimeWindow() const;
 	void                  WriteFirstMessage();
 	void                  WriteNextMessage();
 	void                  WriteLastMessage();
@@ -70,6 +92,7 @@ private:
 	bool                  ParseCommandString();
 	bool                  ParseGamestate();
 	bool                  ParseSnapshot();
+	void                  ParseSnapshotServerTime();
 	bool                  ParsePacketEntities(udtMessage& msg, idClientSnapshotBase* oldframe, idClientSnapshotBase* newframe);
 	void                  EmitPacketEntities(idClientSnapshotBase* from, idClientSnapshotBase* to);
 	bool                  DeltaEntity(udtMessage& msg, idClientSnapshotBase *frame, s32 newnum, idEntityStateBase* old, bool unchanged);
@@ -112,6 +135,11 @@ public:
 	void* UserData; // Put whatever you want in there. Useful for callbacks.
 	udtVMArray<udtBaseParserPlugIn*> PlugIns { "Parser::PlugInsArray" };
 	bool EnablePlugIns;
+	bool FirstGameStateOnly; // Stop parsing right after the first gamestate message. Reset by Init.
+	bool FirstMatchOnly; // Match-aware plug-ins are done after the first match. Reset by Init.
+	bool TimeWindowEnabled; // Only the first game state read is parsed, with the time window below. Reset by Init.
+	s32 TimeWindowStartMs; // No snapshot and command callbacks before. Reset by Init.
+	s32 TimeWindowEndMs; // No snapshot and command callbacks after, parsing stops. Reset by Init.
 
 	// Input.
 	udtString _inFilePath;
@@ -126,15 +154,19 @@ public:
 	s32 _inParseEntitiesNum;
 	s32 _inServerTime;
 	s32 _inGameStateIndex;
+	s32 _inFirstGameStateIndex; // The first game state this parse started at, see Init.
+	bool _inTimeWindowReached; // Server times right after a game state can be stale, so we only stop once we were in the window.
 	s32 _inLastSnapshotMessageNumber;
-	u8 _inMsgData[ID_MAX_MSG_LENGTH];
+	u8 _inMsgData[ID_MAX_MSG_LENGTH + UDT_MESSAGE_READ_PADDING];
 	u8 _inEntityBaselines[ID_MAX_PARSE_ENTITIES * sizeof(idLargestEntityState)]; // Type depends on protocol. Must be zeroed initially.
 	u8 _inParseEntities[ID_MAX_PARSE_ENTITIES * sizeof(idLargestEntityState)]; // Type depends on protocol.
 	u8 _inSnapshots[PACKET_BACKUP * sizeof(idLargestClientSnapshot)]; // Type depends on protocol.
 	s32 _inEntityEventTimesMs[MAX_GENTITIES]; // The server time, in ms, of the last event for a given entity.
 	char _inBigConfigString[BIG_INFO_STRING]; // For handling the bcs0, bcs1 and bcs2 server commands.
 	udtString _inConfigStrings[2 * MAX_CONFIGSTRINGS]; // Apparently some Quake 3 mods have bumped the original MAX_CONFIGSTRINGS value up?
-	udtVMArray<u32> _inGameStateFileOffsets { "Parser::GameStateFileOffsetsArray" };
+	udtInfoStringTable _inConfigStringTable; // Key/value look-ups in _inConfigStrings.
+	udtPlayerRoster _inPlayerRoster; // Decoded from the player config strings in _inConfigStrings.
+	udtVMArray<u32> _inGameStateFileOffsets { "Parser::GameStateFileOffsetsArray" }; // UDT_U32_MAX when unknown (before a restored checkpoint).
 	udtVMArray<udtChangedEntity> _inChangedEntities { "Parser::ChangedEntitiesArray" }; // The entities that were read (added or changed) in the last call to ParsePacketEntities.
 	udtVMArray<s32> _inRemovedEntities { "Parser::RemovedEntitiesArray" }; // The entities that were removed in the last call to ParsePacketEntities.
 	udtVMArray<idEntityStateBase*> _inEntities { "Parser::EntitiesArray" }; // All entities that were read in the last call to ParsePacketEntities.
@@ -143,7 +175,7 @@ public:
 	udtString _inModVersion;
 
 	// Output.
-	udtFileStream _outFile;
+	udtWriteOnlySequentialFileStream _outFile;
 	udtString _outFilePath;
 	udtString _outFileName;
 	udtVMArray<udtCutInfo> _cuts { "Parser::CutsArray" };
@@ -153,6 +185,7 @@ public:
 	s32 _outSnapshotsWritten;
 	bool _outWriteFirstMessage;
 	bool _outWriteMessage;
+	bool _outFileError; // Writing a cut's file failed. Reset by Init.
 
 private:
 	idTokenizer _tokenizer; // Make sure plug-ins don't get write access to this.
@@ -61,12 +61,10 @@ udtParserContext_s::~udtParserContext_s()
 
 bool udtParserContext_s::Init(u32 demoCount, const u32* plugInIds, u32 plugInCount)
 {
-#if defined(UDT_WINDOWS)
 	if(!DemoReader.Init())
 	{
 		return false;
 	}
-#endif
 
 	DemoCount = demoCount;
 
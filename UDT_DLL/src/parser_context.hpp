@@ -8,6 +8,10 @@
 #include "modifier_context.hpp"
 #include "json_writer_context.hpp"
 #include "read_only_sequ_file_stream.hpp"
+#include "memory_mapped_file_stream.hpp"
+#include "game_state_scanner.hpp"
+#include "seek_index.hpp"
+#include "single_pass_cutter.hpp"
 
 
 #define UDT_PRIVATE_PLUG_IN_LIST(N) \
@@ -60,15 +64,15 @@ public:
 	udtVMArray<AddOnItem> PlugIns { "ParserContext::PlugInsArray" }; // There is only 1 (shared) plug-in instance for each plug-in ID passed.
 	udtVMArray<u32> InputIndices { "ParserContext::InputIndicesArray" };
 	udtVMLinearAllocator PlugInTempAllocator { "ParserContext::PlugInTemp" };
-#if defined(UDT_WINDOWS)
 	udtReadOnlySequentialFileStream DemoReader;
-#endif
+	udtGameStateScanner GameStateScanner;
+	udtSeekIndexWriter SeekIndexWriter;
+	udtSeekIndex SeekIndex;
+	udtSinglePassCutter SinglePassCutter;
 	u32 DemoCount;
 };
 
 
-#if defined(UDT_WINDOWS)
-
 struct udtStreamScopeGuard
 {
 	udtStreamScopeGuard(udtStream& stream)
@@ -87,25 +91,21 @@ private:
 	udtStream& _stream;
 };
 
-#endif
-
-
-#if defined(UDT_WINDOWS)
-#	define UDT_INIT_DEMO_FILE_READER(name, filePath, context) \
-		udtReadOnlySequentialFileStream& name = context->DemoReader; \
-		udtStreamScopeGuard name##ScopeGuard(name); \
-		if(!name.Open(filePath)) return false;
-#	define UDT_INIT_DEMO_FILE_READER_AT(name, filePath, context, offset) \
-		udtReadOnlySequentialFileStream& name = context->DemoReader; \
-		udtStreamScopeGuard name##ScopeGuard(name); \
-		if(!name.Open(filePath, offset)) return false;
-#else
-#	define UDT_INIT_DEMO_FILE_READER(name, filePath, context) \
-		udtFileStream name; \
-		if(!name.Open(filePath, udtFileOpenMode::Read)) return false;
-#	define UDT_INIT_DEMO_FILE_READER_AT(name, filePath, context, offset) \
-		udtFileStream name; \
-		if(!name.Open(filePath, udtFileOpenMode::Read)) return false; \
-		if(fileOffset > 0 && name.Seek((s32)offset, udtSeekOrigin::Start) != 0) return false;
-
-#endif
+
+#define UDT_INIT_DEMO_FILE_READER(name, filePath, context) \
+	udtReadOnlySequentialFileStream& name = context->DemoReader; \
+	udtStreamScopeGuard name##ScopeGuard(name); \
+	if(!name.Open(filePath)) return false;
+
+#define UDT_INIT_DEMO_FILE_READER_AT(name, filePath, context, offset) \
+	udtReadOnlySequentialFileStream& name = context->DemoReader; \
+	udtStreamScopeGuard name##ScopeGuard(name); \
+	if(!name.Open(filePath, offset)) return false;
+
+// For jobs that never modify the input: messages are read in place when the file can be mapped.
+#define UDT_INIT_MAPPED_DEMO_FILE_READER(name, filePath, context) \
+	udtMemoryMappedFileStream name##Mapped; \
+	udtStreamScopeGuard name##ReaderScopeGuard(context->DemoReader); \
+	const bool name##IsMapped = name##Mapped.Open(filePath); \
+	if(!name##IsMapped && !context->DemoReader.Open(filePath)) return false; \
+	udtStream& name = name##IsMapped ? (udtStream&)name##Mapped : (udtStream&)context->DemoReader;
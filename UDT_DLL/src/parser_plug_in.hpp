@@ -3,6 +3,7 @@
 
 #include "common.hpp"
 #include "array.hpp"
+#include "server_commands.hpp"
 
 #include <assert.h>
 
@@ -29,6 +30,7 @@ struct udtGamestateCallbackArg
 	s32 ServerCommandSequence;
 	s32 ClientNum;
 	s32 ChecksumFeed;
+	s32 GameStateIndex; // Of the game state being processed, even when parsing didn't start at the first one.
 };
 
 struct udtSnapshotCallbackArg
@@ -52,17 +54,35 @@ struct udtCommandCallbackArg
 {
 	const char* String;
 	u32 StringLength;
+	udtServerCommand::Id CommandId; // From the first token, classified once by the parser. Case-sensitive.
+	udtServerCommand::Id CommandIdNoCase; // Same as CommandId, but the first token's case is ignored.
 	s32 CommandSequence;
 	s32 ConfigStringIndex; // Only valid if IsConfigString is true.
 	bool IsConfigString;
 	bool IsEmptyConfigString;
 };
 
+struct udtParserPlugInCallback
+{
+	enum Mask
+	{
+		MessageBundleStart = UDT_BIT(0),
+		MessageBundleEnd = UDT_BIT(1),
+		GameState = UDT_BIT(2),
+		Snapshot = UDT_BIT(3),
+		Command = UDT_BIT(4),
+		All = MessageBundleStart | MessageBundleEnd | GameState | Snapshot | Command
+	};
+};
+
 
 struct udtBaseParserPlugIn
 {
 	udtBaseParserPlugIn() 
-		: TempAllocator(NULL)
+		: SubscribedCallbacks((u32)udtParserPlugInCallback::All)
+		, SubscribedCommands(UDT_ALL_SERVER_COMMANDS)
+		, Done(false)
+		, TempAllocator(NULL)
 		, DemoCount(0)
 		, StartItemCount(0)
 	{
@@ -86,6 +106,7 @@ struct udtBaseParserPlugIn
 		TempAllocator->Clear();
 
 		StartItemCount = GetItemCount();
+		Done = false;
 
 		StartDemoAnalysis();
 	}
@@ -116,6 +137,21 @@ struct udtBaseParserPlugIn
 	virtual void ProcessGamestateMessage(const udtGamestateCallbackArg& /*arg*/, udtBaseParser& /*parser*/) {}
 	virtual void ProcessSnapshotMessage(const udtSnapshotCallbackArg& /*arg*/, udtBaseParser& /*parser*/) {}
 	virtual void ProcessCommandMessage(const udtCommandCallbackArg& /*arg*/, udtBaseParser& /*parser*/) {}
+
+	// Set by the constructors of plug-ins that don't need everything.
+	// When no plug-in subscribes to snapshots, the parser only reads their server time,
+	// so plug-ins reading snapshot data from the parser in other callbacks must subscribe to them too.
+	u32 SubscribedCallbacks; // Of type udtParserPlugInCallback::Mask.
+	u64 SubscribedCommands; // See UDT_SERVER_COMMAND_BIT. Only used when subscribed to commands.
+
+	// Set by plug-ins that need nothing more from the current demo. Reset for every demo.
+	// Done plug-ins get no more callbacks and parsing stops early once all plug-ins are done.
+	bool Done;
+
+	bool ShouldProcess(udtParserPlugInCallback::Mask callback) const
+	{
+		return !Done && (SubscribedCallbacks & (u32)callback) != 0;
+	}
 	
 protected:
 	virtual void StartDemoAnalysis() {}
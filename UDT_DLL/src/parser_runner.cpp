@@ -6,6 +6,7 @@ udtParserRunner::udtParserRunner()
 {
 	_fileStartOffset = 0;
 	_fileOffset = 0;
+	_fileEndOffset = 0;
 	_maxByteCount = 0;
 	_parser = NULL;
 	_file = NULL;
@@ -13,7 +14,7 @@ udtParserRunner::udtParserRunner()
 	_success = false;
 }
 
-bool udtParserRunner::Init(udtBaseParser& parser, udtStream& file, const s32* cancelOperation)
+bool udtParserRunner::Init(udtBaseParser& parser, udtStream& file, const s32* cancelOperation, u32 fileEndOffset)
 {
 	_parser = &parser;
 	_file = &file;
@@ -23,7 +24,9 @@ bool udtParserRunner::Init(udtBaseParser& parser, udtStream& file, const s32* ca
 	_inMsg.InitProtocol(parser._inProtocol);
 
 	_fileStartOffset = (u64)file.Offset();
-	_maxByteCount = file.Length() - _fileStartOffset;
+	_fileOffset = _fileStartOffset; // The parser gets absolute file offsets.
+	_fileEndOffset = (u64)fileEndOffset;
+	_maxByteCount = (fileEndOffset > 0 ? _fileEndOffset : file.Length()) - _fileStartOffset;
 
 	_timer.Start();
 
@@ -38,6 +41,12 @@ bool udtParserRunner::ParseNextMessage()
 		return false;
 	}
 
+	if(_fileEndOffset > 0 && _fileOffset >= _fileEndOffset)
+	{
+		SetSuccess(true);
+		return false;
+	}
+
 	const u64 fileOffset = _fileOffset;
 
 	s32 inServerMessageSequence = 0;
@@ -67,17 +76,35 @@ bool udtParserRunner::ParseNextMessage()
 
 	if((u32)_inMsg.Buffer.cursize > (u32)_inMsg.Buffer.maxsize)
 	{
+		if(_parser->ShouldSkipSnapshots())
+		{
+			// A full decode would have stopped at the invalid snapshot that preceded this.
+			_parser->_context->LogWarning("Demo file %s has a message length greater than MAX_SIZE", _parser->GetFileNamePtr());
+			SetSuccess(true);
+			return false;
+		}
+
 		_parser->_context->LogError("Demo file %s has a message length greater than MAX_SIZE", _parser->GetFileNamePtr());
 		SetSuccess(false);
 		return false;
 	}
 
-	elementsRead = _file->Read(_inMsg.Buffer.data, _inMsg.Buffer.cursize, 1);
-	if(elementsRead != 1)
+	// Read-only streams that have the data mapped let us skip the copy.
+	// When we're too close to the end, the padding isn't there and we copy as usual.
+	const u8* const inPlaceData = _file->ReadInPlace((u32)_inMsg.Buffer.cursize, UDT_MESSAGE_READ_PADDING);
+	if(inPlaceData != NULL)
 	{
-		_parser->_context->LogWarning("Demo file %s is truncated", _parser->GetFileNamePtr());
-		SetSuccess(true);
-		return false;
+		_inMsg.Buffer.data = (u8*)inPlaceData;
+	}
+	else
+	{
+		elementsRead = _file->Read(_inMsg.Buffer.data, _inMsg.Buffer.cursize, 1);
+		if(elementsRead != 1)
+		{
+			_parser->_context->LogWarning("Demo file %s is truncated", _parser->GetFileNamePtr());
+			SetSuccess(true);
+			return false;
+		}
 	}
 
 	_inMsg.Buffer.readcount = 0;
@@ -87,6 +114,13 @@ bool udtParserRunner::ParseNextMessage()
 		return false;
 	}
 
+	if(_parser->AreAllPlugInsDone())
+	{
+		// Reading the rest of the file would be useless.
+		SetSuccess(true);
+		return false;
+	}
+
 	const u64 currentByteCount = fileOffset - _fileStartOffset;
 	const f32 currentProgress = (f32)currentByteCount / (f32)_maxByteCount;
 	_parser->_context->NotifyProgress(currentProgress);
@@ -100,6 +134,10 @@ bool udtParserRunner::ParseNextMessage()
 void udtParserRunner::FinishParsing()
 {
 	_parser->FinishParsing(_success);
+	if(_parser->_outFileError)
+	{
+		SetSuccess(false);
+	}
 }
 
 bool udtParserRunner::WasSuccess() const
@@ -9,7 +9,7 @@ struct udtParserRunner
 {
 	udtParserRunner();
 
-	bool Init(udtBaseParser& parser, udtStream& file, const s32* cancelOperation);
+	bool Init(udtBaseParser& parser, udtStream& file, const s32* cancelOperation, u32 fileEndOffset = 0); // 0 to read until the end of the demo.
 	bool ParseNextMessage(); // Returns true as long as there's supposed to be more to read.
 	void FinishParsing();
 	bool WasSuccess() const;
@@ -24,6 +24,7 @@ private:
 	udtTimer _timer;
 	u64 _fileStartOffset;
 	u64 _fileOffset;
+	u64 _fileEndOffset; // 0 when reading until the end of the demo.
 	u64 _maxByteCount;
 	udtBaseParser* _parser;
 	udtStream* _file;
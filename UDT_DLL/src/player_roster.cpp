@@ -0,0 +1,131 @@
+#include "player_roster.hpp"
+#include "parser.hpp"
+#include "utils.hpp"
+
+
+udtPlayerRoster::udtPlayerRoster()
+{
+	ClearPlayer(_invalidPlayer);
+	Clear();
+}
+
+udtPlayerRoster::~udtPlayerRoster()
+{
+}
+
+void udtPlayerRoster::Clear()
+{
+	for(u32 i = 0; i < (u32)ID_MAX_CLIENTS; ++i)
+	{
+		ClearPlayer(_players[i]);
+		_sourceOffsets[i] = UDT_U32_MAX;
+		_sourceLengths[i] = 0;
+	}
+
+	_stringAllocator.Clear();
+}
+
+const udtPlayerRosterEntry& udtPlayerRoster::GetPlayer(udtBaseParser& parser, s32 playerIndex)
+{
+	if(playerIndex < 0 || playerIndex >= ID_MAX_CLIENTS)
+	{
+		return _invalidPlayer;
+	}
+
+	const s32 firstPlayerCsIndex = GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::FirstPlayer, parser._inProtocol);
+	if(firstPlayerCsIndex < 0)
+	{
+		return _invalidPlayer;
+	}
+
+	// Config strings are never modified in place: a new value means a new offset.
+	const s32 csIndex = firstPlayerCsIndex + playerIndex;
+	const udtString cs = parser.GetConfigString(csIndex);
+	udtPlayerRosterEntry& player = _players[playerIndex];
+	if(_sourceOffsets[playerIndex] != cs.GetOffset() ||
+	   _sourceLengths[playerIndex] != cs.GetLength())
+	{
+		_sourceOffsets[playerIndex] = cs.GetOffset();
+		_sourceLengths[playerIndex] = cs.GetLength();
+		if(udtString::IsNullOrEmpty(cs))
+		{
+			ClearPlayer(player);
+		}
+		else
+		{
+			Update(player, parser, csIndex);
+		}
+	}
+
+	return player;
+}
+
+void udtPlayerRoster::Update(udtPlayerRosterEntry& player, udtBaseParser& parser, s32 csIndex)
+{
+	// Most updates are team or score changes: keep the strings we already have.
+	if(!HasSameNames(player, parser, csIndex))
+	{
+		ClearPlayer(player);
+
+		const udtProtocol::Id protocol = parser._inProtocol;
+		udtString nameAndClan, clan, name;
+		bool hasClan = false;
+		if(GetClanAndPlayerName(clan, name, hasClan, _stringAllocator, parser, csIndex) &&
+		   parser.GetConfigStringValueString(nameAndClan, csIndex, "n"))
+		{
+			player.NameAndClan = udtString::NewCloneFromRef(_stringAllocator, nameAndClan);
+			player.CleanNameAndClan = udtString::NewCleanCloneFromRef(_stringAllocator, protocol, nameAndClan);
+			player.Name = udtString::NewCloneFromRef(_stringAllocator, name);
+			player.CleanName = udtString::NewCleanCloneFromRef(_stringAllocator, protocol, name);
+			if(hasClan)
+			{
+				player.Clan = udtString::NewCloneFromRef(_stringAllocator, clan);
+				player.CleanClan = udtString::NewCleanCloneFromRef(_stringAllocator, protocol, clan);
+			}
+			player.HasName = true;
+			player.HasClan = hasClan;
+		}
+	}
+
+	s32 idTeam = -1;
+	player.Present = true;
+	player.HasTeam = parser.GetConfigStringValueInt(idTeam, csIndex, "t");
+	player.IdTeam = player.HasTeam ? idTeam : -1;
+}
+
+bool udtPlayerRoster::HasSameNames(const udtPlayerRosterEntry& player, udtBaseParser& parser, s32 csIndex)
+{
+	udtString nameAndClan;
+	if(!player.HasName ||
+	   !parser.GetConfigStringValueString(nameAndClan, csIndex, "n") ||
+	   !udtString::Equals(nameAndClan, player.NameAndClan))
+	{
+		return false;
+	}
+
+	if(!AreAllProtocolFlagsSet(parser._inProtocol, udtProtocolFlagsEx::QL_ClanName))
+	{
+		// The clan tag is part of the name.
+		return true;
+	}
+
+	udtString clan;
+	const bool hasClan = parser.GetConfigStringValueString(clan, csIndex, "cn");
+
+	return hasClan == player.HasClan && (!hasClan || udtString::Equals(clan, player.Clan));
+}
+
+void udtPlayerRoster::ClearPlayer(udtPlayerRosterEntry& player)
+{
+	player.NameAndClan = udtString::NewNull();
+	player.CleanNameAndClan = udtString::NewNull();
+	player.Name = udtString::NewNull();
+	player.CleanName = udtString::NewNull();
+	player.Clan = udtString::NewNull();
+	player.CleanClan = udtString::NewNull();
+	player.IdTeam = -1;
+	player.Present = false;
+	player.HasName = false;
+	player.HasClan = false;
+	player.HasTeam = false;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+
+#include "string.hpp"
+#include "linear_allocator.hpp"
+
+
+struct udtBaseParser;
+
+struct udtPlayerRosterEntry
+{
+	udtString NameAndClan; // The raw "n" value.
+	udtString CleanNameAndClan;
+	udtString Name; // Without the clan tag.
+	udtString CleanName;
+	udtString Clan; // Null when HasClan is false.
+	udtString CleanClan;
+	s32 IdTeam; // The "t" value, -1 when HasTeam is false.
+	bool Present; // False when the config string is empty (player slot unused).
+	bool HasName;
+	bool HasClan;
+	bool HasTeam;
+};
+
+// The players' names, clans and teams decoded from their config strings.
+// A player's entry is decoded on the first look-up after its config string changed
+// and the names are only cloned and cleaned again when they actually changed.
+struct udtPlayerRoster
+{
+public:
+	udtPlayerRoster();
+	~udtPlayerRoster();
+
+	void Clear(); // Must be called when the memory of the config strings gets reused.
+
+	// Returns an entry that isn't present when the index is invalid.
+	// The strings must not be modified and remain valid until Clear is called.
+	const udtPlayerRosterEntry& GetPlayer(udtBaseParser& parser, s32 playerIndex);
+
+private:
+	UDT_NO_COPY_SEMANTICS(udtPlayerRoster);
+
+	void Update(udtPlayerRosterEntry& player, udtBaseParser& parser, s32 csIndex);
+	bool HasSameNames(const udtPlayerRosterEntry& player, udtBaseParser& parser, s32 csIndex);
+	static void ClearPlayer(udtPlayerRosterEntry& player);
+
+	udtPlayerRosterEntry _players[ID_MAX_CLIENTS];
+	udtPlayerRosterEntry _invalidPlayer;
+	u32 _sourceOffsets[ID_MAX_CLIENTS]; // Of the decoded config strings in their allocator. UDT_U32_MAX when not decoded.
+	u32 _sourceLengths[ID_MAX_CLIENTS];
+	udtVMLinearAllocator _stringAllocator { "PlayerRoster::Strings" };
+};
@@ -3,6 +3,8 @@
 
 udtParserPlugInCaptures::udtParserPlugInCaptures()
 {
+	SubscribedCallbacks = (u32)udtParserPlugInCallback::GameState | (u32)udtParserPlugInCallback::Snapshot | (u32)udtParserPlugInCallback::Command;
+	SubscribedCommands = UDT_CAPTURES_ANALYZER_COMMANDS;
 }
 
 udtParserPlugInCaptures::~udtParserPlugInCaptures()
@@ -53,6 +53,12 @@ static void WriteStringsToApiStruct(u32& offsetRaw, u32& offsetClean, const udtS
 
 udtParserPlugInChat::udtParserPlugInChat()
 {
+	SubscribedCallbacks = (u32)udtParserPlugInCallback::GameState | (u32)udtParserPlugInCallback::Command;
+	SubscribedCommands = 
+		UDT_SERVER_COMMAND_BIT(Chat) | 
+		UDT_SERVER_COMMAND_BIT(TeamChat) | 
+		UDT_SERVER_COMMAND_BIT(LocalChat) | 
+		UDT_SERVER_COMMAND_BIT(CPMATeamChat);
 	_gameStateIndex = -1;
 }
 
@@ -88,7 +94,7 @@ void udtParserPlugInChat::StartDemoAnalysis()
 	_gameStateIndex = -1;
 }
 
-void udtParserPlugInChat::ProcessCommandMessage(const udtCommandCallbackArg& /*info*/, udtBaseParser& parser)
+void udtParserPlugInChat::ProcessCommandMessage(const udtCommandCallbackArg& arg, udtBaseParser& parser)
 {
 	const idTokenizer& tokenizer = parser.GetTokenizer();
 	if(tokenizer.GetArgCount() < 2)
@@ -96,81 +102,39 @@ void udtParserPlugInChat::ProcessCommandMessage(const udtCommandCallbackArg& /*i
 		return;
 	}
 
-	const udtString command = tokenizer.GetArg(0);
-	if(parser._inProtocol <= udtProtocol::Dm68 &&
-	   tokenizer.GetArgCount() == 3 &&
-	   udtString::Equals(command, "cs"))
-	{
-		s32 csIndex = -1;
-		const s32 firstPlayerCsIndex = GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::FirstPlayer, parser._inProtocol);
-		if(StringParseInt(csIndex, tokenizer.GetArgString(1)) &&
-		   csIndex >= firstPlayerCsIndex &&
-		   csIndex < firstPlayerCsIndex + 64)
-		{
-			ProcessPlayerConfigString(parser, tokenizer.GetArg(2), csIndex - firstPlayerCsIndex);
-		}
-	}
-	else if(AreAllProtocolFlagsSet(parser._inProtocol, udtProtocolFlags::RTCW) &&
+	const udtServerCommand::Id command = arg.CommandId;
+	if(AreAllProtocolFlagsSet(parser._inProtocol, udtProtocolFlags::RTCW) &&
 			tokenizer.GetArgCount() >= 2)
 	{
-		if(udtString::Equals(command, "chat") || udtString::Equals(command, "lchat"))
+		if(command == udtServerCommand::Chat || command == udtServerCommand::LocalChat)
 		{
 			ProcessWolfChatCommand(parser, false);
 		}
-		else if(udtString::Equals(command, "tchat"))
+		else if(command == udtServerCommand::TeamChat)
 		{
 			ProcessWolfChatCommand(parser, true);
 		}
 	}
 	else if(tokenizer.GetArgCount() == 2 && 
-			udtString::Equals(command, "chat"))
+			command == udtServerCommand::Chat)
 	{
 		ProcessChatCommand(parser);
 	}
 	else if(tokenizer.GetArgCount() == 2 && 
-			udtString::Equals(command, "tchat"))
+			command == udtServerCommand::TeamChat)
 	{
 		ProcessTeamChatCommand(parser);
 	}
 	else if(tokenizer.GetArgCount() == 4 && 
-			udtString::Equals(command, "mm2"))
+			command == udtServerCommand::CPMATeamChat)
 	{
 		ProcessCPMATeamChatCommand(parser);
 	}
 }
 
-void udtParserPlugInChat::ProcessGamestateMessage(const udtGamestateCallbackArg&, udtBaseParser& parser)
-{
-	++_gameStateIndex;
-
-	if(parser._inProtocol <= udtProtocol::Dm68)
-	{
-		const s32 firstPlayerCsIndex = GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::FirstPlayer, parser._inProtocol);
-		for(s32 i = 0; i < 64; ++i)
-		{
-			ProcessPlayerConfigString(parser, parser.GetConfigString(firstPlayerCsIndex + i), i);
-		}
-	}
-}
-
-void udtParserPlugInChat::ProcessPlayerConfigString(udtBaseParser& parser, const udtString& cs, s32 playerIndex)
+void udtParserPlugInChat::ProcessGamestateMessage(const udtGamestateCallbackArg& arg, udtBaseParser& /*parser*/)
 {
-	if(udtString::IsNullOrEmpty(cs))
-	{
-		_cleanPlayerNames[playerIndex] = udtString::NewEmptyConstant();
-		return;
-	}
-
-	udtVMScopedStackAllocator allocScope(*TempAllocator);
-
-	udtString playerName;
-	if(!ParseConfigStringValueString(playerName, *TempAllocator, "n", cs.GetPtr()))
-	{
-		_cleanPlayerNames[playerIndex] = udtString::NewEmptyConstant();
-		return;
-	}
-
-	_cleanPlayerNames[playerIndex] = udtString::NewCleanCloneFromRef(_stringAllocator, parser._inProtocol, playerName);
+	_gameStateIndex = arg.GameStateIndex;
 }
 
 void udtParserPlugInChat::ProcessChatCommand(udtBaseParser& parser)
@@ -210,7 +174,7 @@ void udtParserPlugInChat::ProcessChatCommand(udtBaseParser& parser)
 	}
 	else
 	{
-		ProcessQ3GlobalChat(chatEvent, argument1);
+		ProcessQ3GlobalChat(chatEvent, argument1, parser);
 	}
 
 	ChatEvents.Add(chatEvent);
@@ -335,12 +299,11 @@ void udtParserPlugInChat::ProcessCPMATeamChatCommand(udtBaseParser& parser)
 	WriteStringToApiStruct(chatEvent.Strings[0].Message, message);
 	WriteStringToApiStruct(chatEvent.Strings[1].Message, cleanMessage);
 
-	udtString playerName;
-	const s32 firstPlayerIndex = GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::FirstPlayer, protocol);
-	if(firstPlayerIndex != -1 &&
-	   ParseConfigStringValueString(playerName, _stringAllocator, "n", parser._inConfigStrings[firstPlayerIndex + clientNumber].GetPtr()))
+	const udtPlayerRosterEntry& player = parser.GetPlayer(clientNumber);
+	if(player.HasName)
 	{
-		const udtString cleanPlayerName = udtString::NewCleanCloneFromRef(_stringAllocator, protocol, playerName);
+		const udtString playerName = udtString::NewCloneFromRef(_stringAllocator, player.NameAndClan);
+		const udtString cleanPlayerName = udtString::NewCloneFromRef(_stringAllocator, player.CleanNameAndClan);
 		WriteStringToApiStruct(chatEvent.Strings[0].PlayerName, playerName);
 		WriteStringToApiStruct(chatEvent.Strings[1].PlayerName, cleanPlayerName);
 	}
@@ -444,26 +407,24 @@ void udtParserPlugInChat::ExtractPlayerIndexRelatedData(udtParseDataChat& chatEv
 
 	chatEvent.PlayerIndex = playerIndex;
 
-	const char* const cs = parser._inConfigStrings[GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::FirstPlayer, parser._inProtocol) + playerIndex].GetPtr();
-	udtString clan, player;
-	bool hasClan;
-	if(!GetClanAndPlayerName(clan, player, hasClan, *TempAllocator, parser._inProtocol, cs))
+	const udtPlayerRosterEntry& player = parser.GetPlayer(playerIndex);
+	if(!player.HasName)
 	{
 		return;
 	}
 
-	WriteStringToApiStruct(chatEvent.Strings[0].PlayerName, udtString::NewCloneFromRef(_stringAllocator, player));
-	WriteStringToApiStruct(chatEvent.Strings[1].PlayerName, udtString::NewCleanCloneFromRef(_stringAllocator, parser._inProtocol, player));
-	if(hasClan)
+	WriteStringToApiStruct(chatEvent.Strings[0].PlayerName, udtString::NewCloneFromRef(_stringAllocator, player.Name));
+	WriteStringToApiStruct(chatEvent.Strings[1].PlayerName, udtString::NewCloneFromRef(_stringAllocator, player.CleanName));
+	if(player.HasClan)
 	{
-		const udtString raw = udtString::NewCloneFromRef(_stringAllocator, clan);
-		const udtString clean = udtString::NewCleanCloneFromRef(_stringAllocator, parser._inProtocol, clan);
+		const udtString raw = udtString::NewCloneFromRef(_stringAllocator, player.Clan);
+		const udtString clean = udtString::NewCloneFromRef(_stringAllocator, player.CleanClan);
 		WriteStringToApiStruct(chatEvent.Strings[0].ClanName, raw);
 		WriteStringToApiStruct(chatEvent.Strings[1].ClanName, clean);
 	}
 }
 
-void udtParserPlugInChat::ProcessQ3GlobalChat(udtParseDataChat& chatEvent, const udtString* argument1)
+void udtParserPlugInChat::ProcessQ3GlobalChat(udtParseDataChat& chatEvent, const udtString* argument1, udtBaseParser& parser)
 {
 	//
 	// If we have a message of the form: "A: B: C", there is an ambiguity.
@@ -484,7 +445,7 @@ void udtParserPlugInChat::ProcessQ3GlobalChat(udtParseDataChat& chatEvent, const
 	for(;;)
 	{
 		const udtString name = udtString::NewSubstringClone(*TempAllocator, argument1[1], 0, colon1);
-		if(IsPlayerCleanName(name))
+		if(IsPlayerCleanName(name, parser))
 		{
 			WriteStringToApiStruct(chatEvent.Strings[1].PlayerName, udtString::NewSubstringClone(_stringAllocator, argument1[1], 0, colon1));
 			WriteStringToApiStruct(chatEvent.Strings[1].Message, udtString::NewSubstringClone(_stringAllocator, argument1[1], colon1 + 2));
@@ -539,11 +500,13 @@ void udtParserPlugInChat::ProcessQ3GlobalChat(udtParseDataChat& chatEvent, const
 	 WriteStringToApiStruct(chatEvent.Strings[0].Message, udtString::NewSubstringClone(_stringAllocator, argument1[0], colon0 + 2));
 }
 
-bool udtParserPlugInChat::IsPlayerCleanName(const udtString& cleanName)
+bool udtParserPlugInChat::IsPlayerCleanName(const udtString& cleanName, udtBaseParser& parser)
 {
 	for(s32 i = 0; i < 64; ++i)
 	{
-		if(udtString::Equals(cleanName, _cleanPlayerNames[i]))
+		const udtPlayerRosterEntry& player = parser.GetPlayer(i);
+		const udtString playerCleanName = player.HasName ? player.CleanNameAndClan : udtString::NewEmptyConstant();
+		if(udtString::Equals(cleanName, playerCleanName))
 		{
 			return true;
 		}
@@ -24,21 +24,19 @@ public:
 private:
 	UDT_NO_COPY_SEMANTICS(udtParserPlugInChat);
 
-	void ProcessPlayerConfigString(udtBaseParser& parser, const udtString& cs, s32 playerIndex);
 	void ProcessChatCommand(udtBaseParser& parser);
 	void ProcessTeamChatCommand(udtBaseParser& parser);
 	void ProcessCPMATeamChatCommand(udtBaseParser& parser);
 	void ProcessWolfChatCommand(udtBaseParser& parser, bool teamChat);
 	void ExtractPlayerIndexRelatedData(udtParseDataChat& chatEvent, const udtString& argument1, udtBaseParser& parser);
-	void ProcessQ3GlobalChat(udtParseDataChat& chatEvent, const udtString* argument1);
-	bool IsPlayerCleanName(const udtString& cleanName);
+	void ProcessQ3GlobalChat(udtParseDataChat& chatEvent, const udtString* argument1, udtBaseParser& parser);
+	bool IsPlayerCleanName(const udtString& cleanName, udtBaseParser& parser);
 	void InitChatEvent(udtParseDataChat& chatEvent, s32 serverTimeMs);
 
 public:
 	udtVMArray<udtParseDataChat> ChatEvents { "ParserPlugInChat::ChatMessagesArray" };
 
 private:
-	udtString _cleanPlayerNames[64];
 	udtVMLinearAllocator _stringAllocator { "ParserPlugInChat::Strings" };
 	udtParseDataChatBuffers _buffers;
 	s32 _gameStateIndex;
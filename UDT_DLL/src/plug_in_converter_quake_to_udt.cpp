@@ -5,6 +5,7 @@
 
 udtParserPlugInQuakeToUDT::udtParserPlugInQuakeToUDT()
 {
+	SubscribedCallbacks = (u32)udtParserPlugInCallback::GameState | (u32)udtParserPlugInCallback::Snapshot | (u32)udtParserPlugInCallback::Command;
 	_outputFile = NULL;
 	_data = (udtdData*)_allocator.AllocateAndGetAddress((uptr)sizeof(udtdData));
 	_firstSnapshot = true;
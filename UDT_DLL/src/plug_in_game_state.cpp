@@ -28,7 +28,11 @@ static bool IsInterestingKey(const char* keyName)
 
 udtParserPlugInGameState::udtParserPlugInGameState() 
 {
+	SubscribedCallbacks = (u32)udtParserPlugInCallback::GameState | (u32)udtParserPlugInCallback::Snapshot | (u32)udtParserPlugInCallback::Command;
+	SubscribedCommands = UDT_GENERAL_ANALYZER_COMMANDS;
 	_protocol = udtProtocol::Invalid;
+	_timeWindowStartMs = UDT_S32_MIN;
+	_firstMatchOnly = false;
 
 	ClearGameState();
 	ClearPlayerInfos();
@@ -71,6 +75,8 @@ u32 udtParserPlugInGameState::GetItemCount() const
 void udtParserPlugInGameState::StartDemoAnalysis()
 {
 	_protocol = udtProtocol::Invalid;
+	_timeWindowStartMs = UDT_S32_MIN;
+	_firstMatchOnly = false;
 
 	_analyzer.ResetForNextDemo();
 
@@ -88,30 +94,42 @@ void udtParserPlugInGameState::FinishDemoAnalysis()
 void udtParserPlugInGameState::ProcessGamestateMessage(const udtGamestateCallbackArg& info, udtBaseParser& parser)
 {
 	_analyzer.ProcessGamestateMessage(info, parser);
-	if(_analyzer.GameStateIndex() > 0)
+	if(_protocol != udtProtocol::Invalid) // Not the first game state read, which isn't always the demo's first one.
 	{
 		AddCurrentGameState();
 	}
 
 	_protocol = parser._inProtocol;
+	_timeWindowStartMs = parser.TimeWindowEnabled ? parser.TimeWindowStartMs : UDT_S32_MIN;
+	_firstMatchOnly = parser.FirstMatchOnly;
 
 	_currentGameState.FileOffset = parser._inFileOffset;
 	_currentGameState.FirstMatchIndex = _matches.GetSize();
 	_currentGameState.FirstKeyValuePairIndex = _keyValuePairs.GetSize();
 	_currentGameState.FirstPlayerIndex = _players.GetSize();
+	_currentGameState.Mod = (u32)_analyzer.Mod();
+	_currentGameState.GameType = (u32)_analyzer.GameType();
+	_currentGameState.Protocol = (u32)_protocol;
+	if(!udtString::IsNullOrEmpty(_analyzer.MapName()))
+	{
+		WriteStringToApiStruct(_currentGameState.MapName, udtString::NewCloneFromRef(_stringAllocator, _analyzer.MapName()));
+	}
+	else
+	{
+		WriteNullStringToApiStruct(_currentGameState.MapName);
+	}
 
 	const udtString systemInfoString = parser.GetConfigString(CS_SYSTEMINFO);
 	const udtString serverInfoString = parser.GetConfigString(CS_SERVERINFO);
 	const udtString backslashString = udtString::NewConstRef("\\");
 	const udtString* systemAndServerStringParts[3] = { &systemInfoString, &serverInfoString, &backslashString };
 	const udtString systemAndServerString = udtString::NewFromConcatenatingMultiple(_stringAllocator, systemAndServerStringParts, (u32)UDT_COUNT_OF(systemAndServerStringParts));
-	ProcessDemoTakerName(info.ClientNum, parser._inConfigStrings, parser._inProtocol);
+	ProcessDemoTakerName(info.ClientNum, parser);
 	ProcessSystemAndServerInfo(systemAndServerString);
 
-	const s32 playerCSBaseIndex = GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::FirstPlayer, parser._inProtocol);
 	for(s32 i = 0; i < 64; ++i)
 	{
-		ProcessPlayerInfo(i, parser._inConfigStrings[playerCSBaseIndex + i], UDT_S32_MIN);
+		ProcessPlayerInfo(i, parser, UDT_S32_MIN);
 	}
 }
 
@@ -136,8 +154,8 @@ void udtParserPlugInGameState::ProcessCommandMessage(const udtCommandCallbackArg
 
 	const idTokenizer& tokenizer = parser.GetTokenizer();
 	s32 csIndex = 0;
-	if(tokenizer.GetArgCount() != 3 || 
-	   !udtString::Equals(tokenizer.GetArg(0), "cs") || 
+	if(info.CommandId != udtServerCommand::ConfigString ||
+	   tokenizer.GetArgCount() != 3 || 
 	   !StringParseInt(csIndex, tokenizer.GetArgString(1)))
 	{
 		return;
@@ -146,7 +164,7 @@ void udtParserPlugInGameState::ProcessCommandMessage(const udtCommandCallbackArg
 	const s32 firstPlayerCsIndex = GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::FirstPlayer, _protocol);
 	if(csIndex >= firstPlayerCsIndex && csIndex < firstPlayerCsIndex + 64)
 	{
-		ProcessPlayerInfo(csIndex - firstPlayerCsIndex, parser._inConfigStrings[csIndex], parser._inServerTime);
+		ProcessPlayerInfo(csIndex - firstPlayerCsIndex, parser, parser._inServerTime);
 	}
 }
 
@@ -175,6 +193,11 @@ void udtParserPlugInGameState::ClearGameState()
 	_currentGameState.KeyValuePairCount = 0;
 	_currentGameState.FirstPlayerIndex = 0;
 	_currentGameState.PlayerCount = 0;
+	WriteNullStringToApiStruct(_currentGameState.MapName);
+	_currentGameState.Mod = (u32)udtMod::None;
+	_currentGameState.GameType = (u32)udtGameType::Invalid;
+	_currentGameState.Protocol = (u32)udtProtocol::Invalid;
+	_currentGameState.Reserved1 = 0;
 }
 
 void udtParserPlugInGameState::AddCurrentMatchIfValid(bool addIfInProgress)
@@ -187,7 +210,7 @@ void udtParserPlugInGameState::AddCurrentMatchIfValid(bool addIfInProgress)
 	}
 
 	udtMatchInfo match;
-	match.MatchStartTimeMs = _analyzer.MatchStartTime();
+	match.MatchStartTimeMs = udt_max(_analyzer.MatchStartTime(), _timeWindowStartMs); // The analysis might have started mid-match.
 	match.MatchEndTimeMs = _analyzer.MatchEndTime();
 	match.WarmUpEndTimeMs = UDT_S32_MIN;
 	
@@ -199,6 +222,11 @@ void udtParserPlugInGameState::AddCurrentMatchIfValid(bool addIfInProgress)
 	
 	_matches.Add(match);
 	++_currentGameState.MatchCount;
+
+	if(_firstMatchOnly)
+	{
+		Done = true;
+	}
 }
 
 void udtParserPlugInGameState::AddCurrentPlayersIfValid()
@@ -225,7 +253,7 @@ void udtParserPlugInGameState::AddCurrentGameState()
 	ClearPlayerInfos();
 }
 
-void udtParserPlugInGameState::ProcessDemoTakerName(s32 playerIndex, const udtString* configStrings, udtProtocol::Id protocol)
+void udtParserPlugInGameState::ProcessDemoTakerName(s32 playerIndex, udtBaseParser& parser)
 {
 	_currentGameState.DemoTakerPlayerIndex = playerIndex;
 	_currentGameState.DemoTakerName = UDT_U32_MAX; // Not available in all demo protocols.
@@ -236,20 +264,10 @@ void udtParserPlugInGameState::ProcessDemoTakerName(s32 playerIndex, const udtSt
 		return;
 	}
 
-	const s32 firstPlayerCsIndex = GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::FirstPlayer, protocol);
-	const udtString& cs = configStrings[firstPlayerCsIndex + playerIndex];
-	if(udtString::IsNullOrEmpty(cs))
+	const udtPlayerRosterEntry& player = parser.GetPlayer(playerIndex);
+	if(player.HasName)
 	{
-		return;
-	}
-
-	udtVMScopedStackAllocator allocatorScope(*TempAllocator);
-
-	udtString clan, name;
-	bool hasClan;
-	if(GetClanAndPlayerName(clan, name, hasClan, *TempAllocator, protocol, cs.GetPtr()))
-	{
-		WriteStringToApiStruct(_currentGameState.DemoTakerName, udtString::NewCleanCloneFromRef(_stringAllocator, protocol, name));
+		WriteStringToApiStruct(_currentGameState.DemoTakerName, udtString::NewCloneFromRef(_stringAllocator, player.CleanName));
 	}
 }
 
@@ -294,32 +312,26 @@ void udtParserPlugInGameState::ProcessSystemAndServerInfo(const udtString& confi
 	_currentGameState.KeyValuePairCount = _keyValuePairs.GetSize() - previousCount;
 }
 
-void udtParserPlugInGameState::ProcessPlayerInfo(s32 playerIndex, const udtString& configString, s32 serverTimeMs)
+void udtParserPlugInGameState::ProcessPlayerInfo(s32 playerIndex, udtBaseParser& parser, s32 serverTimeMs)
 {
-	udtVMScopedStackAllocator tempAllocScope(*TempAllocator);
-
-	const bool csValid = !udtString::IsNullOrEmpty(configString);
+	const udtPlayerRosterEntry& player = parser.GetPlayer(playerIndex);
+	const bool csValid = player.Present;
 	const bool connected = _playerConnected[playerIndex];
 
 	// Player connected?
 	if(csValid && !connected)
 	{
-		udtString clan, name, finalName;
-		bool hasClan;
-		if(!GetClanAndPlayerName(clan, name, hasClan, *TempAllocator, _protocol, configString.GetPtr()))
+		udtString finalName;
+		if(!player.HasName)
 		{
 			finalName = udtString::NewClone(_stringAllocator, "N/A");
 		}
 		else
 		{
-			finalName = udtString::NewCleanCloneFromRef(_stringAllocator, _protocol, name);
+			finalName = udtString::NewCloneFromRef(_stringAllocator, player.CleanName);
 		}
 
-		s32 idTeamIndex = -1;
-		if(!ParseConfigStringValueInt(idTeamIndex, *TempAllocator, "t", configString.GetPtr()))
-		{
-			idTeamIndex = -1;
-		}
+		const s32 idTeamIndex = player.IdTeam;
 		u32 udtTeamIndex = udtTeam::Count;
 		GetUDTNumber(udtTeamIndex, udtMagicNumberType::Team, idTeamIndex, _protocol);
 
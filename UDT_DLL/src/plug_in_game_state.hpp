@@ -34,9 +34,9 @@ private:
 	void AddCurrentMatchIfValid(bool addIfInProgress = false);
 	void AddCurrentPlayersIfValid();
 	void AddCurrentGameState();
-	void ProcessDemoTakerName(s32 playerIndex, const udtString* configStrings, udtProtocol::Id protocol);
+	void ProcessDemoTakerName(s32 playerIndex, udtBaseParser& parser);
 	void ProcessSystemAndServerInfo(const udtString& configStrings);
-	void ProcessPlayerInfo(s32 playerIndex, const udtString& configString, s32 serverTimeMs);
+	void ProcessPlayerInfo(s32 playerIndex, udtBaseParser& parser, s32 serverTimeMs);
 
 private:
 	udtGeneralAnalyzer _analyzer;
@@ -50,4 +50,6 @@ private:
 	udtParseDataGameState _currentGameState;
 	udtParseDataGameStateBuffers _buffers;
 	udtProtocol::Id _protocol;
+	s32 _timeWindowStartMs; // Matches in progress when the time window starts are clamped to it.
+	bool _firstMatchOnly;
 };
@@ -9,6 +9,8 @@ struct udtParserPlugInObituaries : udtBaseParserPlugIn
 public:
 	udtParserPlugInObituaries()
 	{
+		SubscribedCallbacks = (u32)udtParserPlugInCallback::GameState | (u32)udtParserPlugInCallback::Snapshot | (u32)udtParserPlugInCallback::Command;
+		SubscribedCommands = UDT_SERVER_COMMAND_BIT(ConfigString);
 	}
 
 	~udtParserPlugInObituaries()
@@ -97,6 +97,9 @@ udtPatternSearchPlugIn::udtPatternSearchPlugIn()
 	_analyzerAllocator.Init((uptr)SizeOfAllAnalyzers);
 
 	_analyzerAllocatorScope.SetAllocator(_analyzerAllocator);
+
+	// Needed to find the tracked player.
+	SubscribedCommands = UDT_SERVER_COMMAND_BIT(ConfigString);
 }
 
 void udtPatternSearchPlugIn::InitAllocators(u32)
@@ -133,6 +136,7 @@ udtPatternSearchAnalyzerBase* udtPatternSearchPlugIn::CreateAndAddAnalyzer(udtPa
 		analyzer->ExtraInfo = extraInfo;
 		_analyzers.Add(analyzer);
 		_analyzerTypes.Add(patternType);
+		SubscribedCommands |= analyzer->SubscribedCommands;
 	}
 
 	return analyzer;
@@ -203,14 +207,13 @@ void udtPatternSearchPlugIn::FindPlayerInConfigStrings(udtBaseParser& parser)
 {
 	const udtPatternSearchArg pi = GetInfo();
 
-	const s32 firstPlayerCsIdx = GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::FirstPlayer, parser._inProtocol);
 	for(s32 i = 0; i < ID_MAX_CLIENTS; ++i)
 	{
 		udtVMScopedStackAllocator allocatorScope(*TempAllocator);
 
-		udtString playerName;
-		if(GetPlayerName(playerName, *TempAllocator, parser, firstPlayerCsIdx + i) &&
-		   MatchesRules(*TempAllocator, playerName, pi.PlayerNameRules, pi.PlayerNameRuleCount, parser._inProtocol))
+		const udtPlayerRosterEntry& player = parser.GetPlayer(i);
+		if(player.HasName &&
+		   MatchesRules(*TempAllocator, player.Name, pi.PlayerNameRules, pi.PlayerNameRuleCount, parser._inProtocol))
 		{
 			_trackedPlayerIndex = i;
 			break;
@@ -251,9 +254,9 @@ void udtPatternSearchPlugIn::FindPlayerInServerCommand(const udtCommandCallbackA
 
 	udtVMScopedStackAllocator allocatorScope(*TempAllocator);
 
-	udtString playerName;
-	if(GetPlayerName(playerName, *TempAllocator, parser, info.ConfigStringIndex) &&
-	   MatchesRules(*TempAllocator, playerName, pi.PlayerNameRules, pi.PlayerNameRuleCount, parser._inProtocol))
+	const udtPlayerRosterEntry& player = parser.GetPlayer(playerIndex);
+	if(player.HasName &&
+	   MatchesRules(*TempAllocator, player.Name, pi.PlayerNameRules, pi.PlayerNameRuleCount, parser._inProtocol))
 	{
 		_trackedPlayerIndex = playerIndex;
 	}
@@ -292,23 +295,64 @@ void udtPatternSearchPlugIn::FinishDemoAnalysis()
 		_analyzers[i]->FinishAnalysis();
 	}
 
+	BuildCutSections(CutSections, false);
+}
+
+u32 udtPatternSearchPlugIn::GetCurrentCutSectionCount() const
+{
+	u32 cutCount = 0;
+	for(u32 i = 0, analyzerCount = _analyzers.GetSize(); i < analyzerCount; ++i)
+	{
+		cutCount += _analyzers[i]->GetCurrentCutSectionCount();
+	}
+
+	return cutCount;
+}
+
+void udtPatternSearchPlugIn::GetCurrentCutSections(udtVMArray<udtCutSection>& cutSections)
+{
+	if(_analyzers.GetSize() == 0)
+	{
+		cutSections.Clear();
+		return;
+	}
+
+	BuildCutSections(cutSections, true);
+}
+
+const udtVMArray<udtCutSection>& udtPatternSearchPlugIn::GetAnalyzerCutSections(u32 analyzerIndex, bool current)
+{
+	if(!current)
+	{
+		return _analyzers[analyzerIndex]->CutSections;
+	}
+
+	_analyzers[analyzerIndex]->GetCurrentCutSections(_analyzerCutSections);
+
+	return _analyzerCutSections;
+}
+
+void udtPatternSearchPlugIn::BuildCutSections(udtVMArray<udtCutSection>& result, bool current)
+{
+	result.Clear();
+
 	// If we only have 1 analyzer, we don't need to do any sorting.
 	if(_analyzers.GetSize() == 1)
 	{
-		MergeRanges(CutSections, _analyzers[0]->CutSections);
+		MergeRanges(result, GetAnalyzerCutSections(0, current));
 		return;
 	}
 
 	//
 	// Create a list with all the cut sections.
 	//
-	udtVMArray<CutSection> tempCutSections("CutByPatternPlugIn::FinishDemoAnalysis::TempCutSectionsArray");
+	udtVMArray<CutSection> tempCutSections("CutByPatternPlugIn::BuildCutSections::TempCutSectionsArray");
 	for(u32 i = 0, analyzerCount = _analyzers.GetSize(); i < analyzerCount; ++i)
 	{
-		udtPatternSearchAnalyzerBase* const analyzer = _analyzers[i];
-		for(u32 j = 0, cutCount = analyzer->CutSections.GetSize(); j < cutCount; ++j)
+		const udtVMArray<udtCutSection>& analyzerCutSections = GetAnalyzerCutSections(i, current);
+		for(u32 j = 0, cutCount = analyzerCutSections.GetSize(); j < cutCount; ++j)
 		{
-			const udtCutSection cut = _analyzers[i]->CutSections[j];
+			const udtCutSection cut = analyzerCutSections[j];
 			CutSection newCut;
 			newCut.udtCutSection::operator=(cut);
 			tempCutSections.Add(newCut);
@@ -337,14 +381,13 @@ void udtPatternSearchPlugIn::FinishDemoAnalysis()
 	//
 	if((GetInfo().Flags & (u32)udtPatternSearchArgMask::MergeCutSections) != 0)
 	{
-		udtVMArray<udtCutSection> cutSections("CutByPatternPlugIn::FinishDemoAnalysis::MergedCutSectionsArray");
+		udtVMArray<udtCutSection> cutSections("CutByPatternPlugIn::BuildCutSections::MergedCutSectionsArray");
 		AppendCutSections(cutSections, tempCutSections);
-		MergeRanges(CutSections, cutSections);
+		MergeRanges(result, cutSections);
 	}
 	else
 	{
-		CutSections.Clear();
-		AppendCutSections(CutSections, tempCutSections);
+		AppendCutSections(result, tempCutSections);
 	}
 }
 
@@ -352,16 +395,3 @@ s32 udtPatternSearchPlugIn::GetTrackedPlayerIndex() const
 {
 	return _trackedPlayerIndex;
 }
-
-bool udtPatternSearchPlugIn::GetPlayerName(udtString& playerName, udtVMLinearAllocator& allocator, udtBaseParser& parser, s32 csIdx)
-{
-	udtString clan;
-	bool hasClan;
-	if(!GetClanAndPlayerName(clan, playerName, hasClan, allocator, parser._inProtocol, parser._inConfigStrings[csIdx].GetPtr()))
-	{
-		playerName = udtString::NewEmptyConstant();
-		return false;
-	}
-
-	return true;
-}
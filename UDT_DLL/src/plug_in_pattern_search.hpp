@@ -28,6 +28,11 @@ public:
 
 	void SetPatternInfo(const udtPatternSearchArg& info) { _info = &info; }
 
+	// Sorted and merged like the final array, for writing cuts while the demo is still being analyzed.
+	// The count only goes up during a demo, so it can be used to know when the sections changed.
+	u32  GetCurrentCutSectionCount() const;
+	void GetCurrentCutSections(udtVMArray<udtCutSection>& cutSections);
+
 	s32 GetTrackedPlayerIndex() const;
 	const udtPatternSearchArg& GetInfo() const { return *_info; }
 
@@ -40,10 +45,12 @@ private:
 
 	void FindPlayerInConfigStrings(udtBaseParser& parser);
 	void FindPlayerInServerCommand(const udtCommandCallbackArg& info, udtBaseParser& parser);
-	bool GetPlayerName(udtString& playerName, udtVMLinearAllocator& allocator, udtBaseParser& parser, s32 csIdx);
+	void BuildCutSections(udtVMArray<udtCutSection>& result, bool current);
+	const udtVMArray<udtCutSection>& GetAnalyzerCutSections(u32 analyzerIndex, bool current);
 
 	udtVMArray<udtPatternSearchAnalyzerBase*> _analyzers { "CutByPatternPlugIn::AnalyzersArray" };
 	udtVMArray<udtPatternType::Id> _analyzerTypes { "CutByPatternPlugIn::AnalyzerTypesArray" };
+	udtVMArray<udtCutSection> _analyzerCutSections { "CutByPatternPlugIn::AnalyzerCutSectionsArray" }; // Temporary.
 	udtVMLinearAllocator _analyzerAllocator { "CutByPatternPlugIn::AnalyzerData" };
 	udtVMScopedStackAllocator _analyzerAllocatorScope;
 
@@ -4,6 +4,7 @@
 
 udtParserPlugInRawCommands::udtParserPlugInRawCommands()
 {
+	SubscribedCallbacks = (u32)udtParserPlugInCallback::GameState | (u32)udtParserPlugInCallback::Command;
 }
 
 udtParserPlugInRawCommands::~udtParserPlugInRawCommands()
@@ -42,9 +43,9 @@ void udtParserPlugInRawCommands::FinishDemoAnalysis()
 {
 }
 
-void udtParserPlugInRawCommands::ProcessGamestateMessage(const udtGamestateCallbackArg& /*arg*/, udtBaseParser& /*parser*/)
+void udtParserPlugInRawCommands::ProcessGamestateMessage(const udtGamestateCallbackArg& arg, udtBaseParser& /*parser*/)
 {
-	++_gameStateIndex;
+	_gameStateIndex = arg.GameStateIndex;
 }
 
 void udtParserPlugInRawCommands::ProcessCommandMessage(const udtCommandCallbackArg& arg, udtBaseParser& parser)
@@ -57,7 +58,3 @@ void udtParserPlugInRawCommands::ProcessCommandMessage(const udtCommandCallbackA
 	WriteStringToApiStruct(info.RawCommand, rawCommand);
 	_commands.Add(info);
 }
-
-void udtParserPlugInRawCommands::ProcessSnapshotMessage(const udtSnapshotCallbackArg& /*arg*/, udtBaseParser& /*parser*/)
-{
-}
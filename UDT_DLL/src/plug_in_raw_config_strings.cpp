@@ -4,6 +4,7 @@
 
 udtParserPlugInRawConfigStrings::udtParserPlugInRawConfigStrings()
 {
+	SubscribedCallbacks = (u32)udtParserPlugInCallback::GameState;
 }
 
 udtParserPlugInRawConfigStrings::~udtParserPlugInRawConfigStrings()
@@ -42,9 +43,9 @@ void udtParserPlugInRawConfigStrings::FinishDemoAnalysis()
 {
 }
 
-void udtParserPlugInRawConfigStrings::ProcessGamestateMessage(const udtGamestateCallbackArg& /*arg*/, udtBaseParser& parser)
+void udtParserPlugInRawConfigStrings::ProcessGamestateMessage(const udtGamestateCallbackArg& arg, udtBaseParser& parser)
 {
-	++_gameStateIndex;
+	_gameStateIndex = arg.GameStateIndex;
 
 	for(s32 i = 0; i < MAX_CONFIGSTRINGS; ++i)
 	{
@@ -26,6 +26,8 @@ static void CloneConfigString(udtString& string, udtVMLinearAllocator& alloc, ud
 
 udtParserPlugInScores::udtParserPlugInScores()
 {
+	SubscribedCallbacks = (u32)udtParserPlugInCallback::GameState | (u32)udtParserPlugInCallback::Snapshot | (u32)udtParserPlugInCallback::Command | (u32)udtParserPlugInCallback::MessageBundleEnd;
+	SubscribedCommands = UDT_SERVER_COMMAND_BIT(ConfigString) | UDT_SERVER_COMMAND_BIT(CPMADMScores);
 }
 
 udtParserPlugInScores::~udtParserPlugInScores()
@@ -88,9 +90,8 @@ void udtParserPlugInScores::FinishDemoAnalysis()
 	}
 }
 
-void udtParserPlugInScores::ProcessGamestateMessage(const udtGamestateCallbackArg& /*arg*/, udtBaseParser& parser)
+void udtParserPlugInScores::ProcessGamestateMessage(const udtGamestateCallbackArg& arg, udtBaseParser& parser)
 {
-	const s32 csIndexFirstPlayer = GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::FirstPlayer, parser._inProtocol, _mod);
 	_score1 = SCORE_NO_ONE;
 	_score2 = SCORE_NO_ONE;
 	_clientNumber1 = 64;
@@ -101,7 +102,7 @@ void udtParserPlugInScores::ProcessGamestateMessage(const udtGamestateCallbackAr
 	_name1 = udtString::NewNull();
 	_name2 = udtString::NewNull();
 	_parser = &parser;
-	++_gameStateIndex;
+	_gameStateIndex = arg.GameStateIndex;
 	_protocol = parser._inProtocol;
 	if(!AreAllProtocolFlagsSet(_protocol, udtProtocolFlags::QuakeLive))
 	{
@@ -110,7 +111,7 @@ void udtParserPlugInScores::ProcessGamestateMessage(const udtGamestateCallbackAr
 	DetectGameType();
 	for(u32 i = 0; i < 64; ++i)
 	{
-		ProcessPlayerConfigString(i, parser.GetConfigString(csIndexFirstPlayer + i).GetPtr());
+		ProcessPlayerConfigString(i);
 	}
 	if(_mod == udtMod::CPMA)
 	{
@@ -155,8 +156,8 @@ void udtParserPlugInScores::ProcessCommandMessage(const udtCommandCallbackArg& a
 	{
 		const idTokenizer& tokenizer = parser.GetTokenizer();
 		if(_mod == udtMod::CPMA &&
-		   tokenizer.GetArgCount() >= 3 &&
-		   udtString::EqualsNoCase(tokenizer.GetArg(0), "dmscores"))
+		   arg.CommandIdNoCase == udtServerCommand::CPMADMScores &&
+		   tokenizer.GetArgCount() >= 3)
 		{
 			StringParseInt(_clientNumber1, tokenizer.GetArgString(1)); // First place client number.
 			StringParseInt(_clientNumber2, tokenizer.GetArgString(2)); // Second place client number.
@@ -168,7 +169,7 @@ void udtParserPlugInScores::ProcessCommandMessage(const udtCommandCallbackArg& a
 	const s32 csIndexFirstPlayer = GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::FirstPlayer, _protocol, _mod);
 	if(arg.ConfigStringIndex >= csIndexFirstPlayer && arg.ConfigStringIndex < csIndexFirstPlayer + 64)
 	{
-		ProcessPlayerConfigString(arg.ConfigStringIndex - csIndexFirstPlayer, parser.GetConfigString(arg.ConfigStringIndex).GetPtr());
+		ProcessPlayerConfigString((u32)(arg.ConfigStringIndex - csIndexFirstPlayer));
 	}
 
 	if(_mod == udtMod::CPMA)
@@ -224,9 +225,10 @@ void udtParserPlugInScores::ProcessMessageBundleEnd(const udtMessageBundleCallba
 	}
 }
 
-void udtParserPlugInScores::ProcessPlayerConfigString(u32 index, const char* cs)
+void udtParserPlugInScores::ProcessPlayerConfigString(u32 index)
 {
-	if(udtString::IsNullOrEmpty(cs))
+	const udtPlayerRosterEntry& player = _parser->GetPlayer((s32)index);
+	if(!player.Present)
 	{
 		_players[index].Present = 0;
 		return;
@@ -234,21 +236,17 @@ void udtParserPlugInScores::ProcessPlayerConfigString(u32 index, const char* cs)
 
 	_players[index].Present = 1;
 
-	udtVMScopedStackAllocator allocatorScope(*TempAllocator);
-
-	udtString name;
-	if(ParseConfigStringValueString(name, *TempAllocator, "n", cs))
+	if(player.HasName)
 	{
-		_players[index].Name = udtString::NewCloneFromRef(_stringAllocator, name);
+		_players[index].Name = udtString::NewCloneFromRef(_stringAllocator, player.NameAndClan);
 	}
 
 	if(AreAllProtocolFlagsSet(_protocol, udtProtocolFlagsEx::QL_ClanName))
 	{
-		udtString clan;
-		if(ParseConfigStringValueString(clan, *TempAllocator, "cn", cs) &&
-		   !udtString::IsNullOrEmpty(clan))
+		if(player.HasClan &&
+		   !udtString::IsNullOrEmpty(player.Clan))
 		{
-			_players[index].Clan = udtString::NewCloneFromRef(_stringAllocator, clan);
+			_players[index].Clan = udtString::NewCloneFromRef(_stringAllocator, player.Clan);
 		}
 		else
 		{
@@ -256,10 +254,9 @@ void udtParserPlugInScores::ProcessPlayerConfigString(u32 index, const char* cs)
 		}
 	}
 
-	s32 idTeam;
 	u32 udtTeam;
-	if(ParseConfigStringValueInt(idTeam, *TempAllocator, "t", cs) &&
-	   GetUDTNumber(udtTeam, udtMagicNumberType::Team, idTeam, _protocol, _mod))
+	if(player.HasTeam &&
+	   GetUDTNumber(udtTeam, udtMagicNumberType::Team, player.IdTeam, _protocol, _mod))
 	{
 		_players[index].Team = (u8)udtTeam;
 	}
@@ -267,31 +264,15 @@ void udtParserPlugInScores::ProcessPlayerConfigString(u32 index, const char* cs)
 
 void udtParserPlugInScores::ProcessCPMAScores(s32 csIndex)
 {
-	const char* const cs = _parser->GetConfigString(csIndex).GetPtr();
-	if(cs == NULL)
-	{
-		return;
-	}
-
-	udtVMScopedStackAllocator allocatorScope(*TempAllocator);
-
-	ParseConfigStringValueInt(_score1, *TempAllocator, "sb", cs);
-	ParseConfigStringValueInt(_score2, *TempAllocator, "sr", cs);
+	_parser->GetConfigStringValueInt(_score1, csIndex, "sb");
+	_parser->GetConfigStringValueInt(_score2, csIndex, "sr");
 }
 
 void udtParserPlugInScores::DetectGameType()
 {
-	const char* const cs = _parser->GetConfigString(CS_SERVERINFO).GetPtr();
-	if(cs == NULL)
-	{
-		return;
-	}
-
-	udtVMScopedStackAllocator scopedTempAllocator(*TempAllocator);
-
 	s32 idGT = 0;
 	u32 udtGT = 0;
-	if(ParseConfigStringValueInt(idGT, *TempAllocator, "g_gametype", cs) &&
+	if(_parser->GetConfigStringValueInt(idGT, CS_SERVERINFO, "g_gametype") &&
 	   GetUDTNumber(udtGT, udtMagicNumberType::GameType, idGT, _protocol, _mod))
 	{
 		_gameType = (udtGameType::Id)udtGT;
@@ -300,26 +281,18 @@ void udtParserPlugInScores::DetectGameType()
 
 void udtParserPlugInScores::DetectMod()
 {
-	const char* const cs = _parser->GetConfigString(CS_SERVERINFO).GetPtr();
-	if(cs == NULL)
-	{
-		return;
-	}
-
-	udtVMScopedStackAllocator scopedTempAllocator(*TempAllocator);
-
 	udtString varValue;
-	if(ParseConfigStringValueString(varValue, *TempAllocator, "gamename", cs) &&
+	if(_parser->GetConfigStringValueString(varValue, CS_SERVERINFO, "gamename") &&
 	   udtString::Equals(varValue, "cpma"))
 	{
 		_mod = udtMod::CPMA;
 	}
-	else if(ParseConfigStringValueString(varValue, *TempAllocator, "gamename", cs) &&
+	else if(_parser->GetConfigStringValueString(varValue, CS_SERVERINFO, "gamename") &&
 			udtString::ContainsNoCase(varValue, "osp"))
 	{
 		_mod = udtMod::OSP;
 	}
-	else if(ParseConfigStringValueString(varValue, *TempAllocator, "gameversion", cs) &&
+	else if(_parser->GetConfigStringValueString(varValue, CS_SERVERINFO, "gameversion") &&
 			udtString::ContainsNoCase(varValue, "osp"))
 	{
 		_mod = udtMod::OSP;
@@ -35,7 +35,7 @@ private:
 		u8 Team;
 	};
 
-	void ProcessPlayerConfigString(u32 index, const char* cs);
+	void ProcessPlayerConfigString(u32 index);
 	void ProcessServerInfo();
 	void ProcessCPMAScores(s32 csIndex);
 	void DetectGameType();
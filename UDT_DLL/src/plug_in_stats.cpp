@@ -105,9 +105,42 @@ static const char* GetIdTeamName(s32 idTeamIndex, udtProtocol::Id protocol)
 
 udtParserPlugInStats::udtParserPlugInStats()
 {
+	SubscribedCallbacks = (u32)udtParserPlugInCallback::GameState | (u32)udtParserPlugInCallback::Snapshot | (u32)udtParserPlugInCallback::Command;
+	SubscribedCommands = 
+		UDT_GENERAL_ANALYZER_COMMANDS | 
+		UDT_SERVER_COMMAND_BIT(ScoresTDM) | 
+		UDT_SERVER_COMMAND_BIT(TDMStats) | 
+		UDT_SERVER_COMMAND_BIT(ScoresDuel) | 
+		UDT_SERVER_COMMAND_BIT(ScoresCTF) | 
+		UDT_SERVER_COMMAND_BIT(CTFStats) | 
+		UDT_SERVER_COMMAND_BIT(Scores) | 
+		UDT_SERVER_COMMAND_BIT(DScores) | 
+		UDT_SERVER_COMMAND_BIT(CPMAXStats2) | 
+		UDT_SERVER_COMMAND_BIT(CPMAMStats) | 
+		UDT_SERVER_COMMAND_BIT(CPMAXStats2a) | 
+		UDT_SERVER_COMMAND_BIT(CPMAMStatsa) | 
+		UDT_SERVER_COMMAND_BIT(CPMADuelEndScores) | 
+		UDT_SERVER_COMMAND_BIT(CPMAXScores) | 
+		UDT_SERVER_COMMAND_BIT(CPMADMScores) | 
+		UDT_SERVER_COMMAND_BIT(TDMScores) | 
+		UDT_SERVER_COMMAND_BIT(TDMScores2) | 
+		UDT_SERVER_COMMAND_BIT(StatsInfo) | 
+		UDT_SERVER_COMMAND_BIT(ScoresCA) | 
+		UDT_SERVER_COMMAND_BIT(CTFScores) | 
+		UDT_SERVER_COMMAND_BIT(CAScores) | 
+		UDT_SERVER_COMMAND_BIT(CAStats) | 
+		UDT_SERVER_COMMAND_BIT(XStats1) | 
+		UDT_SERVER_COMMAND_BIT(ADScores) | 
+		UDT_SERVER_COMMAND_BIT(ScoresAD) | 
+		UDT_SERVER_COMMAND_BIT(ScoresFT) | 
+		UDT_SERVER_COMMAND_BIT(RRScores) | 
+		UDT_SERVER_COMMAND_BIT(ScoresRR) | 
+		UDT_SERVER_COMMAND_BIT(WolfWeaponStats) | 
+		UDT_SERVER_COMMAND_BIT(WolfScores);
 	_tokenizer = NULL;
 	_plugInTokenizer = NULL;
 	_protocol = udtProtocol::Invalid;
+	_firstMatchOnly = false;
 	_followedClientNumber = -1;
 	_disableStatsOverrides = false;
 	_lastMatchEndTime = UDT_S32_MIN;
@@ -161,6 +194,7 @@ void udtParserPlugInStats::StartDemoAnalysis()
 	_tokenizer = NULL;
 	_plugInTokenizer = NULL;
 	_protocol = udtProtocol::Invalid;
+	_firstMatchOnly = false;
 	_followedClientNumber = -1;
 	_disableStatsOverrides = false;
 	_lastMatchEndTime = UDT_S32_MIN;
@@ -196,6 +230,7 @@ void udtParserPlugInStats::ProcessGamestateMessage(const udtGamestateCallbackArg
 	_tokenizer = &parser.GetTokenizer();
 	_plugInTokenizer = &parser._context->Tokenizer;
 	_protocol = parser._inProtocol;
+	_firstMatchOnly = parser.FirstMatchOnly;
 	_followedClientNumber = -1;
 
 	// we delay the allocation of team names since we need to know the protocol
@@ -222,20 +257,20 @@ void udtParserPlugInStats::ProcessGamestateMessage(const udtGamestateCallbackArg
 	const s32 firstPlayerCs = GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::FirstPlayer, _protocol);
 	for(s32 i = 0; i < 64; ++i)
 	{
-		ProcessPlayerConfigString(parser.GetConfigString(firstPlayerCs + i).GetPtr(), i);
+		ProcessPlayerConfigString(parser, firstPlayerCs + i, i);
 	}
 
 	if(_analyzer.Mod() == udtMod::CPMA)
 	{
-		ProcessConfigString(CS_CPMA_GAME_INFO, parser.GetConfigString(CS_CPMA_GAME_INFO));
-		ProcessConfigString(CS_CPMA_ROUND_INFO, parser.GetConfigString(CS_CPMA_ROUND_INFO));
+		ProcessConfigString(parser, CS_CPMA_GAME_INFO);
+		ProcessConfigString(parser, CS_CPMA_ROUND_INFO);
 	}
 	else
 	{
 		const s32 scores1Id = GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::Scores1, _protocol);
 		const s32 scores2Id = GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::Scores2, _protocol);
-		ProcessConfigString(scores1Id, parser.GetConfigString(scores1Id));
-		ProcessConfigString(scores2Id, parser.GetConfigString(scores2Id));
+		ProcessConfigString(parser, scores1Id);
+		ProcessConfigString(parser, scores2Id);
 	}
 }
 
@@ -255,13 +290,12 @@ void udtParserPlugInStats::ProcessCommandMessage(const udtCommandCallbackArg& ar
 		return;
 	}
 
-	const udtString commandName = _tokenizer->GetArg(0);
 	s32 csIndex = -1;
 	if(_tokenizer->GetArgCount() == 3 && 
-	   udtString::Equals(commandName, "cs") &&
+	   arg.CommandId == udtServerCommand::ConfigString &&
 	   StringParseInt(csIndex, _tokenizer->GetArgString(1)))
 	{
-		ProcessConfigString(csIndex, _tokenizer->GetArg(2));
+		ProcessConfigString(parser, csIndex);
 	}
 
 	if(!_analyzer.IsMatchInProgress() &&
@@ -273,43 +307,43 @@ void udtParserPlugInStats::ProcessCommandMessage(const udtCommandCallbackArg& ar
 	struct CommandHandler
 	{
 		typedef void (udtParserPlugInStats::*MemberFunction)();
-		const char* Name;
+		udtServerCommand::Id Command;
 		MemberFunction Function;
 	};
 
-#define HANDLER(Name, Function) { Name, &udtParserPlugInStats::Function }
+#define HANDLER(Command, Function) { udtServerCommand::Command, &udtParserPlugInStats::Function }
 	static const CommandHandler handlers[] =
 	{
-		HANDLER("scores_tdm", ParseQLScoresTDM),
-		HANDLER("tdmstats", ParseQLStatsTDM),
-		HANDLER("scores_duel", ParseQLScoresDuel),
-		HANDLER("scores_ctf", ParseQLScoresCTF),
-		HANDLER("ctfstats", ParseQLStatsCTF),
-		HANDLER("scores", ParseScores),
-		HANDLER("dscores", ParseQLScoresDuelOld),
-		HANDLER("xstats2", ParseCPMAXStats2),
-		HANDLER("mstats", ParseCPMAMStats),
-		HANDLER("xstats2a", ParseCPMAXStats2a),
-		HANDLER("mstatsa", ParseCPMAMStatsa),
-		HANDLER("duelendscores", ParseCPMADuelEndScores),
-		HANDLER("xscores", ParseCPMAXScores),
-		HANDLER("dmscores", ParseCPMADMScores),
-		HANDLER("tdmscores", ParseQLScoresTDMVeryOld),
-		HANDLER("tdmscores2", ParseQLScoresTDMOld),
-		HANDLER("statsinfo", ParseOSPStatsInfo),
-		HANDLER("scores_ca", ParseQLScoresCA),
-		HANDLER("ctfscores", ParseQLScoresCTFOld),
-		HANDLER("cascores", ParseQLScoresCAOld),
-		HANDLER("castats", ParseQLStatsCA),
-		HANDLER("xstats1", ParseOSPXStats1),
-		HANDLER("adscores", ParseQLScoresAD),
-		HANDLER("scores_ad", ParseQLScoresAD),
-		HANDLER("scores_ft", ParseQLScoresFT),
-		HANDLER("rrscores", ParseQLScoresRROld),
-		HANDLER("scores_rr", ParseQLScoresRR),
-		HANDLER("print", ParsePrint),
-		HANDLER("ws", ParseWolfWeapStats),
-		HANDLER("sc", ParseWolfSC)
+		HANDLER(ScoresTDM, ParseQLScoresTDM),
+		HANDLER(TDMStats, ParseQLStatsTDM),
+		HANDLER(ScoresDuel, ParseQLScoresDuel),
+		HANDLER(ScoresCTF, ParseQLScoresCTF),
+		HANDLER(CTFStats, ParseQLStatsCTF),
+		HANDLER(Scores, ParseScores),
+		HANDLER(DScores, ParseQLScoresDuelOld),
+		HANDLER(CPMAXStats2, ParseCPMAXStats2),
+		HANDLER(CPMAMStats, ParseCPMAMStats),
+		HANDLER(CPMAXStats2a, ParseCPMAXStats2a),
+		HANDLER(CPMAMStatsa, ParseCPMAMStatsa),
+		HANDLER(CPMADuelEndScores, ParseCPMADuelEndScores),
+		HANDLER(CPMAXScores, ParseCPMAXScores),
+		HANDLER(CPMADMScores, ParseCPMADMScores),
+		HANDLER(TDMScores, ParseQLScoresTDMVeryOld),
+		HANDLER(TDMScores2, ParseQLScoresTDMOld),
+		HANDLER(StatsInfo, ParseOSPStatsInfo),
+		HANDLER(ScoresCA, ParseQLScoresCA),
+		HANDLER(CTFScores, ParseQLScoresCTFOld),
+		HANDLER(CAScores, ParseQLScoresCAOld),
+		HANDLER(CAStats, ParseQLStatsCA),
+		HANDLER(XStats1, ParseOSPXStats1),
+		HANDLER(ADScores, ParseQLScoresAD),
+		HANDLER(ScoresAD, ParseQLScoresAD),
+		HANDLER(ScoresFT, ParseQLScoresFT),
+		HANDLER(RRScores, ParseQLScoresRROld),
+		HANDLER(ScoresRR, ParseQLScoresRR),
+		HANDLER(Print, ParsePrint),
+		HANDLER(WolfWeaponStats, ParseWolfWeapStats),
+		HANDLER(WolfScores, ParseWolfSC)
 	};
 #undef HANDLER
 	/*
@@ -320,7 +354,7 @@ void udtParserPlugInStats::ProcessCommandMessage(const udtCommandCallbackArg& ar
 
 	for(s32 i = 0; i < (s32)UDT_COUNT_OF(handlers); ++i)
 	{
-		if(udtString::EqualsNoCase(commandName, handlers[i].Name))
+		if(arg.CommandIdNoCase == handlers[i].Command)
 		{
 			(this->*(handlers[i].Function))();
 			break;
@@ -355,8 +389,9 @@ void udtParserPlugInStats::ClearMatchList()
 	_blueString = udtString::NewClone(_stringAllocator, "BLUE");
 }
 
-void udtParserPlugInStats::ProcessConfigString(s32 csIndex, const udtString& configString)
+void udtParserPlugInStats::ProcessConfigString(udtBaseParser& parser, s32 csIndex)
 {	
+	const udtString configString = parser.GetConfigString(csIndex);
 	if(udtString::IsNull(configString))
 	{
 		return;
@@ -365,14 +400,13 @@ void udtParserPlugInStats::ProcessConfigString(s32 csIndex, const udtString& con
 	const s32 firstPlayerCs = GetIdNumber(udtMagicNumberType::ConfigStringIndex, udtConfigStringIndex::FirstPlayer, _protocol);
 	if(csIndex >= firstPlayerCs && csIndex < firstPlayerCs + 64)
 	{
-		ProcessPlayerConfigString(configString.GetPtr(), csIndex - firstPlayerCs);
+		ProcessPlayerConfigString(parser, csIndex, csIndex - firstPlayerCs);
 	}
 	else if(_analyzer.Mod() == udtMod::CPMA && csIndex == CS_CPMA_GAME_INFO)
 	{
-		udtVMScopedStackAllocator allocatorScope(*TempAllocator);
 		s32 sr, sb;
-		ParseConfigStringValueInt(sr, *TempAllocator, "sr", configString.GetPtr());
-		ParseConfigStringValueInt(sb, *TempAllocator, "sb", configString.GetPtr());
+		parser.GetConfigStringValueInt(sr, csIndex, "sr");
+		parser.GetConfigStringValueInt(sb, csIndex, "sb");
 		if(sr != -9999 || sb != -9999)
 		{
 			// When both scores are -9999, CPMA did an arena reset.
@@ -381,12 +415,12 @@ void udtParserPlugInStats::ProcessConfigString(s32 csIndex, const udtString& con
 		}
 
 		udtString redTeamName, blueTeamName;
-		if(ParseConfigStringValueString(redTeamName, *TempAllocator, "nr", configString.GetPtr()) &&
+		if(parser.GetConfigStringValueString(redTeamName, csIndex, "nr") &&
 		   redTeamName.GetLength() != 0)
 		{
 			WriteStringToApiStruct(_stats.CustomRedName, udtString::NewCleanCloneFromRef(_stringAllocator, _protocol, redTeamName));
 		}
-		if(ParseConfigStringValueString(blueTeamName, *TempAllocator, "nb", configString.GetPtr()) &&
+		if(parser.GetConfigStringValueString(blueTeamName, csIndex, "nb") &&
 		   blueTeamName.GetLength() != 0)
 		{
 			WriteStringToApiStruct(_stats.CustomBlueName, udtString::NewCleanCloneFromRef(_stringAllocator, _protocol, blueTeamName));
@@ -396,8 +430,8 @@ void udtParserPlugInStats::ProcessConfigString(s32 csIndex, const udtString& con
 		if(_analyzer.GameType() >= udtGameType::FirstTeamMode && 
 		   _analyzer.IsMatchInProgress() &&
 		   _cpmaRoundScoreRed != _cpmaRoundScoreBlue &&
-		   ParseConfigStringValueInt(cr, *TempAllocator, "cr", configString.GetPtr()) &&
-		   ParseConfigStringValueInt(cb, *TempAllocator, "cb", configString.GetPtr()) &&
+		   parser.GetConfigStringValueInt(cr, csIndex, "cr") &&
+		   parser.GetConfigStringValueInt(cb, csIndex, "cb") &&
 		   ((_cpmaRoundScoreRed > _cpmaRoundScoreBlue && cr == 0) || (_cpmaRoundScoreBlue > _cpmaRoundScoreRed && cb == 0)))
 		{
 			// All the players of the leading team left.
@@ -407,8 +441,8 @@ void udtParserPlugInStats::ProcessConfigString(s32 csIndex, const udtString& con
 	else if(_analyzer.Mod() == udtMod::CPMA && csIndex == CS_CPMA_ROUND_INFO)
 	{
 		s32 sr, sb;
-		ParseConfigStringValueInt(sr, *TempAllocator, "sr", configString.GetPtr());
-		ParseConfigStringValueInt(sb, *TempAllocator, "sb", configString.GetPtr());
+		parser.GetConfigStringValueInt(sr, csIndex, "sr");
+		parser.GetConfigStringValueInt(sb, csIndex, "sb");
 		if(sr != -9999 && sb != -9999)
 		{
 			_cpmaRoundScoreRed = sr;
@@ -460,9 +494,10 @@ void udtParserPlugInStats::ProcessConfigString(s32 csIndex, const udtString& con
 	}
 }
 
-void udtParserPlugInStats::ProcessPlayerConfigString(const char* configString, s32 playerIndex)
+void udtParserPlugInStats::ProcessPlayerConfigString(udtBaseParser& parser, s32 csIndex, s32 playerIndex)
 {
-	if(configString == NULL)
+	const udtPlayerRosterEntry& player = parser.GetPlayer(playerIndex);
+	if(!player.Present)
 	{
 		return;
 	}
@@ -476,34 +511,29 @@ void udtParserPlugInStats::ProcessPlayerConfigString(const char* configString, s
 		return;
 	}
 #endif
-	udtVMScopedStackAllocator allocatorScope(*TempAllocator);
-
-	udtString cpmaModel, cpmaName;
+	udtString cpmaModel;
 	if(_analyzer.Mod() == udtMod::CPMA &&
-	   ParseConfigStringValueString(cpmaModel, *TempAllocator, "model", configString) &&
+	   parser.GetConfigStringValueString(cpmaModel, csIndex, "model") &&
 	   udtString::IsNullOrEmpty(cpmaModel) &&
-	   ParseConfigStringValueString(cpmaName, *TempAllocator, "n", configString) &&
-	   udtString::Equals(cpmaName, "UnnamedPlayer"))
+	   player.HasName &&
+	   udtString::Equals(player.NameAndClan, "UnnamedPlayer"))
 	{
 		// In a duel demo I have, a new player appears in team free when there's already 2 players there,
 		// which is impossible. Not sure if this is CPMA specific.
 		return;
 	}
 
-	s32 idTeamIndex = -1;
-	if(ParseConfigStringValueInt(idTeamIndex, *TempAllocator, "t", configString))
+	if(player.HasTeam)
 	{
-		u32 udtTeamIndex = (s32)idTeamIndex;
-		GetUDTNumber(udtTeamIndex, udtMagicNumberType::Team, idTeamIndex, _protocol);
+		u32 udtTeamIndex = (s32)player.IdTeam;
+		GetUDTNumber(udtTeamIndex, udtMagicNumberType::Team, player.IdTeam, _protocol);
 		_playerTeamIndices[playerIndex] = udtTeamIndex;
 	}
 
-	udtString clan, name;
-	bool hasClan;
-	if(GetClanAndPlayerName(clan, name, hasClan, *TempAllocator, _protocol, configString))
+	if(player.HasName)
 	{
-		WriteStringToApiStruct(_playerStats[playerIndex].Name, udtString::NewCloneFromRef(_stringAllocator, name));
-		WriteStringToApiStruct(_playerStats[playerIndex].CleanName, udtString::NewCleanCloneFromRef(_stringAllocator, _protocol, name));
+		WriteStringToApiStruct(_playerStats[playerIndex].Name, udtString::NewCloneFromRef(_stringAllocator, player.Name));
+		WriteStringToApiStruct(_playerStats[playerIndex].CleanName, udtString::NewCloneFromRef(_stringAllocator, player.CleanName));
 	}
 }
 
@@ -3421,6 +3451,11 @@ void udtParserPlugInStats::AddCurrentStats()
 
 	_lastMatchEndTime = _analyzer.MatchEndTime();
 
+	if(_firstMatchOnly)
+	{
+		Done = true;
+	}
+
 	// Clear the stats for the next match.
 	ClearStats();
 }
@@ -46,8 +46,8 @@ private:
 	s64  CreateBitMask(const udtStatsField* fields, s32 fieldCount);
 	void AddCurrentStats();
 	void ClearStats(bool newGameState = false);
-	void ProcessConfigString(s32 csIndex, const udtString& configString);
-	void ProcessPlayerConfigString(const char* configString, s32 playerIndex);
+	void ProcessConfigString(udtBaseParser& parser, s32 csIndex);
+	void ProcessPlayerConfigString(udtBaseParser& parser, s32 csIndex, s32 playerIndex);
 	bool GetClientNumberFromScoreIndex(s32& clientNumber, s32 fieldIndex);
 	bool AreStatsValid();
 	void ParseScores();
@@ -204,6 +204,7 @@ private:
 	const idTokenizer* _tokenizer;
 	idTokenizer* _plugInTokenizer;
 	udtProtocol::Id _protocol;
+	bool _firstMatchOnly;
 	s32 _followedClientNumber;
 	s32 _firstPlaceClientNumber;
 	s32 _secondPlaceClientNumber;
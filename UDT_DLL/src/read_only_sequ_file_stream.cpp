@@ -346,5 +346,326 @@ void udtReadOnlySequentialFileStream::Destroy()
 }
 
 
-#endif
+#else
+
+
+#include "assert_or_fatal.hpp"
+#include "utils.hpp"
+
+#include <aio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/stat.h>
+
+
+#define BLOCK_SIZE  (128*1024)
+#define BLOCK_COUNT (4)
+
+
+struct BlockInfo
+{
+	struct aiocb ControlBlock;
+	u32 BlockIndex;
+	u32 ByteCount; // Number of valid bytes once Ready is true.
+	bool RequestPending;
+	bool Ready;
+};
+
+struct udtReadOnlySequentialFileStreamImpl
+{
+	BlockInfo _blocks[BLOCK_COUNT];
+	u8* _buffer; // If invalid: NULL.
+	int _file;   // If invalid: -1.
+	u32 _blockSize;
+	u32 _fileByteCount;
+	u32 _fileOffset;
+};
+
+static void FinishRequest(BlockInfo& block)
+{
+	const struct aiocb* const requests[1] = { &block.ControlBlock };
+	while(aio_error(&block.ControlBlock) == EINPROGRESS)
+	{
+		aio_suspend(requests, 1, NULL);
+	}
+
+	const ssize_t result = aio_return(&block.ControlBlock);
+	block.RequestPending = false;
+	block.Ready = result >= 0;
+	block.ByteCount = result >= 0 ? (u32)result : 0;
+}
+
+udtReadOnlySequentialFileStream::udtReadOnlySequentialFileStream()
+{
+	_data = (udtReadOnlySequentialFileStreamImpl*)udt_malloc(sizeof(udtReadOnlySequentialFileStreamImpl));
+	_data->_buffer = NULL;
+	_data->_file = -1;
+	_data->_blockSize = 0;
+	_data->_fileByteCount = 0;
+	_data->_fileOffset = 0;
+	for(u32 i = 0; i < BLOCK_COUNT; ++i)
+	{
+		_data->_blocks[i].BlockIndex = i;
+		_data->_blocks[i].ByteCount = 0;
+		_data->_blocks[i].RequestPending = false;
+		_data->_blocks[i].Ready = false;
+	}
+}
+
+udtReadOnlySequentialFileStream::~udtReadOnlySequentialFileStream()
+{
+	Destroy();
+}
+
+bool udtReadOnlySequentialFileStream::Init()
+{
+	// The same context can be initialized more than once.
+	if(_data->_buffer != NULL)
+	{
+		return true;
+	}
+
+	void* buffer = NULL;
+	if(posix_memalign(&buffer, (size_t)UDT_MEMORY_PAGE_SIZE, (size_t)(BLOCK_SIZE * BLOCK_COUNT)) != 0)
+	{
+		return false;
+	}
+
+	_data->_buffer = (u8*)buffer;
+	_data->_blockSize = BLOCK_SIZE;
+
+	return true;
+}
+
+bool udtReadOnlySequentialFileStream::Open(const char* filePath, u32 offset)
+{
+	Close();
+	_data->_fileOffset = 0;
+	for(u32 i = 0; i < BLOCK_COUNT; ++i)
+	{
+		_data->_blocks[i].BlockIndex = i;
+		_data->_blocks[i].ByteCount = 0;
+		_data->_blocks[i].RequestPending = false;
+		_data->_blocks[i].Ready = false;
+	}
+
+	if(_data->_buffer == NULL)
+	{
+		return false;
+	}
+
+	const int file = open(filePath, O_RDONLY);
+	if(file == -1)
+	{
+		return false;
+	}
+
+	struct stat fileInfo;
+	if(fstat(file, &fileInfo) != 0)
+	{
+		close(file);
+		return false;
+	}
+
+	// Let the kernel know we'll read front to back so it can be more aggressive with its own read-ahead.
+	posix_fadvise(file, (off_t)offset, 0, POSIX_FADV_SEQUENTIAL);
+
+	const u32 blockSize = _data->_blockSize;
+	_data->_file = file;
+	_data->_fileByteCount = (u32)fileInfo.st_size;
+	_data->_fileOffset = offset;
+
+	const u32 blockCount = (_data->_fileByteCount + blockSize - 1) / blockSize;
+	const u32 firstBlockIndex = offset / blockSize;
+	for(u32 i = 0; i < (u32)BLOCK_COUNT - 1 && firstBlockIndex + i < blockCount; ++i)
+	{
+		RequestBlock(firstBlockIndex + i);
+	}
+
+	return true;
+}
+
+void udtReadOnlySequentialFileStream::RequestBlock(u32 blockIndex)
+{
+	const u32 blockSize = _data->_blockSize;
+	const u32 blockId = blockIndex % BLOCK_COUNT;
+	BlockInfo& block = _data->_blocks[blockId];
+	if(block.BlockIndex == blockIndex && (block.RequestPending || block.Ready))
+	{
+		return;
+	}
+
+	if(block.RequestPending)
+	{
+		// The slot is still busy with another block.
+		FinishRequest(block);
+	}
+
+	struct aiocb& request = block.ControlBlock;
+	memset(&request, 0, sizeof(request));
+	request.aio_fildes = _data->_file;
+	request.aio_offset = (off_t)blockIndex * (off_t)blockSize;
+	request.aio_buf = _data->_buffer + blockId * blockSize;
+	request.aio_nbytes = (size_t)blockSize;
+	request.aio_sigevent.sigev_notify = SIGEV_NONE;
+	block.BlockIndex = blockIndex;
+	block.ByteCount = 0;
+	block.Ready = false;
+	block.RequestPending = aio_read(&request) == 0;
+}
+
+void udtReadOnlySequentialFileStream::WaitForBlock(u32 blockIndex)
+{
+	const u32 blockSize = _data->_blockSize;
+	const u32 blockId = blockIndex % BLOCK_COUNT;
+	BlockInfo& block = _data->_blocks[blockId];
+	if(block.RequestPending)
+	{
+		FinishRequest(block);
+	}
+
+	if(block.BlockIndex == blockIndex && block.Ready)
+	{
+		return;
+	}
+
+	// The request was never queued or failed: fall back to a blocking read.
+	const ssize_t result = pread(_data->_file, _data->_buffer + blockId * blockSize, (size_t)blockSize, (off_t)blockIndex * (off_t)blockSize);
+	block.BlockIndex = blockIndex;
+	block.RequestPending = false;
+	block.Ready = true;
+	block.ByteCount = result >= 0 ? (u32)result : 0;
+}
+
+u32 udtReadOnlySequentialFileStream::Read(void* dstBuff, u32 elementSize, u32 count)
+{
+	u32 byteCount = elementSize * count;
+	const u32 blockSize = _data->_blockSize;
+	UDT_ASSERT_OR_FATAL(byteCount <= blockSize);
 
+	const u32 fileSize = _data->_fileByteCount;
+	const u32 fileOffset = _data->_fileOffset;
+	if(byteCount == 0 || fileOffset >= fileSize)
+	{
+		return 0;
+	}
+
+	if(fileOffset + byteCount > fileSize)
+	{
+		byteCount = fileSize - fileOffset;
+	}
+
+	const u32 blockIndex = fileOffset / blockSize;
+	WaitForBlock(blockIndex);
+
+	// Keep all the other slots busy reading ahead.
+	const u32 blockCount = (fileSize + blockSize - 1) / blockSize;
+	for(u32 i = 1; i < (u32)BLOCK_COUNT && blockIndex + i < blockCount; ++i)
+	{
+		RequestBlock(blockIndex + i);
+	}
+
+	const u32 blockOffset = fileOffset % blockSize;
+	const bool spansTwoBlocks = blockOffset + byteCount > blockSize;
+	if(spansTwoBlocks)
+	{
+		WaitForBlock(blockIndex + 1);
+	}
+
+	// Don't trust the size we got when opening since the file could have been truncated since.
+	const u32 blockByteCount = _data->_blocks[blockIndex % BLOCK_COUNT].ByteCount;
+	u32 bytesAvailable = blockByteCount > blockOffset ? (blockByteCount - blockOffset) : 0;
+	if(spansTwoBlocks && blockByteCount == blockSize)
+	{
+		bytesAvailable += _data->_blocks[(blockIndex + 1) % BLOCK_COUNT].ByteCount;
+	}
+	if(byteCount > bytesAvailable)
+	{
+		byteCount = bytesAvailable;
+		_data->_fileByteCount = fileOffset + bytesAvailable;
+	}
+
+	const u32 blockId = blockIndex % BLOCK_COUNT;
+	const u8* const buffer = _data->_buffer;
+	const u8* const readData = buffer + (blockId * blockSize) + blockOffset;
+	const u8* const bufferEnd = buffer + (u32)BLOCK_COUNT * blockSize;
+	if(readData + byteCount > bufferEnd)
+	{
+		u8* const writeData = (u8*)dstBuff;
+		const u32 byteCount1 = (u32)(bufferEnd - readData);
+		const u32 byteCount2 = byteCount - byteCount1;
+		memcpy(writeData, readData, (size_t)byteCount1);
+		memcpy(writeData + byteCount1, buffer, (size_t)byteCount2);
+	}
+	else
+	{
+		memcpy(dstBuff, readData, (size_t)byteCount);
+	}
+	_data->_fileOffset += byteCount;
+
+	return byteCount / elementSize;
+}
+
+u32 udtReadOnlySequentialFileStream::Write(const void* /*srcBuff*/, u32 /*elementSize*/, u32 /*count*/)
+{
+	UDT_ASSERT_OR_FATAL_ALWAYS("Calling Write on a udtReadOnlySequentialFileStream is invalid!");
+	return 0;
+}
+
+s32	udtReadOnlySequentialFileStream::Seek(s32 /*offset*/, udtSeekOrigin::Id /*origin*/)
+{
+	UDT_ASSERT_OR_FATAL_ALWAYS("Calling Seek on a udtReadOnlySequentialFileStream is invalid!");
+	return 0;
+}
+
+s32 udtReadOnlySequentialFileStream::Offset()
+{
+	return (s32)_data->_fileOffset;
+}
+
+u64 udtReadOnlySequentialFileStream::Length()
+{
+	return (u64)_data->_fileByteCount;
+}
+
+s32 udtReadOnlySequentialFileStream::Close()
+{
+	if(_data->_file == -1)
+	{
+		return 0;
+	}
+
+	// The buffer gets reused for the next file, so no request can be left in flight.
+	aio_cancel(_data->_file, NULL);
+	for(u32 i = 0; i < BLOCK_COUNT; ++i)
+	{
+		BlockInfo& block = _data->_blocks[i];
+		if(block.RequestPending)
+		{
+			FinishRequest(block);
+		}
+		block.Ready = false;
+	}
+
+	close(_data->_file);
+	_data->_file = -1;
+
+	return 0;
+}
+
+void udtReadOnlySequentialFileStream::Destroy()
+{
+	Close();
+
+	if(_data->_buffer != NULL)
+	{
+		free(_data->_buffer);
+	}
+
+	free(_data);
+}
+
+
+#endif
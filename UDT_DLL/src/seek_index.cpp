@@ -0,0 +1,265 @@
+#include "seek_index.hpp"
+#include "file_stream.hpp"
+#include "utils.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define UDT_SEEK_INDEX_MAGIC 0x49544455 // "UDTI"
+#define UDT_SEEK_INDEX_VERSION 2
+
+
+struct udtSeekIndexHeader
+{
+	u32 Magic;
+	u32 Version;
+	u32 Protocol;
+	u32 DemoByteCount;
+	u32 GameStateCount;
+	u32 CheckpointCount;
+	u32 StateDataByteCount;
+};
+
+
+static bool GetSeekIndexFilePath(char* indexFilePath, const char* demoFilePath)
+{
+	if(strlen(demoFilePath) + sizeof(UDT_SEEK_INDEX_FILE_EXTENSION) > (size_t)UDT_MAX_PATH_LENGTH)
+	{
+		return false;
+	}
+
+	sprintf(indexFilePath, "%s" UDT_SEEK_INDEX_FILE_EXTENSION, demoFilePath);
+
+	return true;
+}
+
+
+udtSeekIndex::udtSeekIndex()
+{
+}
+
+void udtSeekIndex::Clear()
+{
+	GameStates.Clear();
+	Checkpoints.Clear();
+	StateData.Clear();
+}
+
+bool udtSeekIndex::Load(const char* demoFilePath, u32 demoByteCount, udtProtocol::Id protocol)
+{
+	Clear();
+
+	char indexFilePath[UDT_MAX_PATH_LENGTH];
+	if(!GetSeekIndexFilePath(indexFilePath, demoFilePath) ||
+	   !udtFileStream::Exists(indexFilePath))
+	{
+		return false;
+	}
+
+	udtFileStream file;
+	if(!file.Open(indexFilePath, udtFileOpenMode::Read))
+	{
+		return false;
+	}
+
+	udtSeekIndexHeader header;
+	if(file.Read(&header, (u32)sizeof(header), 1) != 1 ||
+	   header.Magic != UDT_SEEK_INDEX_MAGIC ||
+	   header.Version != UDT_SEEK_INDEX_VERSION ||
+	   header.Protocol != (u32)protocol ||
+	   header.DemoByteCount != demoByteCount)
+	{
+		return false;
+	}
+
+	// The padding lets udtMessage read past the end of the last checkpoint's data.
+	GameStates.Resize(header.GameStateCount);
+	Checkpoints.Resize(header.CheckpointCount);
+	StateData.Resize(header.StateDataByteCount + UDT_MESSAGE_READ_PADDING);
+	memset(StateData.GetStartAddress() + header.StateDataByteCount, 0, (size_t)UDT_MESSAGE_READ_PADDING);
+	if((header.GameStateCount > 0 && file.Read(GameStates.GetStartAddress(), (u32)sizeof(udtSeekIndexGameState), header.GameStateCount) != header.GameStateCount) ||
+	   (header.CheckpointCount > 0 && file.Read(Checkpoints.GetStartAddress(), (u32)sizeof(udtSeekIndexCheckpoint), header.CheckpointCount) != header.CheckpointCount) ||
+	   (header.StateDataByteCount > 0 && file.Read(StateData.GetStartAddress(), header.StateDataByteCount, 1) != 1))
+	{
+		Clear();
+		return false;
+	}
+
+	for(u32 i = 0; i < header.CheckpointCount; ++i)
+	{
+		const udtSeekIndexCheckpoint& checkpoint = Checkpoints[i];
+		if(checkpoint.DataOffset + checkpoint.DataByteCount > header.StateDataByteCount ||
+		   checkpoint.DataOffset + checkpoint.DataByteCount < checkpoint.DataOffset ||
+		   checkpoint.FileOffset >= demoByteCount)
+		{
+			Clear();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool udtSeekIndex::Save(const char* demoFilePath, u32 demoByteCount, udtProtocol::Id protocol)
+{
+	char indexFilePath[UDT_MAX_PATH_LENGTH];
+	if(!GetSeekIndexFilePath(indexFilePath, demoFilePath))
+	{
+		return false;
+	}
+
+	udtFileStream file;
+	if(!file.Open(indexFilePath, udtFileOpenMode::Write))
+	{
+		return false;
+	}
+
+	udtSeekIndexHeader header;
+	header.Magic = UDT_SEEK_INDEX_MAGIC;
+	header.Version = UDT_SEEK_INDEX_VERSION;
+	header.Protocol = (u32)protocol;
+	header.DemoByteCount = demoByteCount;
+	header.GameStateCount = GameStates.GetSize();
+	header.CheckpointCount = Checkpoints.GetSize();
+	header.StateDataByteCount = StateData.GetSize();
+
+	return
+		file.Write(&header, (u32)sizeof(header), 1) == 1 &&
+		(header.GameStateCount == 0 || file.Write(GameStates.GetStartAddress(), (u32)sizeof(udtSeekIndexGameState), header.GameStateCount) == header.GameStateCount) &&
+		(header.CheckpointCount == 0 || file.Write(Checkpoints.GetStartAddress(), (u32)sizeof(udtSeekIndexCheckpoint), header.CheckpointCount) == header.CheckpointCount) &&
+		(header.StateDataByteCount == 0 || file.Write(StateData.GetStartAddress(), header.StateDataByteCount, 1) == 1);
+}
+
+s32 udtSeekIndex::FindCheckpoint(s32 gameStateIndex, s32 serverTimeMs) const
+{
+	s32 result = -1;
+	for(u32 i = 0, count = Checkpoints.GetSize(); i < count; ++i)
+	{
+		const udtSeekIndexCheckpoint& checkpoint = Checkpoints[i];
+		if(checkpoint.GameStateIndex == gameStateIndex &&
+		   checkpoint.ServerTimeMs < serverTimeMs)
+		{
+			result = (s32)i;
+		}
+	}
+
+	return result;
+}
+
+
+udtSeekIndexWriter::udtSeekIndexWriter()
+{
+	SubscribedCallbacks = 
+		(u32)udtParserPlugInCallback::MessageBundleStart | 
+		(u32)udtParserPlugInCallback::MessageBundleEnd | 
+		(u32)udtParserPlugInCallback::GameState | 
+		(u32)udtParserPlugInCallback::Snapshot;
+	_nextCheckpointTimeMs = UDT_S32_MAX;
+	_checkpointPending = false;
+}
+
+udtSeekIndexWriter::~udtSeekIndexWriter()
+{
+}
+
+void udtSeekIndexWriter::InitAllocators(u32)
+{
+}
+
+void udtSeekIndexWriter::StartDemoAnalysis()
+{
+	Index.Clear();
+	_nextCheckpointTimeMs = UDT_S32_MAX;
+	_checkpointPending = false;
+}
+
+void udtSeekIndexWriter::FinishDemoAnalysis()
+{
+	if(_checkpointPending)
+	{
+		// There is no message left to resume parsing from.
+		_checkpointPending = false;
+		Index.StateData.Resize(Index.Checkpoints[Index.Checkpoints.GetSize() - 1].DataOffset);
+		Index.Checkpoints.Resize(Index.Checkpoints.GetSize() - 1);
+	}
+}
+
+void udtSeekIndexWriter::ProcessMessageBundleStart(const udtMessageBundleCallbackArg&, udtBaseParser& parser)
+{
+	if(!_checkpointPending)
+	{
+		return;
+	}
+
+	_checkpointPending = false;
+	udtSeekIndexCheckpoint& checkpoint = Index.Checkpoints[Index.Checkpoints.GetSize() - 1];
+	if(checkpoint.FileOffset != parser._inFileOffset)
+	{
+		Index.StateData.Resize(checkpoint.DataOffset);
+		Index.Checkpoints.Resize(Index.Checkpoints.GetSize() - 1);
+		return;
+	}
+
+	checkpoint.MessageSequence = parser._inServerMessageSequence;
+}
+
+void udtSeekIndexWriter::ProcessMessageBundleEnd(const udtMessageBundleCallbackArg&, udtBaseParser& parser)
+{
+	if(parser._inServerTime == UDT_S32_MIN ||
+	   parser._inServerTime < _nextCheckpointTimeMs)
+	{
+		return;
+	}
+
+	_nextCheckpointTimeMs = parser._inServerTime + UDT_SEEK_INDEX_CHECKPOINT_INTERVAL_MS;
+
+	if(_messageData.IsEmpty())
+	{
+		_messageData.Resize(UDT_PARSER_MAX_CHECKPOINT_BYTE_COUNT);
+	}
+
+	_message.InitContext(parser._context);
+	_message.InitProtocol(parser._inProtocol);
+	_message.Init(_messageData.GetStartAddress(), (s32)_messageData.GetSize());
+	if(!parser.SaveCheckpoint(_message))
+	{
+		return;
+	}
+
+	const u32 dataByteCount = (u32)((_message.Buffer.bit + 7) >> 3);
+	udtSeekIndexCheckpoint checkpoint;
+	checkpoint.FileOffset = parser._inFileOffset + 8 + (u32)parser._inMsg.Buffer.cursize;
+	checkpoint.MessageSequence = 0;
+	checkpoint.DataOffset = Index.StateData.GetSize();
+	checkpoint.DataByteCount = dataByteCount;
+	checkpoint.GameStateIndex = parser._inGameStateIndex;
+	checkpoint.ServerTimeMs = parser._inServerTime;
+	memcpy(Index.StateData.Extend(dataByteCount), _messageData.GetStartAddress(), (size_t)dataByteCount);
+	Index.Checkpoints.Add(checkpoint);
+	_checkpointPending = true;
+}
+
+void udtSeekIndexWriter::ProcessGamestateMessage(const udtGamestateCallbackArg&, udtBaseParser& parser)
+{
+	udtSeekIndexGameState gameState;
+	gameState.FileOffset = parser._inFileOffset;
+	gameState.FirstSnapshotTimeMs = UDT_S32_MIN;
+	Index.GameStates.Add(gameState);
+	_nextCheckpointTimeMs = UDT_S32_MAX;
+}
+
+void udtSeekIndexWriter::ProcessSnapshotMessage(const udtSnapshotCallbackArg& arg, udtBaseParser&)
+{
+	if(Index.GameStates.IsEmpty())
+	{
+		return;
+	}
+
+	udtSeekIndexGameState& gameState = Index.GameStates[Index.GameStates.GetSize() - 1];
+	if(gameState.FirstSnapshotTimeMs == UDT_S32_MIN)
+	{
+		gameState.FirstSnapshotTimeMs = arg.ServerTime;
+		_nextCheckpointTimeMs = arg.ServerTime + UDT_SEEK_INDEX_CHECKPOINT_INTERVAL_MS;
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+
+#include "parser.hpp"
+#include "parser_plug_in.hpp"
+#include "array.hpp"
+
+
+// The seek index of "demo.dm_68" is stored in "demo.dm_68.udtidx".
+#define UDT_SEEK_INDEX_FILE_EXTENSION ".udtidx"
+
+// Server time, in milli-seconds, between 2 consecutive checkpoints of a game state.
+#define UDT_SEEK_INDEX_CHECKPOINT_INTERVAL_MS 30000
+
+
+struct udtSeekIndexGameState
+{
+	u32 FileOffset; // Of the "gamestate" message.
+	s32 FirstSnapshotTimeMs; // UDT_S32_MIN if there isn't any snapshot.
+};
+
+struct udtSeekIndexCheckpoint
+{
+	u32 FileOffset; // Of the first message to parse after restoring the parser's state.
+	s32 MessageSequence; // Of the message at FileOffset, to validate the index against the demo.
+	u32 DataOffset; // Of the serialized parser state in udtSeekIndex::StateData.
+	u32 DataByteCount;
+	s32 GameStateIndex;
+	s32 ServerTimeMs; // Of the last snapshot read before FileOffset.
+};
+
+// The seek index of a demo: where the game states start
+// and periodic checkpoints to resume decoding from without parsing from the game state.
+struct udtSeekIndex
+{
+public:
+	udtSeekIndex();
+
+	void Clear();
+	bool Load(const char* demoFilePath, u32 demoByteCount, udtProtocol::Id protocol);
+	bool Save(const char* demoFilePath, u32 demoByteCount, udtProtocol::Id protocol);
+	s32  FindCheckpoint(s32 gameStateIndex, s32 serverTimeMs) const; // Returns the index of the last checkpoint before the given time or -1.
+
+	udtVMArray<udtSeekIndexGameState> GameStates { "SeekIndex::GameStatesArray" };
+	udtVMArray<udtSeekIndexCheckpoint> Checkpoints { "SeekIndex::CheckpointsArray" };
+	udtVMArray<u8> StateData { "SeekIndex::StateDataArray" }; // Followed by UDT_MESSAGE_READ_PADDING zeroed bytes when loaded.
+
+private:
+	UDT_NO_COPY_SEMANTICS(udtSeekIndex);
+};
+
+// Builds the seek index of a demo during a regular parse that starts at the beginning of the file.
+struct udtSeekIndexWriter : udtBaseParserPlugIn
+{
+public:
+	udtSeekIndexWriter();
+	~udtSeekIndexWriter();
+
+	void InitAllocators(u32 demoCount) override;
+	void StartDemoAnalysis() override;
+	void FinishDemoAnalysis() override;
+	void ProcessMessageBundleStart(const udtMessageBundleCallbackArg& arg, udtBaseParser& parser) override;
+	void ProcessMessageBundleEnd(const udtMessageBundleCallbackArg& arg, udtBaseParser& parser) override;
+	void ProcessGamestateMessage(const udtGamestateCallbackArg& arg, udtBaseParser& parser) override;
+	void ProcessSnapshotMessage(const udtSnapshotCallbackArg& arg, udtBaseParser& parser) override;
+
+	udtSeekIndex Index;
+
+private:
+	UDT_NO_COPY_SEMANTICS(udtSeekIndexWriter);
+
+	udtMessage _message;
+	udtVMArray<u8> _messageData { "SeekIndexWriter::MessageDataArray" };
+	s32 _nextCheckpointTimeMs;
+	bool _checkpointPending; // The sequence number of the next message is still missing.
+};
@@ -0,0 +1,91 @@
+#include "server_commands.hpp"
+#include "assert_or_fatal.hpp"
+
+#include <string.h>
+
+
+// A power of 2. There is no collision handling: the seed is picked for all names to get their own slot.
+#define SERVER_COMMAND_TABLE_SIZE 256
+#define SERVER_COMMAND_MAX_SEED   (1 << 16)
+
+
+#define UDT_SERVER_COMMAND_ITEM(Enum, Name) Name,
+static const char* ServerCommandNames[udtServerCommand::Count] =
+{
+	UDT_SERVER_COMMAND_LIST(UDT_SERVER_COMMAND_ITEM)
+	""
+};
+#undef UDT_SERVER_COMMAND_ITEM
+
+static u8 ServerCommandTable[SERVER_COMMAND_TABLE_SIZE];
+static u32 ServerCommandHashSeed = 0;
+
+
+static u32 GetServerCommandSlot(const char* name, u32 length, u32 seed)
+{
+	// FNV-1a with a custom offset basis.
+	// ASCII case is folded so that the look-up can be done without regard to case.
+	u32 hash = seed;
+	for(u32 i = 0; i < length; ++i)
+	{
+		u32 c = (u32)(u8)name[i];
+		if(c >= (u32)'A' && c <= (u32)'Z')
+		{
+			c += (u32)('a' - 'A');
+		}
+		hash = (hash ^ c) * 16777619u;
+	}
+
+	return hash & (SERVER_COMMAND_TABLE_SIZE - 1);
+}
+
+static bool TryBuildServerCommandLookUpTable(u32 seed)
+{
+	for(u32 i = 0; i < (u32)SERVER_COMMAND_TABLE_SIZE; ++i)
+	{
+		ServerCommandTable[i] = (u8)udtServerCommand::Unknown;
+	}
+
+	for(u32 i = 0; i < (u32)udtServerCommand::Unknown; ++i)
+	{
+		const char* const name = ServerCommandNames[i];
+		const u32 slot = GetServerCommandSlot(name, (u32)strlen(name), seed);
+		if(ServerCommandTable[slot] != (u8)udtServerCommand::Unknown)
+		{
+			return false;
+		}
+
+		ServerCommandTable[slot] = (u8)i;
+	}
+
+	return true;
+}
+
+void BuildServerCommandLookUpTable()
+{
+	for(u32 seed = 1; seed < (u32)SERVER_COMMAND_MAX_SEED; ++seed)
+	{
+		if(TryBuildServerCommandLookUpTable(seed))
+		{
+			ServerCommandHashSeed = seed;
+			return;
+		}
+	}
+
+	UDT_ASSERT_OR_FATAL_ALWAYS("No perfect hash found for the server command names, increase SERVER_COMMAND_TABLE_SIZE");
+}
+
+udtServerCommand::Id GetServerCommandId(bool& matchesCase, const udtString& commandName)
+{
+	matchesCase = false;
+	const u32 slot = GetServerCommandSlot(commandName.GetPtr(), commandName.GetLength(), ServerCommandHashSeed);
+	const udtServerCommand::Id id = (udtServerCommand::Id)ServerCommandTable[slot];
+	if(id != udtServerCommand::Unknown && 
+	   udtString::EqualsNoCase(commandName, ServerCommandNames[id]))
+	{
+		matchesCase = udtString::Equals(commandName, ServerCommandNames[id]);
+		return id;
+	}
+
+	return udtServerCommand::Unknown;
+}
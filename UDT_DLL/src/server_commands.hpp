@@ -0,0 +1,71 @@
+#pragma once
+
+
+#include "string.hpp"
+
+
+// The server commands that the parser and plug-ins handle by name.
+#define UDT_SERVER_COMMAND_LIST(N) \
+	N(ConfigString, "cs") \
+	N(BigConfigStringStart, "bcs0") \
+	N(BigConfigStringAppend, "bcs1") \
+	N(BigConfigStringEnd, "bcs2") \
+	N(Print, "print") \
+	N(CenterPrint, "cp") \
+	N(PlayerCenterPrint, "pcp") \
+	N(MapRestart, "map_restart") \
+	N(Chat, "chat") \
+	N(TeamChat, "tchat") \
+	N(LocalChat, "lchat") \
+	N(CPMATeamChat, "mm2") \
+	N(Scores, "scores") \
+	N(StatsInfo, "statsinfo") \
+	N(XStats1, "xstats1") \
+	N(ScoresDuel, "scores_duel") \
+	N(ScoresTDM, "scores_tdm") \
+	N(ScoresCTF, "scores_ctf") \
+	N(ScoresCA, "scores_ca") \
+	N(ScoresAD, "scores_ad") \
+	N(ScoresFT, "scores_ft") \
+	N(ScoresRR, "scores_rr") \
+	N(TDMStats, "tdmstats") \
+	N(CTFStats, "ctfstats") \
+	N(CAStats, "castats") \
+	N(DScores, "dscores") \
+	N(TDMScores, "tdmscores") \
+	N(TDMScores2, "tdmscores2") \
+	N(CTFScores, "ctfscores") \
+	N(CAScores, "cascores") \
+	N(ADScores, "adscores") \
+	N(RRScores, "rrscores") \
+	N(CPMAXStats2, "xstats2") \
+	N(CPMAXStats2a, "xstats2a") \
+	N(CPMAMStats, "mstats") \
+	N(CPMAMStatsa, "mstatsa") \
+	N(CPMAXScores, "xscores") \
+	N(CPMADMScores, "dmscores") \
+	N(CPMADuelEndScores, "duelendscores") \
+	N(WolfWeaponStats, "ws") \
+	N(WolfScores, "sc")
+
+#define UDT_SERVER_COMMAND_ITEM(Enum, Name) Enum,
+struct udtServerCommand
+{
+	enum Id
+	{
+		UDT_SERVER_COMMAND_LIST(UDT_SERVER_COMMAND_ITEM)
+		Unknown, // Any command not in the list, including the empty one.
+		Count
+	};
+};
+#undef UDT_SERVER_COMMAND_ITEM
+
+static_assert(udtServerCommand::Count <= 64, "udtServerCommand::Id values must fit in a 64-bit mask");
+
+#define UDT_SERVER_COMMAND_BIT(Id) ((u64)1 << (u64)(udtServerCommand::Id))
+#define UDT_ALL_SERVER_COMMANDS    (~(u64)0)
+
+
+extern void BuildServerCommandLookUpTable(); // Called once by udtInitLibrary.
+// Case-insensitive. matchesCase tells whether the name's case matched too, like the game's own checks require.
+extern udtServerCommand::Id GetServerCommandId(bool& matchesCase, const udtString& commandName);
@@ -0,0 +1,484 @@
+#include "single_pass_cutter.hpp"
+#include "file_stream.hpp"
+#include "utils.hpp"
+
+#include <string.h>
+
+
+// The parsed messages are only moved to the start of the history once they take at least that much space
+// and more than the messages left, so that each byte is moved once on average.
+#define UDT_SINGLE_PASS_CUT_MIN_COMPACTION_BYTE_COUNT (64 * 1024)
+
+
+udtSinglePassCutter::udtSinglePassCutter()
+{
+	_plugIn = NULL;
+	_nameCreator = NULL;
+	_nameCreatorUserData = NULL;
+	_firstMessage = 0;
+	_sectionCount = 0;
+	_historyDurationMs = 0;
+	_idleGameStateIndex = -1;
+	_idleMaxServerTimeMs = UDT_S32_MIN;
+	_writerStopped = false;
+	_fallBack = false;
+}
+
+udtSinglePassCutter::~udtSinglePassCutter()
+{
+}
+
+bool udtSinglePassCutter::Init(udtContext* context, udtPatternSearchPlugIn& plugIn, udtProtocol::Id protocol, const char* filePath, s32 gameStateIndex, udtDemoNameCreator nameCreator, void* nameCreatorUserData)
+{
+	if(!_writer.Init(context, protocol, protocol, gameStateIndex, false))
+	{
+		return false;
+	}
+
+	_writer.SetFilePath(filePath);
+	_message.InitContext(context);
+	_message.InitProtocol(protocol);
+	_historyData.Clear();
+	_historyMessages.Clear();
+	_sections.Clear();
+	_writtenCuts.Clear();
+	_renamedFilePath = udtString::NewNull();
+	_plugIn = &plugIn;
+	_nameCreator = nameCreator;
+	_nameCreatorUserData = nameCreatorUserData;
+	_firstMessage = 0;
+	_sectionCount = 0;
+	_historyDurationMs = (s32)plugIn.GetInfo().StartOffsetSec * 1000 + UDT_SINGLE_PASS_CUT_EXTRA_HISTORY_MS;
+	_idleGameStateIndex = -1;
+	_idleMaxServerTimeMs = UDT_S32_MIN;
+	_writerStopped = false;
+	_fallBack = false;
+
+	return true;
+}
+
+bool udtSinglePassCutter::Run(udtBaseParser& parser, udtStream& file, const s32* cancelOperation, u32 fileEndOffset)
+{
+	udtMessage inMsg;
+	inMsg.InitContext(parser._context);
+	inMsg.InitProtocol(parser._inProtocol);
+
+	const u64 fileStartOffset = (u64)file.Offset();
+	const u64 maxByteCount = (fileEndOffset > 0 ? (u64)fileEndOffset : file.Length()) - fileStartOffset;
+	u64 fileOffset = fileStartOffset; // The parser gets absolute file offsets.
+	bool success = true;
+	for(;;)
+	{
+		if(cancelOperation != NULL && *cancelOperation != 0)
+		{
+			success = false;
+			break;
+		}
+
+		if(fileEndOffset > 0 && fileOffset >= (u64)fileEndOffset)
+		{
+			break;
+		}
+
+		if(_fallBack)
+		{
+			// The history is now only used as the read buffer of the analysis.
+			_historyData.Clear();
+			_historyMessages.Clear();
+			_firstMessage = 0;
+		}
+
+		s32 inServerMessageSequence = 0;
+		s32 byteCount = 0;
+		if(file.Read(&inServerMessageSequence, 4, 1) != 1 ||
+		   file.Read(&byteCount, 4, 1) != 1)
+		{
+			parser._context->LogWarning("Demo file %s is truncated", parser.GetFileNamePtr());
+			break;
+		}
+
+		if(byteCount == -1)
+		{
+			break;
+		}
+
+		if((u32)byteCount > (u32)ID_MAX_MSG_LENGTH)
+		{
+			parser._context->LogError("Demo file %s has a message length greater than MAX_SIZE", parser.GetFileNamePtr());
+			success = false;
+			break;
+		}
+
+		const u32 dataOffset = _historyData.GetSize();
+		_historyData.Extend((u32)byteCount + UDT_MESSAGE_READ_PADDING);
+		u8* const data = &_historyData[dataOffset];
+		memset(data + byteCount, 0, UDT_MESSAGE_READ_PADDING);
+		if(file.Read(data, (u32)byteCount, 1) != 1)
+		{
+			parser._context->LogWarning("Demo file %s is truncated", parser.GetFileNamePtr());
+			break;
+		}
+
+		inMsg.Init(data, byteCount + UDT_MESSAGE_READ_PADDING);
+		inMsg.Buffer.cursize = byteCount;
+		inMsg.Buffer.readcount = 0;
+		if(!parser.ParseNextMessage(inMsg, inServerMessageSequence, (u32)fileOffset))
+		{
+			// The analysis stopped early, the second pass will parse the rest of the demo as usual.
+			FallBack();
+			break;
+		}
+
+		if(!_fallBack)
+		{
+			HistoryMessage message;
+			message.DataOffset = dataOffset;
+			message.ByteCount = byteCount;
+			message.MessageSequence = inServerMessageSequence;
+			message.FileOffset = (u32)fileOffset;
+			message.ServerTimeMs = parser._inServerTime;
+			message.GameStateIndex = parser._inGameStateIndex;
+			_historyMessages.Add(message);
+
+			const u32 sectionCount = _plugIn->GetCurrentCutSectionCount();
+			if(sectionCount != _sectionCount)
+			{
+				_sectionCount = sectionCount;
+				_plugIn->GetCurrentCutSections(_sections);
+				if(!SyncCuts())
+				{
+					FallBack();
+				}
+			}
+
+			ReleaseMessages(false);
+		}
+
+		parser._context->NotifyProgress((f32)(fileOffset - fileStartOffset) / (f32)maxByteCount);
+		fileOffset += (u64)byteCount + 8;
+	}
+
+	parser.FinishParsing(success);
+	if(!success)
+	{
+		FallBack();
+		return false;
+	}
+
+	if(!_fallBack)
+	{
+		// The sections are now final.
+		_sections.Clear();
+		for(u32 i = 0, count = _plugIn->CutSections.GetSize(); i < count; ++i)
+		{
+			_sections.Add(_plugIn->CutSections[i]);
+		}
+
+		if(SyncCuts())
+		{
+			ReleaseMessages(true);
+		}
+		else
+		{
+			FallBack();
+		}
+	}
+
+	if(!_fallBack)
+	{
+		const bool writing = !_writer._cuts.IsEmpty() && _writer._outWriteMessage;
+		udtBaseParser::udtCutInfo cut;
+		if(writing)
+		{
+			cut = _writer._cuts[0];
+		}
+
+		_writer.FinishParsing(true);
+		if(_writer._outFileError)
+		{
+			FallBack();
+		}
+		else if(writing)
+		{
+			CloseCut(cut);
+		}
+	}
+
+	_historyData.Clear();
+	_historyMessages.Clear();
+	_firstMessage = 0;
+
+	return true;
+}
+
+bool udtSinglePassCutter::SyncCuts()
+{
+	const u32 writtenCount = _writtenCuts.GetSize();
+	const u32 sectionCount = _sections.GetSize();
+	if(sectionCount < writtenCount)
+	{
+		return false;
+	}
+
+	for(u32 i = 0; i < writtenCount; ++i)
+	{
+		const WrittenCut& cut = _writtenCuts[i];
+		const udtCutSection& section = _sections[i];
+		if(cut.GameStateIndex != section.GameStateIndex ||
+		   cut.StartTimeMs != section.StartTimeMs ||
+		   cut.EndTimeMs != section.EndTimeMs ||
+		   cut.VeryShortDesc != section.VeryShortDesc)
+		{
+			return false;
+		}
+	}
+
+	if(_writerStopped)
+	{
+		return true;
+	}
+
+	const bool writing = !_writer._cuts.IsEmpty() && _writer._outWriteMessage;
+	if(writtenCount == sectionCount)
+	{
+		_writer._cuts.Clear();
+		return !writing;
+	}
+
+	const udtCutSection& section = _sections[writtenCount];
+	if(writing)
+	{
+		// Only the end time of the cut being written can change, when it's merged with sections found later.
+		udtBaseParser::udtCutInfo& cut = _writer._cuts[0];
+		if(cut.GameStateIndex != section.GameStateIndex ||
+		   cut.StartTimeMs != section.StartTimeMs ||
+		   cut.EndTimeMs > section.EndTimeMs ||
+		   cut.VeryShortDesc != section.VeryShortDesc)
+		{
+			return false;
+		}
+
+		if(cut.EndTimeMs != section.EndTimeMs)
+		{
+			cut.EndTimeMs = section.EndTimeMs;
+			_renamedFilePath = CreateCutFilePath(cut);
+		}
+
+		return true;
+	}
+
+	if(!_writer._cuts.IsEmpty())
+	{
+		const udtBaseParser::udtCutInfo& cut = _writer._cuts[0];
+		if(cut.GameStateIndex == section.GameStateIndex &&
+		   cut.StartTimeMs == section.StartTimeMs &&
+		   cut.EndTimeMs == section.EndTimeMs &&
+		   cut.VeryShortDesc == section.VeryShortDesc)
+		{
+			return true;
+		}
+	}
+
+	// A second pass would have started the cut already if any of the messages we went through was in it.
+	if(_idleGameStateIndex > section.GameStateIndex ||
+	   (_idleGameStateIndex == section.GameStateIndex && _idleMaxServerTimeMs >= section.StartTimeMs))
+	{
+		return false;
+	}
+
+	_writer._cuts.Clear();
+	_writer.AddCut(section.GameStateIndex, section.StartTimeMs, section.EndTimeMs, _nameCreator, section.VeryShortDesc, _nameCreatorUserData);
+
+	return true;
+}
+
+void udtSinglePassCutter::ReleaseMessages(bool allMessages)
+{
+	const u32 messageCount = _historyMessages.GetSize();
+	if(messageCount == 0)
+	{
+		return;
+	}
+
+	const HistoryMessage lastMessage = _historyMessages[messageCount - 1];
+	while(_firstMessage < messageCount && !_fallBack)
+	{
+		const HistoryMessage message = _historyMessages[_firstMessage];
+		if(!allMessages &&
+		   message.GameStateIndex == lastMessage.GameStateIndex &&
+		   (s64)lastMessage.ServerTimeMs - (s64)message.ServerTimeMs <= (s64)_historyDurationMs)
+		{
+			break;
+		}
+
+		++_firstMessage;
+		WriteMessage(message);
+	}
+
+	if(_fallBack)
+	{
+		return;
+	}
+
+	if(_firstMessage == messageCount)
+	{
+		_historyData.Clear();
+		_historyMessages.Clear();
+		_firstMessage = 0;
+		return;
+	}
+
+	const u32 parsedByteCount = _historyMessages[_firstMessage].DataOffset;
+	const u32 leftByteCount = _historyData.GetSize() - parsedByteCount;
+	if(parsedByteCount < UDT_SINGLE_PASS_CUT_MIN_COMPACTION_BYTE_COUNT ||
+	   parsedByteCount < leftByteCount)
+	{
+		return;
+	}
+
+	const u32 leftMessageCount = messageCount - _firstMessage;
+	memmove(_historyData.GetStartAddress(), _historyData.GetStartAddress() + parsedByteCount, (size_t)leftByteCount);
+	memmove(_historyMessages.GetStartAddress(), _historyMessages.GetStartAddress() + _firstMessage, (size_t)leftMessageCount * sizeof(HistoryMessage));
+	_historyData.Resize(leftByteCount);
+	_historyMessages.Resize(leftMessageCount);
+	for(u32 i = 0; i < leftMessageCount; ++i)
+	{
+		_historyMessages[i].DataOffset -= parsedByteCount;
+	}
+	_firstMessage = 0;
+}
+
+void udtSinglePassCutter::WriteMessage(const HistoryMessage& message)
+{
+	const bool hadCut = !_writer._cuts.IsEmpty();
+	const bool wasWriting = hadCut && _writer._outWriteMessage;
+	udtBaseParser::udtCutInfo cut;
+	if(hadCut)
+	{
+		cut = _writer._cuts[0];
+	}
+
+	_message.Init(&_historyData[message.DataOffset], message.ByteCount + UDT_MESSAGE_READ_PADDING);
+	_message.Buffer.cursize = message.ByteCount;
+	_message.Buffer.readcount = 0;
+	const bool success = _writer.ParseNextMessage(_message, message.MessageSequence, message.FileOffset);
+	if(_writer._outFileError)
+	{
+		// The second pass will try again.
+		FallBack();
+		return;
+	}
+
+	if(wasWriting && (_writer._cuts.IsEmpty() || !_writer._outWriteMessage))
+	{
+		if(!_writer._cuts.IsEmpty())
+		{
+			// A new game state interrupted the cut.
+			// Like in a second pass, the writer will neither end it nor start any other.
+			_writerStopped = true;
+			if(!_writer.CloseOutputFile())
+			{
+				FallBack();
+				return;
+			}
+		}
+
+		CloseCut(cut);
+		if(!_fallBack && !SyncCuts())
+		{
+			FallBack();
+		}
+		return;
+	}
+
+	if(!success || (hadCut && _writer._cuts.IsEmpty()))
+	{
+		// Parsing failed or the output file couldn't be created.
+		FallBack();
+		return;
+	}
+
+	if(!_writer._outWriteMessage)
+	{
+		if(_writer._inGameStateIndex != _idleGameStateIndex)
+		{
+			_idleGameStateIndex = _writer._inGameStateIndex;
+			_idleMaxServerTimeMs = _writer._inServerTime;
+		}
+		else
+		{
+			_idleMaxServerTimeMs = udt_max(_idleMaxServerTimeMs, _writer._inServerTime);
+		}
+	}
+}
+
+void udtSinglePassCutter::CloseCut(const udtBaseParser::udtCutInfo& cut)
+{
+	WrittenCut writtenCut;
+	writtenCut.FilePath = _writer._outFilePath;
+	writtenCut.VeryShortDesc = cut.VeryShortDesc;
+	writtenCut.GameStateIndex = cut.GameStateIndex;
+	writtenCut.StartTimeMs = cut.StartTimeMs;
+	writtenCut.EndTimeMs = cut.EndTimeMs;
+
+	// The messages the writer goes through before the next cut starts are tracked from here.
+	_idleGameStateIndex = -1;
+	_idleMaxServerTimeMs = UDT_S32_MIN;
+
+	const udtString renamedFilePath = _renamedFilePath;
+	_renamedFilePath = udtString::NewNull();
+	if(!udtString::IsNullOrEmpty(renamedFilePath) &&
+	   !udtString::Equals(renamedFilePath, writtenCut.FilePath))
+	{
+		if(!udtFileStream::Rename(writtenCut.FilePath.GetPtr(), renamedFilePath.GetPtr()))
+		{
+			_writtenCuts.Add(writtenCut);
+			FallBack();
+			return;
+		}
+
+		writtenCut.FilePath = renamedFilePath;
+	}
+
+	_writtenCuts.Add(writtenCut);
+}
+
+void udtSinglePassCutter::FallBack()
+{
+	if(_fallBack)
+	{
+		return;
+	}
+
+	_fallBack = true;
+
+	const bool writing = !_writer._cuts.IsEmpty() && _writer._outWriteMessage;
+	_writer.FinishParsing(false);
+	if(writing)
+	{
+		udtFileStream::Delete(_writer._outFilePath.GetPtr());
+	}
+
+	for(u32 i = 0, count = _writtenCuts.GetSize(); i < count; ++i)
+	{
+		udtFileStream::Delete(_writtenCuts[i].FilePath.GetPtr());
+	}
+
+	_writtenCuts.Clear();
+	_renamedFilePath = udtString::NewNull();
+}
+
+udtString udtSinglePassCutter::CreateCutFilePath(const udtBaseParser::udtCutInfo& cut)
+{
+	udtDemoStreamCreatorArg info;
+	memset(&info, 0, sizeof(info));
+	info.StartTimeMs = cut.StartTimeMs;
+	info.EndTimeMs = cut.EndTimeMs;
+	info.Parser = &_writer;
+	info.VeryShortDesc = cut.VeryShortDesc;
+	info.UserData = cut.UserData;
+	info.TempAllocator = &_writer._tempAllocator;
+	info.FilePathAllocator = &_writer._persistentAllocator;
+
+	return (*cut.StreamCreator)(info);
+}
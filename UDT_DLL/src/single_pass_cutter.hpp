@@ -0,0 +1,76 @@
+#pragma once
+
+
+#include "parser.hpp"
+#include "plug_in_pattern_search.hpp"
+#include "cut_section.hpp"
+#include "array.hpp"
+
+
+// Server time, in milli-seconds, kept in the history on top of the start offset.
+// Patterns are found up to a snapshot after the server time their cut sections are relative to.
+#define UDT_SINGLE_PASS_CUT_EXTRA_HISTORY_MS 1000
+
+
+// Writes the cut sections of a pattern search while the demo is being analyzed, so that it's only read once.
+// The messages read are kept in a rolling history as long as a pattern found later could still start a cut there
+// and a second parser, which always stays that far behind the analysis, writes the cuts from the history.
+// When a cut can't be written exactly like the second pass would (e.g. the pattern was found too late for the history),
+// the files written are deleted and WroteAllCuts returns false.
+struct udtSinglePassCutter
+{
+public:
+	udtSinglePassCutter();
+	~udtSinglePassCutter();
+
+	bool Init(udtContext* context, udtPatternSearchPlugIn& plugIn, udtProtocol::Id protocol, const char* filePath, s32 gameStateIndex, udtDemoNameCreator nameCreator, void* nameCreatorUserData); // Once for each demo.
+	bool Run(udtBaseParser& parser, udtStream& file, const s32* cancelOperation, u32 fileEndOffset = 0); // The parser must be initialized. Same return value as RunParser.
+	bool WroteAllCuts() const { return !_fallBack; } // If false, the plug-in's cut sections still need to be written.
+
+private:
+	UDT_NO_COPY_SEMANTICS(udtSinglePassCutter);
+
+	struct HistoryMessage
+	{
+		u32 DataOffset;
+		s32 ByteCount;
+		s32 MessageSequence;
+		u32 FileOffset;
+		s32 ServerTimeMs;
+		s32 GameStateIndex;
+	};
+
+	struct WrittenCut
+	{
+		udtString FilePath;
+		const char* VeryShortDesc;
+		s32 GameStateIndex;
+		s32 StartTimeMs;
+		s32 EndTimeMs;
+	};
+
+	bool      SyncCuts(); // Returns false if the cuts written so far don't match the sections anymore.
+	void      ReleaseMessages(bool allMessages);
+	void      WriteMessage(const HistoryMessage& message);
+	void      CloseCut(const udtBaseParser::udtCutInfo& cut);
+	void      FallBack();
+	udtString CreateCutFilePath(const udtBaseParser::udtCutInfo& cut);
+
+	udtBaseParser _writer;
+	udtMessage _message;
+	udtVMArray<u8> _historyData { "SinglePassCutter::HistoryDataArray" }; // Each message is followed by UDT_MESSAGE_READ_PADDING zeroed bytes.
+	udtVMArray<HistoryMessage> _historyMessages { "SinglePassCutter::HistoryMessagesArray" };
+	udtVMArray<udtCutSection> _sections { "SinglePassCutter::SectionsArray" }; // The plug-in's sections so far.
+	udtVMArray<WrittenCut> _writtenCuts { "SinglePassCutter::WrittenCutsArray" };
+	udtString _renamedFilePath; // Of the cut being written, if its end time changed after the file was opened.
+	udtPatternSearchPlugIn* _plugIn;
+	udtDemoNameCreator _nameCreator;
+	void* _nameCreatorUserData;
+	u32 _firstMessage; // Index of the oldest message the writer hasn't parsed yet.
+	u32 _sectionCount; // Value of the plug-in's GetCurrentCutSectionCount when _sections was last updated.
+	s32 _historyDurationMs;
+	s32 _idleGameStateIndex; // Of the last message parsed by the writer since the last cut ended while not writing.
+	s32 _idleMaxServerTimeMs; // Of the messages parsed by the writer in that game state since the last cut ended while not writing.
+	bool _writerStopped; // A cut was interrupted by a game state change.
+	bool _fallBack;
+};
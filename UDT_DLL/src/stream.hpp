@@ -27,6 +27,11 @@ struct udtStream
 	virtual u64 Length() = 0; // -1 for failure.
 	virtual s32 Close() = 0; // 0 for success. Must be safe to call more than once.
 
+	// Zero-copy read for streams that have all their data addressable.
+	// Returns NULL and doesn't advance when not supported or when fewer than 
+	// byteCount + paddingByteCount bytes can be safely accessed from the current offset.
+	virtual const u8* ReadInPlace(u32 /*byteCount*/, u32 /*paddingByteCount*/) { return NULL; }
+
 	uptr      ReadAll(udtVMLinearAllocator& allocator);
 	udtString ReadAllAsString(udtVMLinearAllocator& allocator); // Will allocate and set the trailing NULL terminator.
 };
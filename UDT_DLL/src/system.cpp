@@ -66,10 +66,80 @@ bool GetProcessorCoreCount(u32&)
 
 
 #include <unistd.h>
+#include <sched.h>
+#include <stdio.h>
 
 
+static bool ReadCPUTopologyValue(u32& value, u32 cpuIndex, const char* fileName)
+{
+	char filePath[256];
+	snprintf(filePath, sizeof(filePath), "/sys/devices/system/cpu/cpu%u/topology/%s", cpuIndex, fileName);
+	FILE* const file = fopen(filePath, "r");
+	if(file == NULL)
+	{
+		return false;
+	}
+
+	unsigned int temp = 0;
+	const bool success = fscanf(file, "%u", &temp) == 1;
+	fclose(file);
+	value = (u32)temp;
+
+	return success;
+}
+
 bool GetProcessorCoreCount(u32& coreCount)
 {
+	// We count the physical cores the process is allowed to run on, like the Windows version does.
+	// Restricting the process to a NUMA node (numactl, taskset, cgroups) thus limits the count too.
+	// Hyper-threading siblings share a core ID within a package and get counted once.
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	if(sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0)
+	{
+		u32 coreIds[CPU_SETSIZE]; // Package ID in the high 16 bits, core ID in the low 16 bits.
+		u32 count = 0;
+		bool success = true;
+		for(u32 i = 0; i < (u32)CPU_SETSIZE; ++i)
+		{
+			if(!CPU_ISSET(i, &cpuSet))
+			{
+				continue;
+			}
+
+			u32 packageId = 0;
+			u32 coreId = 0;
+			if(!ReadCPUTopologyValue(packageId, i, "physical_package_id") ||
+			   !ReadCPUTopologyValue(coreId, i, "core_id"))
+			{
+				success = false;
+				break;
+			}
+
+			const u32 id = (packageId << 16) | (coreId & 0xFFFF);
+			bool found = false;
+			for(u32 j = 0; j < count; ++j)
+			{
+				if(coreIds[j] == id)
+				{
+					found = true;
+					break;
+				}
+			}
+
+			if(!found)
+			{
+				coreIds[count++] = id;
+			}
+		}
+
+		if(success && count > 0)
+		{
+			coreCount = count;
+			return true;
+		}
+	}
+
 	// "the number of processors which are currently online (i.e., available)"
 	const long result = sysconf(_SC_NPROCESSORS_ONLN);
 	if(result == -1)
@@ -7,8 +7,11 @@
 #	include <Windows.h>
 #else
 #	include <pthread.h>
+#	include <semaphore.h>
 #	include <stdlib.h>
 #	include <string.h>
+#	include <errno.h>
+#	include <time.h>
 #endif
 
 
@@ -31,6 +34,20 @@ DWORD WINAPI GlobalThreadCallback(LPVOID lpThreadParameter)
 
 #else
 
+static bool GetAbsoluteTimeout(timespec& ts, u32 timeoutMs)
+{
+	if(clock_gettime(CLOCK_REALTIME, &ts) == -1)
+	{
+		return false;
+	}
+
+	const long nanoSeconds = ts.tv_nsec + (long)(timeoutMs % 1000) * (long)1000000;
+	ts.tv_sec += (time_t)(timeoutMs / 1000) + (time_t)(nanoSeconds / 1000000000);
+	ts.tv_nsec = nanoSeconds % 1000000000;
+
+	return true;
+}
+
 void* GlobalThreadCallback(void* threadParameter)
 {
 	udtThread* const thread = (udtThread*)threadParameter;
@@ -54,6 +71,7 @@ udtThread::udtThread()
 	_threadhandle = NULL;
 	_userData = NULL;
 	_entryPoint = NULL;
+	_joined = false;
 }
 
 udtThread::~udtThread()
@@ -70,6 +88,7 @@ bool udtThread::CreateAndStart(ThreadEntryPoint entryPoint, void* userData)
 
 	_entryPoint = entryPoint;
 	_userData = userData;
+	_joined = false;
 
 #if defined(UDT_WINDOWS)
 
@@ -103,12 +122,19 @@ bool udtThread::Join()
 	{
 		return false;
 	}
+
+	if(_joined)
+	{
+		return true;
+	}
 	
 #if defined(UDT_WINDOWS)
-	return WaitForSingleObject((HANDLE)_threadhandle, INFINITE) == WAIT_OBJECT_0;
+	_joined = WaitForSingleObject((HANDLE)_threadhandle, INFINITE) == WAIT_OBJECT_0;
 #else
-	return pthread_join(*(pthread_t*)_threadhandle, NULL) == 0;
+	_joined = pthread_join(*(pthread_t*)_threadhandle, NULL) == 0;
 #endif
+
+	return _joined;
 }
 
 bool udtThread::TimedJoin(u32 timeoutMs)
@@ -118,20 +144,28 @@ bool udtThread::TimedJoin(u32 timeoutMs)
 		return false;
 	}
 
+	if(_joined)
+	{
+		return true;
+	}
+
 #if defined(UDT_WINDOWS)
 
-	return WaitForSingleObject((HANDLE)_threadhandle, (DWORD)timeoutMs) == WAIT_OBJECT_0;
+	_joined = WaitForSingleObject((HANDLE)_threadhandle, (DWORD)timeoutMs) == WAIT_OBJECT_0;
+
+	return _joined;
 
 #elif defined(_GNU_SOURCE)
 
 	timespec ts;
-	if(clock_gettime(CLOCK_REALTIME, &ts) == -1)
+	if(!GetAbsoluteTimeout(ts, timeoutMs))
 	{
 		return false;
 	}
-	ts.tv_nsec += (long)timeoutMs * (long)1000000;
 
-	return pthread_timedjoin_np(*(pthread_t*)_threadhandle, NULL, &ts) == 0;
+	_joined = pthread_timedjoin_np(*(pthread_t*)_threadhandle, NULL, &ts) == 0;
+
+	return _joined;
 
 #else
 
@@ -161,3 +195,147 @@ void udtThread::InvokeUserFunction()
 		(*_entryPoint)(_userData);
 	}
 }
+
+udtSemaphore::udtSemaphore()
+{
+	_handle = NULL;
+}
+
+udtSemaphore::~udtSemaphore()
+{
+	Destroy();
+}
+
+bool udtSemaphore::Init(u32 initialCount)
+{
+	if(_handle != NULL)
+	{
+		return false;
+	}
+
+#if defined(UDT_WINDOWS)
+	_handle = (void*)CreateSemaphoreA(NULL, (LONG)initialCount, (LONG)0x7FFFFFFF, NULL);
+
+	return _handle != NULL;
+#else
+	sem_t* const semaphore = (sem_t*)udt_malloc(sizeof(sem_t));
+	if(semaphore == NULL)
+	{
+		return false;
+	}
+
+	if(sem_init(semaphore, 0, (unsigned int)initialCount) != 0)
+	{
+		free(semaphore);
+		return false;
+	}
+	_handle = semaphore;
+
+	return true;
+#endif
+}
+
+void udtSemaphore::Destroy()
+{
+	if(_handle == NULL)
+	{
+		return;
+	}
+
+#if defined(UDT_WINDOWS)
+	CloseHandle((HANDLE)_handle);
+#else
+	sem_destroy((sem_t*)_handle);
+	free(_handle);
+#endif
+
+	_handle = NULL;
+}
+
+bool udtSemaphore::Post()
+{
+	if(_handle == NULL)
+	{
+		return false;
+	}
+
+#if defined(UDT_WINDOWS)
+	return ReleaseSemaphore((HANDLE)_handle, 1, NULL) != FALSE;
+#else
+	return sem_post((sem_t*)_handle) == 0;
+#endif
+}
+
+bool udtSemaphore::Wait()
+{
+	if(_handle == NULL)
+	{
+		return false;
+	}
+
+#if defined(UDT_WINDOWS)
+	return WaitForSingleObject((HANDLE)_handle, INFINITE) == WAIT_OBJECT_0;
+#else
+	for(;;)
+	{
+		if(sem_wait((sem_t*)_handle) == 0)
+		{
+			return true;
+		}
+
+		if(errno != EINTR)
+		{
+			return false;
+		}
+	}
+#endif
+}
+
+bool udtSemaphore::TimedWait(u32 timeoutMs)
+{
+	if(_handle == NULL)
+	{
+		return false;
+	}
+
+#if defined(UDT_WINDOWS)
+	return WaitForSingleObject((HANDLE)_handle, (DWORD)timeoutMs) == WAIT_OBJECT_0;
+#else
+	timespec ts;
+	if(!GetAbsoluteTimeout(ts, timeoutMs))
+	{
+		return false;
+	}
+
+	for(;;)
+	{
+		if(sem_timedwait((sem_t*)_handle, &ts) == 0)
+		{
+			return true;
+		}
+
+		if(errno != EINTR)
+		{
+			return false;
+		}
+	}
+#endif
+}
+
+u32 AtomicIncrement(volatile u32* value)
+{
+#if defined(UDT_WINDOWS)
+	return (u32)InterlockedIncrement((volatile LONG*)value);
+#else
+	return __sync_add_and_fetch(value, (u32)1);
+#endif
+}
+
+u32 AtomicDecrement(volatile u32* value)
+{
+#if defined(UDT_WINDOWS)
+	return (u32)InterlockedDecrement((volatile LONG*)value);
+#else
+	return __sync_sub_and_fetch(value, (u32)1);
+#endif
+}
@@ -2,6 +2,7 @@
 
 
 #include "uberdemotools.h"
+#include "macros.hpp"
 
 
 struct udtThread
@@ -23,4 +24,26 @@ private:
 	void* _threadhandle;
 	void* _userData;
 	ThreadEntryPoint _entryPoint;
+	bool _joined; // A pthread can only be joined once.
 };
+
+struct udtSemaphore
+{
+	udtSemaphore();
+	~udtSemaphore();
+
+	bool Init(u32 initialCount);
+	void Destroy();
+	bool Post();
+	bool Wait();
+	bool TimedWait(u32 timeoutMs); // Returns false on time-out.
+
+private:
+	UDT_NO_COPY_SEMANTICS(udtSemaphore);
+
+	void* _handle;
+};
+
+// Atomically increments/decrements the value and returns the new value.
+extern u32 AtomicIncrement(volatile u32* value);
+extern u32 AtomicDecrement(volatile u32* value);
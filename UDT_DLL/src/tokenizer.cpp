@@ -1,13 +1,94 @@
 #include "tokenizer.hpp"
+#include "utils.hpp"
 
 #include <stdlib.h>
 #include <malloc.h>
 #include <string.h>
 
+// The SSE2 version reads past the null terminator, which AddressSanitizer reports.
+#if (defined(UDT_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && !defined(__SANITIZE_ADDRESS__)
+#	define UDT_TOKENIZER_SSE2
+#	include <emmintrin.h>
+#endif
+
 
 static const char* EmptyString = "";
 
 
+static bool IsTokenRunEnd(char c, bool quoted, bool stopAtQuotes)
+{
+	if(quoted)
+	{
+		return c == '\0' || c == '"';
+	}
+
+	return c <= ' ' || c == '/' || (stopAtQuotes && c == '"');
+}
+
+// Returns the number of characters that can be copied as-is to the current token.
+// Quoted runs end at the closing quote or the null terminator.
+// Unquoted runs end at whitespace, the null terminator, a quote (unless ignored) or a slash (for comments).
+static u32 GetTokenRunLength(const char* text, bool quoted, bool stopAtQuotes)
+{
+	const char* const start = text;
+#if defined(UDT_TOKENIZER_SSE2)
+	while(((uptr)text & 15) != 0)
+	{
+		if(IsTokenRunEnd(*text, quoted, stopAtQuotes))
+		{
+			return (u32)(text - start);
+		}
+		++text;
+	}
+
+	// Aligned loads never cross a page boundary, so reading past the null terminator is safe.
+	// The signed comparison treats bytes above 127 as whitespace, just like the scalar version.
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i spacePlusOne = _mm_set1_epi8(' ' + 1);
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i slash = _mm_set1_epi8('/');
+	const __m128i quoteMask = stopAtQuotes ? _mm_set1_epi8(-1) : zero;
+	for(;;)
+	{
+		const __m128i chars = _mm_load_si128((const __m128i*)text);
+		__m128i ends;
+		if(quoted)
+		{
+			ends = _mm_or_si128(_mm_cmpeq_epi8(chars, zero), _mm_cmpeq_epi8(chars, quote));
+		}
+		else
+		{
+			ends = _mm_or_si128(_mm_cmplt_epi8(chars, spacePlusOne), _mm_cmpeq_epi8(chars, slash));
+			ends = _mm_or_si128(ends, _mm_and_si128(_mm_cmpeq_epi8(chars, quote), quoteMask));
+		}
+
+		const u32 endMask = (u32)_mm_movemask_epi8(ends);
+		if(endMask != 0)
+		{
+			return (u32)(text - start) + GetLowestSetBitIndex((u64)endMask);
+		}
+		text += 16;
+	}
+#else
+	while(!IsTokenRunEnd(*text, quoted, stopAtQuotes))
+	{
+		++text;
+	}
+
+	return (u32)(text - start);
+#endif
+}
+
+
+idTokenizer::idTokenizer()
+{
+	_originalCommand = EmptyString;
+	_nextText = NULL;
+	_nextOut = _tokenizedCommand;
+	_argCount = 0;
+	_ignoreQuotes = false;
+}
+
 const char* idTokenizer::GetOriginalCommand() const
 {
 	return _originalCommand;
@@ -15,12 +96,14 @@ const char* idTokenizer::GetOriginalCommand() const
 
 u32	idTokenizer::GetArgCount() const
 {
+	TokenizeUpTo(MAX_STRING_TOKENS);
+
 	return _argCount;
 }
 
 const char* idTokenizer::GetArgString(u32 arg) const
 {
-	if(arg >= _argCount || arg >= MAX_STRING_TOKENS)
+	if(arg >= MAX_STRING_TOKENS || !TokenizeUpTo(arg + 1))
 	{
 		return EmptyString;
 	}
@@ -30,7 +113,7 @@ const char* idTokenizer::GetArgString(u32 arg) const
 
 u32 idTokenizer::GetArgLength(u32 arg) const
 {
-	if(arg >= _argCount || arg >= MAX_STRING_TOKENS)
+	if(arg >= MAX_STRING_TOKENS || !TokenizeUpTo(arg + 1))
 	{
 		return 0;
 	}
@@ -40,7 +123,7 @@ u32 idTokenizer::GetArgLength(u32 arg) const
 
 u32 idTokenizer::GetArgOffset(u32 arg) const
 {
-	if(arg >= _argCount || arg >= MAX_STRING_TOKENS)
+	if(arg >= MAX_STRING_TOKENS || !TokenizeUpTo(arg + 1))
 	{
 		return 0;
 	}
@@ -50,7 +133,7 @@ u32 idTokenizer::GetArgOffset(u32 arg) const
 
 udtString idTokenizer::GetArg(u32 arg) const
 {
-	if(arg >= _argCount || arg >= MAX_STRING_TOKENS)
+	if(arg >= MAX_STRING_TOKENS || !TokenizeUpTo(arg + 1))
 	{
 		return udtString::NewEmptyConstant();
 	}
@@ -58,138 +141,142 @@ udtString idTokenizer::GetArg(u32 arg) const
 	return udtString::NewConstRef(_argStrings[arg], _argLengths[arg]);
 }
 
-void idTokenizer::TokenizeImpl(const char* text, bool ignoreQuotes)
+void idTokenizer::Tokenize(const char* text, bool ignoreQuotes)
 {
 	// clear previous args
 	_argCount = 0;
+	_nextOut = _tokenizedCommand;
+	_nextText = text;
+	_originalCommand = text != NULL ? text : EmptyString;
+	_ignoreQuotes = ignoreQuotes;
+}
+
+bool idTokenizer::TokenizeUpTo(u32 argCount) const
+{
+	while(_argCount < argCount)
+	{
+		if(!TokenizeNextArg())
+		{
+			return false;
+		}
+	}
 
-	if(!text)
-		return;
+	return true;
+}
 
-	Q_strncpyz(_originalCommand, text, sizeof(_originalCommand));
+bool idTokenizer::TokenizeNextArg() const
+{
+	const char* text = _nextText;
+	if(text == NULL)
+	{
+		return false;
+	}
 
-	const char* const in = text;
-	char* out = _tokenizedCommand;
+	_nextText = NULL;
+	if(_argCount == MAX_STRING_TOKENS)
+	{
+		return false;			// this is usually something malicious
+	}
 
 	for(;;)
 	{
-		if(_argCount == MAX_STRING_TOKENS)
+		// skip whitespace
+		while(CharAt(text) != '\0' && *text <= ' ')
 		{
-			return;			// this is usually something malicious
+			text++;
 		}
-
-		for(;;)
+		if(CharAt(text) == '\0')
 		{
-			// skip whitespace
-			while(*text && *text <= ' ')
-			{
-				text++;
-			}
-			if(!*text)
-			{
-				return;			// all tokens parsed
-			}
-
-			// skip // comments
-			if(text[0] == '/' && text[1] == '/')
-			{
-				return;			// all tokens parsed
-			}
+			return false;			// all tokens parsed
+		}
 
-			// skip /* */ comments
-			if(text[0] == '/' && text[1] == '*')
-			{
-				while(*text && (text[0] != '*' || text[1] != '/'))
-				{
-					text++;
-				}
-				if(!*text)
-				{
-					return;		// all tokens parsed
-				}
-				text += 2;
-			}
-			else
-			{
-				break;			// we are ready to parse a token
-			}
+		// skip // comments
+		if(text[0] == '/' && CharAt(text + 1) == '/')
+		{
+			return false;			// all tokens parsed
 		}
 
-		// handle quoted strings - NOTE: this doesn't handle \" escaping
-		if(!ignoreQuotes && *text == '"')
+		// skip /* */ comments
+		if(text[0] == '/' && CharAt(text + 1) == '*')
 		{
-			_argStrings[_argCount] = out;
-			_argOffsets[_argCount] = (u32)(text - in);
-			_argCount++;
-			text++;
-			while(*text && *text != '"')
+			while(CharAt(text) != '\0' && (text[0] != '*' || CharAt(text + 1) != '/'))
 			{
-				*out++ = *text++;
+				text++;
 			}
-			*out++ = 0;
-			if(!*text)
+			if(CharAt(text) == '\0')
 			{
-				return;		// all tokens parsed
+				return false;		// all tokens parsed
 			}
-			text++;
-			continue;
+			text += 2;
+		}
+		else
+		{
+			break;			// we are ready to parse a token
 		}
+	}
 
-		// regular token
-		_argStrings[_argCount] = out;
-		_argOffsets[_argCount] = (u32)(text - in);
-		_argCount++;
+	char* out = _nextOut;
+	char* const argString = out;
+	_argStrings[_argCount] = argString;
+	_argOffsets[_argCount] = (u32)(text - _originalCommand);
 
-		// skip until whitespace, quote, or command
-		while(*text > ' ')
+	// handle quoted strings - NOTE: this doesn't handle \" escaping
+	if(!_ignoreQuotes && *text == '"')
+	{
+		text++;
+		const u32 length = ClampRunLength(text, GetTokenRunLength(text, true, true));
+		memcpy(out, text, (size_t)length);
+		out += length;
+		text += length;
+		*out++ = 0;
+		_argLengths[_argCount++] = length;
+		_nextOut = out;
+		if(CharAt(text) != '\0')
 		{
-			if(!ignoreQuotes && text[0] == '"')
-			{
-				break;
-			}
+			_nextText = text + 1;
+		}
 
-			if(text[0] == '/' && text[1] == '/')
-			{
-				break;
-			}
+		return true;
+	}
 
-			// skip /* */ comments
-			if(text[0] == '/' && text[1] == '*')
-			{
-				break;
-			}
+	// regular token: copy until whitespace, quote, or comment
+	for(;;)
+	{
+		const u32 length = ClampRunLength(text, GetTokenRunLength(text, false, !_ignoreQuotes));
+		memcpy(out, text, (size_t)length);
+		out += length;
+		text += length;
 
+		// a single slash is part of the token
+		if(CharAt(text) == '/' && CharAt(text + 1) != '/' && CharAt(text + 1) != '*')
+		{
 			*out++ = *text++;
+			continue;
 		}
 
-		*out++ = 0;
-
-		if(!*text)
-		{
-			return;		// all tokens parsed
-		}
+		break;
 	}
-}
 
-void idTokenizer::RegisterArgLengths()
-{
-	if(_argCount == 0)
+	_argLengths[_argCount++] = (u32)(out - argString);
+	*out++ = 0;
+	_nextOut = out;
+	if(CharAt(text) != '\0')
 	{
-		return;
+		_nextText = text;
 	}
 
-	const u32 lastIndex = _argCount - 1;
-	for(u32 i = 0; i < lastIndex; ++i)
-	{
-		// -1 is not counting the the null terminator separating the arguments.
-		_argLengths[i] = (u32)(_argStrings[i + 1] - _argStrings[i] - 1);
-	}
+	return true;
+}
 
-	_argLengths[lastIndex] = (u32)strlen(_argStrings[lastIndex]);
+char idTokenizer::CharAt(const char* text) const
+{
+	return (u32)(text - _originalCommand) < (u32)UDT_TOKENIZER_MAX_COMMAND_LENGTH ? *text : '\0';
 }
 
-void idTokenizer::Tokenize(const char* text, bool ignoreQuotes)
+u32 idTokenizer::ClampRunLength(const char* text, u32 length) const
 {
-	TokenizeImpl(text, ignoreQuotes);
-	RegisterArgLengths();
+	const u32 offset = (u32)(text - _originalCommand);
+	const u32 maxLength = offset < (u32)UDT_TOKENIZER_MAX_COMMAND_LENGTH ? (u32)UDT_TOKENIZER_MAX_COMMAND_LENGTH - offset : 0;
+
+	return udt_min(length, maxLength);
 }
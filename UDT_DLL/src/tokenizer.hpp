@@ -5,11 +5,21 @@
 #include "string.hpp"
 
 
+// Only that many characters of a command get tokenized, the rest is ignored.
+// This bounds the size of the tokenized copy to that of _tokenizedCommand.
+#define UDT_TOKENIZER_MAX_COMMAND_LENGTH (BIG_INFO_STRING - 1)
+
+
+// The text passed to Tokenize isn't copied and must remain valid while the tokens are being read.
+// Tokens are only extracted when first requested:
+// reading the first arguments doesn't tokenize the rest of the command.
 struct idTokenizer
 {
 public:
+	idTokenizer();
+
 	const char* GetOriginalCommand() const;
-	u32         GetArgCount() const;
+	u32         GetArgCount() const; // Tokenizes the entire command.
 	const char* GetArgString(u32 arg) const;
 	u32         GetArgLength(u32 arg) const;
 	u32         GetArgOffset(u32 arg) const;
@@ -17,13 +27,18 @@ public:
 	void        Tokenize(const char* text, bool ignoreQuotes = false);
 
 private:
-	void        TokenizeImpl(const char* text, bool ignoreQuotes = false);
-	void        RegisterArgLengths();
-
-	u32   _argCount;
-	char* _argStrings[MAX_STRING_TOKENS]; // Points into _tokenizedCommand.
-	u32   _argLengths[MAX_STRING_TOKENS];
-	u32   _argOffsets[MAX_STRING_TOKENS];
-	char  _tokenizedCommand[BIG_INFO_STRING+MAX_STRING_TOKENS];	// Will have 0 bytes inserted.
-	char  _originalCommand[BIG_INFO_STRING]; // The original command we received (no token processing).
+	bool        TokenizeUpTo(u32 argCount) const; // Returns true if there are at least argCount arguments.
+	bool        TokenizeNextArg() const; // Returns false if there are no arguments left.
+	char        CharAt(const char* text) const; // Null past UDT_TOKENIZER_MAX_COMMAND_LENGTH.
+	u32         ClampRunLength(const char* text, u32 length) const; // So that the run doesn't go past UDT_TOKENIZER_MAX_COMMAND_LENGTH.
+
+	const char*   _originalCommand; // The original command we received (no token processing).
+	mutable const char* _nextText; // Where the search for the next token starts. NULL when done.
+	mutable char* _nextOut; // Where the next token gets written.
+	mutable u32   _argCount; // Number of arguments tokenized so far.
+	mutable char* _argStrings[MAX_STRING_TOKENS]; // Points into _tokenizedCommand.
+	mutable u32   _argLengths[MAX_STRING_TOKENS];
+	mutable u32   _argOffsets[MAX_STRING_TOKENS];
+	mutable char  _tokenizedCommand[BIG_INFO_STRING+MAX_STRING_TOKENS];	// Will have 0 bytes inserted.
+	bool          _ignoreQuotes;
 };
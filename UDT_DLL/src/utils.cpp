@@ -350,10 +350,10 @@ s32 GetErrorCode(bool success, const s32* cancel)
 	return (s32)((cancel != NULL && *cancel != 0) ? udtErrorCode::OperationCanceled : udtErrorCode::OperationFailed);
 }
 
-bool RunParser(udtBaseParser& parser, udtStream& file, const s32* cancelOperation)
+bool RunParser(udtBaseParser& parser, udtStream& file, const s32* cancelOperation, u32 fileEndOffset)
 {
 	udtParserRunner runner;
-	if(!runner.Init(parser, file, cancelOperation))
+	if(!runner.Init(parser, file, cancelOperation, fileEndOffset))
 	{
 		return false;
 	}
@@ -536,25 +536,20 @@ const char* GetUDTModName(s32 mod)
 	return MeansOfDeathNames[mod];
 }
 
-bool GetClanAndPlayerName(udtString& clan, udtString& player, bool& hasClan, udtVMLinearAllocator& allocator, udtProtocol::Id protocol, const char* configString)
+bool GetClanAndPlayerName(udtString& clan, udtString& player, bool& hasClan, udtVMLinearAllocator& allocator, udtBaseParser& parser, s32 csIndex)
 {
-	if(configString == NULL)
-	{
-		return false;
-	}
-
 	hasClan = false;
 
 	udtString clanAndPlayer;
-	if(!ParseConfigStringValueString(clanAndPlayer, allocator, "n", configString))
+	if(!parser.GetConfigStringValueString(clanAndPlayer, csIndex, "n"))
 	{
 		return false;
 	}
 
 	// "xcn" was for the full clan name, "c" for the country.
-	const bool hasClanName = AreAllProtocolFlagsSet(protocol, udtProtocolFlagsEx::QL_ClanName);
+	const bool hasClanName = AreAllProtocolFlagsSet(parser._inProtocol, udtProtocolFlagsEx::QL_ClanName);
 	if(hasClanName &&
-	   ParseConfigStringValueString(clan, allocator, "cn", configString))
+	   parser.GetConfigStringValueString(clan, csIndex, "cn"))
 	{
 		hasClan = true;
 		player = clanAndPlayer;
@@ -638,6 +633,10 @@ void PerfStatsFinalize(u64* perfStats, u32 threadCount, u64 durationUs)
 		((1000000 * perfStats[udtPerfStatsField::DataProcessed]) / durationUs) : 0;
 	perfStats[udtPerfStatsField::MemoryEfficiency] = (perfStats[udtPerfStatsField::MemoryCommitted] > 0) ?
 		((1000 * perfStats[udtPerfStatsField::MemoryUsed]) / perfStats[udtPerfStatsField::MemoryCommitted]) : 0;
+
+	// Overwritten by multi-threaded jobs.
+	perfStats[udtPerfStatsField::ThreadUtilization] = 1000;
+	perfStats[udtPerfStatsField::MinThreadUtilization] = 1000;
 }
 
 void WriteStringToApiStruct(u32& offset, const udtString& string)
@@ -8,6 +8,10 @@
 #include "string.hpp"
 #include "look_up_tables.hpp"
 
+#if defined(UDT_MSVC)
+#	include <intrin.h>
+#endif
+
 
 // On Windows, MAX_PATH is 260.
 #define UDT_MAX_PATH_LENGTH    320
@@ -52,6 +56,46 @@ void UDT_INLINE ClearBit(void* bits, u32 index)
 	((u8*)bits)[byteIndex] &= ~((u8)1 << (u8)bitIndex);
 }
 
+// The value must not be 0.
+u32 UDT_INLINE GetLowestSetBitIndex(u64 value)
+{
+#if defined(UDT_MSVC) && defined(UDT_X64)
+	unsigned long index;
+	_BitScanForward64(&index, value);
+	return (u32)index;
+#elif defined(UDT_MSVC)
+	unsigned long index;
+	if(_BitScanForward(&index, (unsigned long)value) == 0)
+	{
+		_BitScanForward(&index, (unsigned long)(value >> 32));
+		index += 32;
+	}
+	return (u32)index;
+#else
+	return (u32)__builtin_ctzll(value);
+#endif
+}
+
+// The value must not be 0.
+u32 UDT_INLINE GetHighestSetBitIndex(u64 value)
+{
+#if defined(UDT_MSVC) && defined(UDT_X64)
+	unsigned long index;
+	_BitScanReverse64(&index, value);
+	return (u32)index;
+#elif defined(UDT_MSVC)
+	unsigned long index;
+	if(_BitScanReverse(&index, (unsigned long)(value >> 32)) != 0)
+	{
+		return (u32)index + 32;
+	}
+	_BitScanReverse(&index, (unsigned long)value);
+	return (u32)index;
+#else
+	return 63 - (u32)__builtin_clzll(value);
+#endif
+}
+
 
 struct udtObituaryEvent
 {
@@ -84,12 +128,12 @@ extern udtString   FormatBytes(udtVMLinearAllocator& allocator, u64 byteCount);
 extern bool        StringParseSeconds(s32& duration, const char* buffer); // Format is minutes:seconds or seconds.
 extern bool        CopyFileRange(udtStream& input, udtStream& output, udtVMLinearAllocator& allocator, u32 startOffset, u32 endOffset);
 extern s32         GetErrorCode(bool success, const s32* cancel);
-extern bool        RunParser(udtBaseParser& parser, udtStream& file, const s32* cancelOperation);
+extern bool        RunParser(udtBaseParser& parser, udtStream& file, const s32* cancelOperation, u32 fileEndOffset = 0); // 0 to read until the end of the demo.
 extern void        LogLinearAllocatorDebugStats(udtContext& context, udtVMLinearAllocator& allocator);
 extern bool        StringMatchesCutByChatRule(const udtString& string, const udtChatPatternRule& rule, udtVMLinearAllocator& allocator, udtProtocol::Id procotol);
 extern bool        IsObituaryEvent(udtObituaryEvent& info, const idEntityStateBase& entity, udtProtocol::Id protocol, udtMod::Id mod);
 extern const char* GetUDTModName(s32 mod); // Where mod is of type udtMeanOfDeath::Id. Never returns a NULL pointer.
-extern bool        GetClanAndPlayerName(udtString& clan, udtString& player, bool& hasClan, udtVMLinearAllocator& allocator, udtProtocol::Id protocol, const char* configString);
+extern bool        GetClanAndPlayerName(udtString& clan, udtString& player, bool& hasClan, udtVMLinearAllocator& allocator, udtBaseParser& parser, s32 csIndex); // The returned strings are read-only.
 extern bool        IsTeamMode(udtGameType::Id gameType);
 extern bool        IsRoundBasedMode(udtGameType::Id gameType);
 extern void        PerfStatsInit(u64* perfStats);
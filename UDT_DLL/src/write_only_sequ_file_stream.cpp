@@ -0,0 +1,478 @@
+#include "write_only_sequ_file_stream.hpp"
+#include "memory.hpp"
+
+
+#define BLOCK_SIZE  (256*1024)
+#define BLOCK_COUNT (4)
+
+
+#if defined(UDT_WINDOWS)
+
+
+#include "string.hpp"
+#include "scoped_stack_allocator.hpp"
+#include "thread_local_allocators.hpp"
+#include "assert_or_fatal.hpp"
+#include "utils.hpp"
+
+#include <Windows.h>
+
+
+struct WriteBlockInfo
+{
+	OVERLAPPED Overlapped;
+	HANDLE Event; // If invalid: NULL.
+	u32 ByteCount; // Number of bytes the pending request writes.
+	bool RequestPending;
+};
+
+struct udtWriteOnlySequentialFileStreamImpl
+{
+	WriteBlockInfo _blocks[BLOCK_COUNT];
+	u8* _buffer;     // If invalid: NULL.
+	HANDLE _file;    // If invalid: INVALID_HANDLE_VALUE.
+	u32 _blockIndex; // Of the block being filled.
+	u32 _blockOffset;
+	bool _failed;
+};
+
+static bool IsFileOpen(const udtWriteOnlySequentialFileStreamImpl* data)
+{
+	return data->_file != INVALID_HANDLE_VALUE;
+}
+
+static void FinishRequest(udtWriteOnlySequentialFileStreamImpl* data, WriteBlockInfo& block)
+{
+	DWORD bytesWritten = 0;
+	if(GetOverlappedResult(data->_file, &block.Overlapped, &bytesWritten, TRUE) == FALSE ||
+	   bytesWritten != (DWORD)block.ByteCount)
+	{
+		data->_failed = true;
+	}
+	block.RequestPending = false;
+}
+
+udtWriteOnlySequentialFileStream::udtWriteOnlySequentialFileStream()
+{
+	_data = (udtWriteOnlySequentialFileStreamImpl*)udt_malloc(sizeof(udtWriteOnlySequentialFileStreamImpl));
+	_data->_buffer = NULL;
+	_data->_file = INVALID_HANDLE_VALUE;
+	_data->_blockIndex = 0;
+	_data->_blockOffset = 0;
+	_data->_failed = false;
+	for(u32 i = 0; i < BLOCK_COUNT; ++i)
+	{
+		_data->_blocks[i].Event = NULL;
+		_data->_blocks[i].ByteCount = 0;
+		_data->_blocks[i].RequestPending = false;
+	}
+}
+
+bool udtWriteOnlySequentialFileStream::Init()
+{
+	if(_data->_buffer != NULL)
+	{
+		return true;
+	}
+
+	for(u32 i = 0; i < BLOCK_COUNT; ++i)
+	{
+		if(_data->_blocks[i].Event != NULL)
+		{
+			continue;
+		}
+
+		const HANDLE event = CreateEvent(NULL, TRUE, FALSE, NULL);
+		if(event == NULL)
+		{
+			return false;
+		}
+		_data->_blocks[i].Event = event;
+	}
+
+	void* const buffer = VirtualAlloc(NULL, (SIZE_T)(BLOCK_SIZE * BLOCK_COUNT), MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	if(buffer == NULL)
+	{
+		return false;
+	}
+
+	_data->_buffer = (u8*)buffer;
+
+	return true;
+}
+
+bool udtWriteOnlySequentialFileStream::Open(const char* filePath)
+{
+	Close();
+	if(!Init())
+	{
+		return false;
+	}
+
+	udtVMLinearAllocator& allocator = udtThreadLocalAllocators::GetTempAllocator();
+	udtVMScopedStackAllocator allocatorScope(allocator);
+	wchar_t* const wideFilePath = udtString::ConvertToUTF16(allocator, udtString::NewConstRef(filePath));
+	const DWORD fileAttribs = FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN | FILE_FLAG_OVERLAPPED;
+	const HANDLE file = CreateFileW(wideFilePath, GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, fileAttribs, NULL);
+	if(file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	_data->_file = file;
+	_data->_blockIndex = 0;
+	_data->_blockOffset = 0;
+	_data->_failed = false;
+
+	return true;
+}
+
+void udtWriteOnlySequentialFileStream::SubmitBlock()
+{
+	const u32 blockId = _data->_blockIndex % BLOCK_COUNT;
+	WriteBlockInfo& block = _data->_blocks[blockId];
+
+	LARGE_INTEGER offset;
+	offset.QuadPart = (LONGLONG)_data->_blockIndex * BLOCK_SIZE;
+
+	ZeroMemory(&block.Overlapped, sizeof(block.Overlapped));
+	block.Overlapped.Offset = offset.LowPart;
+	block.Overlapped.OffsetHigh = offset.HighPart;
+	block.Overlapped.hEvent = block.Event;
+	block.ByteCount = _data->_blockOffset;
+	const bool success = WriteFile(_data->_file, _data->_buffer + blockId * BLOCK_SIZE, (DWORD)block.ByteCount, NULL, &block.Overlapped) != FALSE;
+	block.RequestPending = success || GetLastError() == ERROR_IO_PENDING;
+	if(!block.RequestPending)
+	{
+		_data->_failed = true;
+	}
+
+	// The next block can only be filled once its previous write is done.
+	++_data->_blockIndex;
+	_data->_blockOffset = 0;
+	WriteBlockInfo& nextBlock = _data->_blocks[_data->_blockIndex % BLOCK_COUNT];
+	if(nextBlock.RequestPending)
+	{
+		FinishRequest(_data, nextBlock);
+	}
+}
+
+s32 udtWriteOnlySequentialFileStream::Close()
+{
+	if(_data->_file == INVALID_HANDLE_VALUE)
+	{
+		return 0;
+	}
+
+	if(_data->_blockOffset > 0)
+	{
+		SubmitBlock();
+	}
+
+	for(u32 i = 0; i < BLOCK_COUNT; ++i)
+	{
+		WriteBlockInfo& block = _data->_blocks[i];
+		if(block.RequestPending)
+		{
+			FinishRequest(_data, block);
+		}
+	}
+
+	CloseHandle(_data->_file);
+	_data->_file = INVALID_HANDLE_VALUE;
+
+	return _data->_failed ? -1 : 0;
+}
+
+void udtWriteOnlySequentialFileStream::Destroy()
+{
+	Close();
+
+	for(u32 i = 0; i < BLOCK_COUNT; ++i)
+	{
+		const HANDLE event = _data->_blocks[i].Event;
+		if(event != NULL)
+		{
+			CloseHandle(event);
+		}
+	}
+
+	if(_data->_buffer != NULL)
+	{
+		VirtualFree(_data->_buffer, 0, MEM_RELEASE);
+	}
+
+	free(_data);
+}
+
+
+#else
+
+
+#include "assert_or_fatal.hpp"
+#include "utils.hpp"
+
+#include <aio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <stdlib.h>
+
+
+struct WriteBlockInfo
+{
+	struct aiocb ControlBlock;
+	u32 ByteCount; // Number of bytes the pending request writes.
+	bool RequestPending;
+};
+
+struct udtWriteOnlySequentialFileStreamImpl
+{
+	WriteBlockInfo _blocks[BLOCK_COUNT];
+	u8* _buffer;     // If invalid: NULL.
+	int _file;       // If invalid: -1.
+	u32 _blockIndex; // Of the block being filled.
+	u32 _blockOffset;
+	bool _failed;
+};
+
+static bool IsFileOpen(const udtWriteOnlySequentialFileStreamImpl* data)
+{
+	return data->_file != -1;
+}
+
+// Writes what the asynchronous request didn't.
+static bool FinishWrite(int file, const u8* data, u32 byteCount, off_t offset)
+{
+	while(byteCount > 0)
+	{
+		const ssize_t result = pwrite(file, data, (size_t)byteCount, offset);
+		if(result < 0 && errno == EINTR)
+		{
+			continue;
+		}
+
+		if(result <= 0)
+		{
+			return false;
+		}
+
+		data += result;
+		byteCount -= (u32)result;
+		offset += (off_t)result;
+	}
+
+	return true;
+}
+
+static void FinishRequest(udtWriteOnlySequentialFileStreamImpl* data, WriteBlockInfo& block)
+{
+	const struct aiocb* const requests[1] = { &block.ControlBlock };
+	while(aio_error(&block.ControlBlock) == EINPROGRESS)
+	{
+		aio_suspend(requests, 1, NULL);
+	}
+
+	const ssize_t result = aio_return(&block.ControlBlock);
+	block.RequestPending = false;
+	if(result < 0)
+	{
+		data->_failed = true;
+	}
+	else if((u32)result < block.ByteCount)
+	{
+		const u8* const blockData = (const u8*)block.ControlBlock.aio_buf;
+		const off_t offset = block.ControlBlock.aio_offset + (off_t)result;
+		if(!FinishWrite(data->_file, blockData + result, block.ByteCount - (u32)result, offset))
+		{
+			data->_failed = true;
+		}
+	}
+}
+
+udtWriteOnlySequentialFileStream::udtWriteOnlySequentialFileStream()
+{
+	_data = (udtWriteOnlySequentialFileStreamImpl*)udt_malloc(sizeof(udtWriteOnlySequentialFileStreamImpl));
+	_data->_buffer = NULL;
+	_data->_file = -1;
+	_data->_blockIndex = 0;
+	_data->_blockOffset = 0;
+	_data->_failed = false;
+	for(u32 i = 0; i < BLOCK_COUNT; ++i)
+	{
+		_data->_blocks[i].ByteCount = 0;
+		_data->_blocks[i].RequestPending = false;
+	}
+}
+
+bool udtWriteOnlySequentialFileStream::Init()
+{
+	if(_data->_buffer != NULL)
+	{
+		return true;
+	}
+
+	void* buffer = NULL;
+	if(posix_memalign(&buffer, (size_t)UDT_MEMORY_PAGE_SIZE, (size_t)(BLOCK_SIZE * BLOCK_COUNT)) != 0)
+	{
+		return false;
+	}
+
+	_data->_buffer = (u8*)buffer;
+
+	return true;
+}
+
+bool udtWriteOnlySequentialFileStream::Open(const char* filePath)
+{
+	Close();
+	if(!Init())
+	{
+		return false;
+	}
+
+	const int file = open(filePath, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if(file == -1)
+	{
+		return false;
+	}
+
+	_data->_file = file;
+	_data->_blockIndex = 0;
+	_data->_blockOffset = 0;
+	_data->_failed = false;
+
+	return true;
+}
+
+void udtWriteOnlySequentialFileStream::SubmitBlock()
+{
+	const u32 blockId = _data->_blockIndex % BLOCK_COUNT;
+	WriteBlockInfo& block = _data->_blocks[blockId];
+	u8* const blockData = _data->_buffer + blockId * BLOCK_SIZE;
+	const off_t offset = (off_t)_data->_blockIndex * (off_t)BLOCK_SIZE;
+
+	struct aiocb& request = block.ControlBlock;
+	memset(&request, 0, sizeof(request));
+	request.aio_fildes = _data->_file;
+	request.aio_offset = offset;
+	request.aio_buf = blockData;
+	request.aio_nbytes = (size_t)_data->_blockOffset;
+	request.aio_sigevent.sigev_notify = SIGEV_NONE;
+	block.ByteCount = _data->_blockOffset;
+	block.RequestPending = aio_write(&request) == 0;
+	if(!block.RequestPending && !FinishWrite(_data->_file, blockData, block.ByteCount, offset))
+	{
+		// The request couldn't be queued and the blocking write failed too.
+		_data->_failed = true;
+	}
+
+	// The next block can only be filled once its previous write is done.
+	++_data->_blockIndex;
+	_data->_blockOffset = 0;
+	WriteBlockInfo& nextBlock = _data->_blocks[_data->_blockIndex % BLOCK_COUNT];
+	if(nextBlock.RequestPending)
+	{
+		FinishRequest(_data, nextBlock);
+	}
+}
+
+s32 udtWriteOnlySequentialFileStream::Close()
+{
+	if(_data->_file == -1)
+	{
+		return 0;
+	}
+
+	if(_data->_blockOffset > 0)
+	{
+		SubmitBlock();
+	}
+
+	for(u32 i = 0; i < BLOCK_COUNT; ++i)
+	{
+		WriteBlockInfo& block = _data->_blocks[i];
+		if(block.RequestPending)
+		{
+			FinishRequest(_data, block);
+		}
+	}
+
+	if(close(_data->_file) != 0)
+	{
+		_data->_failed = true;
+	}
+	_data->_file = -1;
+
+	return _data->_failed ? -1 : 0;
+}
+
+void udtWriteOnlySequentialFileStream::Destroy()
+{
+	Close();
+
+	if(_data->_buffer != NULL)
+	{
+		free(_data->_buffer);
+	}
+
+	free(_data);
+}
+
+
+#endif
+
+
+udtWriteOnlySequentialFileStream::~udtWriteOnlySequentialFileStream()
+{
+	Destroy();
+}
+
+u32 udtWriteOnlySequentialFileStream::Read(void* /*dstBuff*/, u32 /*elementSize*/, u32 /*count*/)
+{
+	UDT_ASSERT_OR_FATAL_ALWAYS("Calling Read on a udtWriteOnlySequentialFileStream is invalid!");
+	return 0;
+}
+
+u32 udtWriteOnlySequentialFileStream::Write(const void* srcBuff, u32 elementSize, u32 count)
+{
+	if(_data->_buffer == NULL || !IsFileOpen(_data))
+	{
+		return 0;
+	}
+
+	const u8* source = (const u8*)srcBuff;
+	u32 byteCount = elementSize * count;
+	while(byteCount > 0)
+	{
+		const u32 blockId = _data->_blockIndex % BLOCK_COUNT;
+		const u32 copyByteCount = udt_min(byteCount, (u32)BLOCK_SIZE - _data->_blockOffset);
+		memcpy(_data->_buffer + blockId * BLOCK_SIZE + _data->_blockOffset, source, (size_t)copyByteCount);
+		_data->_blockOffset += copyByteCount;
+		source += copyByteCount;
+		byteCount -= copyByteCount;
+		if(_data->_blockOffset == BLOCK_SIZE)
+		{
+			SubmitBlock();
+		}
+	}
+
+	return count;
+}
+
+s32 udtWriteOnlySequentialFileStream::Seek(s32 /*offset*/, udtSeekOrigin::Id /*origin*/)
+{
+	UDT_ASSERT_OR_FATAL_ALWAYS("Calling Seek on a udtWriteOnlySequentialFileStream is invalid!");
+	return 0;
+}
+
+s32 udtWriteOnlySequentialFileStream::Offset()
+{
+	return (s32)Length();
+}
+
+u64 udtWriteOnlySequentialFileStream::Length()
+{
+	return (u64)_data->_blockIndex * (u64)BLOCK_SIZE + (u64)_data->_blockOffset;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+
+#include "stream.hpp"
+
+
+struct udtWriteOnlySequentialFileStreamImpl;
+
+// Write-behind output: the data is copied to large aligned blocks and every full block
+// is written asynchronously, so the caller only waits when all the blocks are still in flight.
+// This is intended to be used for multiple files: the blocks are allocated by the first Open call.
+struct udtWriteOnlySequentialFileStream : udtStream
+{
+public:
+	udtWriteOnlySequentialFileStream();
+	~udtWriteOnlySequentialFileStream();
+
+	bool Open(const char* filePath); // Creates the file or empties it if it exists.
+
+	u32  Read(void* dstBuff, u32 elementSize, u32 count) override;
+	u32  Write(const void* srcBuff, u32 elementSize, u32 count) override;
+	s32  Seek(s32 offset, udtSeekOrigin::Id origin) override;
+	s32  Offset() override;
+	u64  Length() override;
+	s32  Close() override; // Waits for all writes to complete. Non-zero if any of them failed.
+
+private:
+	UDT_NO_COPY_SEMANTICS(udtWriteOnlySequentialFileStream);
+
+	bool Init();
+	void SubmitBlock();
+	void Destroy();
+
+	udtWriteOnlySequentialFileStreamImpl* _data;
+};
@@ -779,7 +779,9 @@ namespace Uber.DemoTools
             InvalidArgument,
             OperationFailed,
             OperationCanceled,
-            Unprocessed
+            Unprocessed,
+            InsufficientBufferSize,
+            UnsupportedProtocol
         }
 
         public enum udtChatOperator : int
@@ -965,6 +967,10 @@ namespace Uber.DemoTools
         [Flags]
         public enum udtParseArgFlags : uint
         {
+            WriteSeekIndex = 1 << 0,
+            FirstGameStateOnly = 1 << 1,
+            FirstMatchOnly = 1 << 2,
+            TimeWindow = 1 << 3
         }
 
         [StructLayout(LayoutKind.Sequential, Pack = 1)]
@@ -983,16 +989,28 @@ namespace Uber.DemoTools
             public UInt32 FileOffset;
             public UInt32 Flags;
             public UInt32 MinProgressTimeMs;
+            public Int32 StartTimeMs;
+            public Int32 EndTimeMs;
             public Int32 Reserved2;
         }
 
+        [Flags]
+        public enum udtMultiParseArgFlags : uint
+        {
+            SplitAtGameStates = 1 << 0
+        }
+
         [StructLayout(LayoutKind.Sequential, Pack = 1)]
         public struct udtMultiParseArg
 	    {
 		    public IntPtr FilePaths; // const char**
             public IntPtr OutputErrorCodes; // s32*
+            public IntPtr ThreadPool; // udtThreadPool*
+            public IntPtr Reserved1;
 		    public UInt32 FileCount;
 		    public UInt32 MaxThreadCount;
+            public UInt32 MinByteCountPerThread;
+            public UInt32 Flags;
 	    }
 
         [StructLayout(LayoutKind.Sequential, Pack = 1)]
@@ -1024,7 +1042,8 @@ namespace Uber.DemoTools
         [Flags]
         public enum udtCutByPatternArgFlags : uint
         {
-            MergeCutSections = 1 << 0
+            MergeCutSections = 1 << 0,
+            SinglePass = 1 << 1
         }
 
         public enum udtStringComparisonMode : uint
@@ -1272,6 +1291,12 @@ namespace Uber.DemoTools
             public UInt32 FileOffset;
             public Int32 FirstSnapshotTimeMs;
             public Int32 LastSnapshotTimeMs;
+            public UInt32 MapName; // string offset
+            public UInt32 MapNameLength;
+            public UInt32 Mod; // udtMod
+            public UInt32 GameType; // udtGameType
+            public UInt32 Protocol; // udtProtocol
+            public UInt32 Reserved1;
 	    }
 
         [StructLayout(LayoutKind.Sequential, Pack = 1)]
@@ -0,0 +1,168 @@
+#pragma once
+
+
+#include "huffman_test.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+
+// Compares the bit-by-bit encoder (1 store per code bit)
+// with the accumulator encoder (all codes of a write gathered in 64 bits, then stored at once)
+// for the 8-bit, 16-bit and 32-bit writes done by udtMessage::RealWriteBits.
+struct udtAccumulatorHuffmanEncoderBenchmark
+{
+	void Init()
+	{
+		// Same layout as HuffmanEncoderTable in UDT_DLL/src/message.cpp.
+		memset(_encoderTable, 0, sizeof(_encoderTable));
+		for(u32 i = 0; i < (u32)UDT_COUNT_OF(GlobalHuffmanLUT); ++i)
+		{
+			const u32 symbol = (u32)GlobalHuffmanLUT[i].Symbol;
+			_encoderTable[symbol] = u16(GlobalHuffmanLUT[i].Code << 4) | u16(GlobalHuffmanLUT[i].CodeLength);
+		}
+	}
+
+	// Same as HuffmanPutBit in UDT_DLL/src/message.cpp.
+	static UDT_FORCE_INLINE void PutBit(u8* data, s32 bitIndex, s32 bit)
+	{
+		if((bitIndex & 7) == 0)
+		{
+			data[bitIndex >> 3] = (u8)bit;
+			return;
+		}
+
+		data[bitIndex >> 3] |= bit << (bitIndex & 7);
+	}
+
+	UDT_FORCE_INLINE void EncodeBitByBit(u8* data, s32& bitIndex, u32 value, s32 bits)
+	{
+		for(s32 i = 0; i < bits; i += 8)
+		{
+			const u16 entry = _encoderTable[value & 0xFF];
+			const s32 codeLength = (s32)(entry & 15);
+			s32 code = (s32)(entry >> 4);
+			for(s32 j = 0; j < codeLength; ++j)
+			{
+				PutBit(data, bitIndex + j, code & 1);
+				code >>= 1;
+			}
+			bitIndex += codeLength;
+			value >>= 8;
+		}
+	}
+
+	// Same as RealWriteBits and HuffmanPutBits in UDT_DLL/src/message.cpp.
+	UDT_FORCE_INLINE void EncodeAccumulator(u8* data, s32& bitIndex, u32 value, s32 bits)
+	{
+		u64 accumulator = 0;
+		s32 accumulatorBitCount = 0;
+		for(s32 i = 0; i < bits; i += 8)
+		{
+			const u32 entry = (u32)_encoderTable[value & 0xFF];
+			accumulator |= (u64)(entry >> 4) << accumulatorBitCount;
+			accumulatorBitCount += (s32)(entry & 15);
+			value >>= 8;
+		}
+
+		u8* const dest = data + (bitIndex >> 3);
+		const s32 bitOffset = bitIndex & 7;
+		*(u64*)dest = (accumulator << bitOffset) | (u64)(*dest & ((1 << bitOffset) - 1));
+		bitIndex += accumulatorBitCount;
+	}
+
+	// Encodes the whole file as a sequence of writes of the given size.
+	template<bool Accumulator>
+	s32 EncodeFile(u8* output, const u8* input, s32 inputByteCount, s32 bits)
+	{
+		const s32 bytesPerWrite = bits / 8;
+		s32 bitIndex = 0;
+		for(s32 i = 0; i + bytesPerWrite <= inputByteCount; i += bytesPerWrite)
+		{
+			const u32 value = bits == 32 ? *(const u32*)(input + i) : (bits == 16 ? (u32)*(const u16*)(input + i) : (u32)input[i]);
+			if(Accumulator)
+			{
+				EncodeAccumulator(output, bitIndex, value, bits);
+			}
+			else
+			{
+				EncodeBitByBit(output, bitIndex, value, bits);
+			}
+		}
+
+		return bitIndex;
+	}
+
+	template<bool Accumulator>
+	f64 Time(u8* output, const u8* input, s32 inputByteCount, s32 bits, u32 iterations, s32& bitCount)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		for(u32 i = 0; i < iterations; ++i)
+		{
+			bitCount = EncodeFile<Accumulator>(output, input, inputByteCount, bits);
+		}
+		const auto end = std::chrono::high_resolution_clock::now();
+
+		return std::chrono::duration<f64>(end - start).count();
+	}
+
+	bool Run(const char* filePath, u32 iterations)
+	{
+		FILE* const file = fopen(filePath, "rb");
+		if(file == NULL)
+		{
+			printf("Failed to open file: %s\n", filePath);
+			return false;
+		}
+
+		fseek(file, 0, SEEK_END);
+		const s32 byteCount = (s32)ftell(file);
+		fseek(file, 0, SEEK_SET);
+
+		u8* const input = (u8*)malloc((size_t)byteCount);
+		const bool success = fread(input, (size_t)byteCount, 1, file) == 1;
+		fclose(file);
+		if(!success)
+		{
+			printf("Failed to read file: %s\n", filePath);
+			free(input);
+			return false;
+		}
+
+		// Codes are at most 11 bits long and the accumulator encoder stores 8 bytes at a time.
+		const size_t outputByteCount = ((size_t)byteCount * 11) / 8 + 16;
+		u8* const bitByBitOutput = (u8*)calloc(outputByteCount, 1);
+		u8* const accumulatorOutput = (u8*)calloc(outputByteCount, 1);
+
+		Init();
+
+		bool identical = true;
+		const s32 writeSizes[3] = { 8, 16, 32 };
+		for(u32 i = 0; i < 3; ++i)
+		{
+			const s32 bits = writeSizes[i];
+			s32 bitByBitBitCount = 0;
+			s32 accumulatorBitCount = 0;
+			const f64 bitByBitTime = Time<false>(bitByBitOutput, input, byteCount, bits, iterations, bitByBitBitCount);
+			const f64 accumulatorTime = Time<true>(accumulatorOutput, input, byteCount, bits, iterations, accumulatorBitCount);
+			const bool sameOutput =
+				bitByBitBitCount == accumulatorBitCount &&
+				memcmp(bitByBitOutput, accumulatorOutput, (size_t)((bitByBitBitCount + 7) >> 3)) == 0;
+			const f64 megaBytes = ((f64)byteCount * (f64)iterations) / (1024.0 * 1024.0);
+			printf("%d-bit writes: bit-by-bit %.1f MB/s | accumulator %.1f MB/s | speed-up x%.2f | %s\n",
+				(int)bits, megaBytes / bitByBitTime, megaBytes / accumulatorTime, bitByBitTime / accumulatorTime,
+				sameOutput ? "identical output" : "OUTPUT MISMATCH");
+			identical = identical && sameOutput;
+		}
+
+		free(accumulatorOutput);
+		free(bitByBitOutput);
+		free(input);
+
+		return identical;
+	}
+
+	u16 _encoderTable[256];
+};
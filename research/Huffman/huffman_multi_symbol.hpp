@@ -0,0 +1,187 @@
+#pragma once
+
+
+#include "huffman_test.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+
+// Compares the single-symbol decoder (1 look-up per 8-bit symbol, 2048 entries)
+// with the multi-symbol decoder (up to 2 symbols per look-up, 65536 entries)
+// for the 16-bit and 32-bit reads done by udtMessage::RealReadBits.
+struct udtMultiSymbolHuffmanBenchmark
+{
+	void Init()
+	{
+		memset(_singleTable, 0, sizeof(_singleTable));
+		for(u32 i = 0; i < (u32)UDT_COUNT_OF(GlobalHuffmanLUT); ++i)
+		{
+			const u32 codeLength = (u32)GlobalHuffmanLUT[i].CodeLength;
+			const u32 combinations = 1 << (11 - codeLength);
+			const u16 codeBase = GlobalHuffmanLUT[i].Code;
+			for(u32 j = 0; j < combinations; ++j)
+			{
+				const u32 code = (u32)codeBase | (j << codeLength);
+				_singleTable[code] = u16(GlobalHuffmanLUT[i].Symbol) | u16(codeLength << 8);
+			}
+		}
+		_singleTable[256] = 11 << 8;
+
+		// Same layout as HuffmanMultiDecoderTable in UDT_DLL/src/message.cpp.
+		for(u32 i = 0; i < (u32)UDT_COUNT_OF(_multiTable); ++i)
+		{
+			const u32 entry0 = (u32)_singleTable[i & 0x7FF];
+			const u32 length0 = entry0 >> 8;
+			const u32 entry1 = (u32)_singleTable[(i >> length0) & 0x7FF];
+			const u32 length1 = entry1 >> 8;
+			if(length0 + length1 <= 16)
+			{
+				_multiTable[i] = (entry0 & 0xFF) | ((entry1 & 0xFF) << 8) | ((length0 + length1) << 16) | (2 << 24);
+			}
+			else
+			{
+				_multiTable[i] = (entry0 & 0xFF) | (length0 << 16) | (1 << 24);
+			}
+		}
+	}
+
+	UDT_FORCE_INLINE u32 DecodeSingle(const u8* data, s32& bitIndex, s32 bits)
+	{
+		u32 value = 0;
+		for(s32 i = 0; i < bits; i += 8)
+		{
+			const u16 code = ((*(const u32*)(data + (bitIndex >> 3))) >> ((u32)bitIndex & 7)) & 0x7FF;
+			const u16 entry = _singleTable[code];
+			value |= u32(entry & 0xFF) << i;
+			bitIndex += s32(entry >> 8);
+		}
+
+		return value;
+	}
+
+	// Same as HuffmanDecodeBits in UDT_DLL/src/message.cpp.
+	UDT_FORCE_INLINE u32 DecodeMulti(const u8* data, s32& bitIndex, s32 bits)
+	{
+		u64 window = (*(const u64*)(data + (bitIndex >> 3))) >> ((u32)bitIndex & 7);
+		u32 value = 0;
+		s32 shift = 0;
+		while(bits >= 16)
+		{
+			const u32 entry = _multiTable[window & 0xFFFF];
+			const u32 codeBits = (entry >> 16) & 0xFF;
+			const s32 decodedBits = (s32)(entry >> 24) << 3;
+			value |= (entry & 0xFFFF) << shift;
+			window >>= codeBits;
+			bitIndex += (s32)codeBits;
+			shift += decodedBits;
+			bits -= decodedBits;
+		}
+
+		if(bits)
+		{
+			const u16 entry = _singleTable[window & 0x7FF];
+			value |= u32(entry & 0xFF) << shift;
+			bitIndex += s32(entry >> 8);
+		}
+
+		return value;
+	}
+
+	// Decodes every message of the demo as a sequence of reads of the given size.
+	template<bool Multi>
+	u32 DecodeDemo(const u8* fileData, s32 fileByteCount, s32 bits, u64& symbolCount)
+	{
+		u32 checksum = 0;
+		s32 offset = 0;
+		while(offset + 8 <= fileByteCount)
+		{
+			const s32 messageByteCount = *(const s32*)(fileData + offset + 4);
+			if(messageByteCount < 0 || offset + 8 + messageByteCount > fileByteCount)
+			{
+				break;
+			}
+
+			const u8* const data = fileData + offset + 8;
+			const s32 maxBitIndex = messageByteCount * 8 - 44; // Worst case for 32 bits: 4 codes of 11 bits.
+			s32 bitIndex = 0;
+			while(bitIndex < maxBitIndex)
+			{
+				const u32 value = Multi ? DecodeMulti(data, bitIndex, bits) : DecodeSingle(data, bitIndex, bits);
+				checksum = (checksum * 31) ^ value;
+				symbolCount += (u64)(bits / 8);
+			}
+
+			offset += 8 + messageByteCount;
+		}
+
+		return checksum;
+	}
+
+	template<bool Multi>
+	f64 Time(const u8* fileData, s32 fileByteCount, s32 bits, u32 iterations, u32& checksum, u64& symbolCount)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		for(u32 i = 0; i < iterations; ++i)
+		{
+			checksum = DecodeDemo<Multi>(fileData, fileByteCount, bits, symbolCount);
+		}
+		const auto end = std::chrono::high_resolution_clock::now();
+
+		return std::chrono::duration<f64>(end - start).count();
+	}
+
+	bool Run(const char* filePath, u32 iterations)
+	{
+		FILE* const file = fopen(filePath, "rb");
+		if(file == NULL)
+		{
+			printf("Failed to open file: %s\n", filePath);
+			return false;
+		}
+
+		fseek(file, 0, SEEK_END);
+		const s32 byteCount = (s32)ftell(file);
+		fseek(file, 0, SEEK_SET);
+
+		// Padding for the 8-byte loads past the last message.
+		u8* const data = (u8*)calloc((size_t)byteCount + 16, 1);
+		const bool success = fread(data, (size_t)byteCount, 1, file) == 1;
+		fclose(file);
+		if(!success)
+		{
+			printf("Failed to read file: %s\n", filePath);
+			free(data);
+			return false;
+		}
+
+		Init();
+
+		bool identical = true;
+		const s32 readSizes[2] = { 16, 32 };
+		for(u32 i = 0; i < 2; ++i)
+		{
+			const s32 bits = readSizes[i];
+			u32 singleChecksum = 0;
+			u32 multiChecksum = 0;
+			u64 singleSymbols = 0;
+			u64 multiSymbols = 0;
+			const f64 singleTime = Time<false>(data, byteCount, bits, iterations, singleChecksum, singleSymbols);
+			const f64 multiTime = Time<true>(data, byteCount, bits, iterations, multiChecksum, multiSymbols);
+			const f64 megaBytes = ((f64)byteCount * (f64)iterations) / (1024.0 * 1024.0);
+			printf("%d-bit reads: single %.1f MB/s | multi %.1f MB/s | speed-up x%.2f | %s\n",
+				(int)bits, megaBytes / singleTime, megaBytes / multiTime, singleTime / multiTime,
+				singleChecksum == multiChecksum ? "identical output" : "OUTPUT MISMATCH");
+			identical = identical && singleChecksum == multiChecksum && singleSymbols == multiSymbols;
+		}
+
+		free(data);
+
+		return identical;
+	}
+
+	u16 _singleTable[2048];
+	u32 _multiTable[1 << 16];
+};
@@ -1,4 +1,6 @@
 #include "message.hpp"
+#include "huffman_multi_symbol.hpp"
+#include "huffman_accumulator_encoder.hpp"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -44,8 +46,22 @@ void idHuffman(u8* data, s32 byteCount)
 }
 
 
-int main()
+static udtMultiSymbolHuffmanBenchmark MultiSymbolBenchmark;
+static udtAccumulatorHuffmanEncoderBenchmark AccumulatorEncoderBenchmark;
+
+int main(int argc, char** argv)
 {
+	// Usage: Huffman demofilepath [iterationcount]
+	if(argc >= 2)
+	{
+		const u32 iterations = argc >= 3 ? (u32)atoi(argv[2]) : 20;
+		const bool decoderSuccess = MultiSymbolBenchmark.Run(argv[1], iterations);
+		const bool encoderSuccess = AccumulatorEncoderBenchmark.Run(argv[1], iterations);
+		const bool success = decoderSuccess && encoderSuccess;
+		system("pause");
+		return success ? 0 : 1;
+	}
+
 	s32 byteCount = 0;
 	u8* data = NULL;
 	ReadFile(data, byteCount, "11785_151.dm_68");